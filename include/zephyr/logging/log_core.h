@@ -252,7 +252,7 @@ static inline char z_log_minimal_level_to_char(int level)
 	\
 	bool is_user_context = k_is_user_context(); \
 	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) { \
+	    !is_user_context && Z_LOG_RUNTIME_FILTERED(_dsource, _level)) { \
 		break; \
 	} \
 	int _mode; \
@@ -326,8 +326,6 @@ static inline char z_log_minimal_level_to_char(int level)
 		} \
 	} \
 	bool is_user_context = k_is_user_context(); \
-	uint32_t filters = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
-						(_dsource)->filters : 0;\
 	\
 	if (IS_ENABLED(CONFIG_LOG_MODE_MINIMAL)) { \
 		Z_LOG_TO_PRINTK(_level, "%s", _str); \
@@ -336,7 +334,7 @@ static inline char z_log_minimal_level_to_char(int level)
 		break; \
 	} \
 	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER(filters)) { \
+	    !is_user_context && Z_LOG_RUNTIME_FILTERED(_dsource, _level)) { \
 		break; \
 	} \
 	int mode; \
@@ -419,6 +417,24 @@ static inline char z_log_minimal_level_to_char(int level)
 #define Z_LOG_RUNTIME_FILTER(_filter) \
 	LOG_FILTER_SLOT_GET(&_filter, LOG_FILTER_AGGR_SLOT_IDX)
 
+/** @brief Get the mask of filter slots accepting a level.
+ *
+ * @param _dsource Pointer to dynamic source descriptor.
+ * @param _level   Log level, other than LOG_LEVEL_NONE.
+ */
+#define Z_LOG_LEVEL_MASK(_dsource, _level) ((_dsource)->level_masks[(_level) - 1])
+
+/* Check if a message is filtered out for all backends. With the bitmap, it
+ * is a single load as the level is a constant.
+ */
+#ifdef CONFIG_LOG_RUNTIME_FILTER_BITMAP
+#define Z_LOG_RUNTIME_FILTERED(_dsource, _level) \
+	(Z_LOG_LEVEL_MASK(_dsource, _level) == 0U)
+#else
+#define Z_LOG_RUNTIME_FILTERED(_dsource, _level) \
+	((_level) > Z_LOG_RUNTIME_FILTER((_dsource)->filters))
+#endif
+
 /** @brief Log level value used to indicate log entry that should not be
  *	   formatted (raw string).
  */
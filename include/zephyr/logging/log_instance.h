@@ -29,6 +29,12 @@ struct log_source_const_data {
 /** @brief Dynamic data associated with the source of log messages. */
 struct log_source_dynamic_data {
 	uint32_t filters;
+#ifdef CONFIG_LOG_RUNTIME_FILTER_BITMAP
+	/* For each level (LOG_LEVEL_ERR at index 0), bit N set if the level is
+	 * accepted by filter slot N. Kept in sync with filters.
+	 */
+	uint16_t level_masks[4];
+#endif
 #ifdef CONFIG_NIOS2
 	/* Workaround alert! Dummy data to ensure that structure is >8 bytes.
 	 * Nios2 uses global pointer register for structures <=8 bytes and
@@ -25,6 +25,26 @@ enum log_dict_output_msg_type {
 	MSG_DROPPED_MSG = 1,
 };
 
+/**
+ * First two bytes of a frame, when CONFIG_LOG_DICTIONARY_FRAMING is enabled.
+ */
+#define LOG_DICT_FRAME_SYNC0 0xA5U
+#define LOG_DICT_FRAME_SYNC1 0x5AU
+
+/**
+ * Frame header preceding each dictionary based log message when
+ * CONFIG_LOG_DICTIONARY_FRAMING is enabled.
+ *
+ * The message of @p len bytes is followed by a CRC-16/CCITT of @p seq,
+ * @p len and the message. @p seq is incremented for each frame of a log
+ * output so that the host can detect lost frames.
+ */
+struct log_dict_output_frame_hdr_t {
+	uint8_t sync[2];
+	uint16_t seq;
+	uint16_t len;
+} __packed;
+
 /**
  * Output header for one dictionary based log message.
  */
@@ -1100,6 +1100,14 @@ struct net_buf_pool {
 	const char *name;
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_LOCKLESS_FREE_LIST)
+	/** Lock-free stack of free buffers */
+	atomic_t free_head;
+
+	/** Number of allocations waiting on the LIFO */
+	atomic_t free_waiters;
+#endif /* CONFIG_NET_BUF_LOCKLESS_FREE_LIST */
+
 	/** Optional destroy callback when buffer is freed. */
 	void (*const destroy)(struct net_buf *buf);
 
@@ -1273,6 +1281,157 @@ extern const struct net_buf_data_cb net_buf_var_cb;
 					 _net_buf_##_name, _count, _ud_size,   \
 					 _destroy)
 
+/** @cond INTERNAL_HIDDEN */
+
+struct net_buf_multi_class_usage {
+	atomic_t allocs;
+	atomic_t fallbacks;
+	atomic_t failures;
+};
+
+struct net_buf_pool_multi_class {
+	struct k_mem_slab *slab;
+	size_t size;
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	struct net_buf_multi_class_usage *usage;
+#endif
+};
+
+struct net_buf_pool_multi {
+	const struct net_buf_pool_multi_class *classes;
+	size_t class_count;
+};
+
+extern const struct net_buf_data_cb net_buf_multi_cb;
+
+#define _NET_BUF_MULTI_CLASS_SIZE(_class) GET_ARG_N(1, __DEBRACKET _class)
+#define _NET_BUF_MULTI_CLASS_COUNT(_class) GET_ARG_N(2, __DEBRACKET _class)
+
+/* Each block starts with a header holding the reference count and the
+ * index of the size class.
+ */
+#define _NET_BUF_MULTI_SLAB_DEFINE(_idx, _class, _name)                        \
+	K_MEM_SLAB_DEFINE_STATIC(net_buf_multi_slab_##_name##_##_idx,          \
+				 sizeof(void *) + _NET_BUF_MULTI_CLASS_SIZE(_class), \
+				 _NET_BUF_MULTI_CLASS_COUNT(_class), sizeof(void *)); \
+	IF_ENABLED(CONFIG_NET_BUF_POOL_USAGE,                                  \
+		   (static struct net_buf_multi_class_usage                    \
+			   net_buf_multi_usage_##_name##_##_idx))
+
+#define _NET_BUF_MULTI_CLASS_INIT(_idx, _class, _name)                         \
+	{                                                                      \
+		.slab = &net_buf_multi_slab_##_name##_##_idx,                  \
+		.size = _NET_BUF_MULTI_CLASS_SIZE(_class),                     \
+		IF_ENABLED(CONFIG_NET_BUF_POOL_USAGE,                          \
+			   (.usage = &net_buf_multi_usage_##_name##_##_idx,))  \
+	}
+
+/** @endcond */
+
+/**
+ *
+ * @brief Define a new pool for buffers with multiple data size classes
+ *
+ * Defines a net_buf_pool struct and the necessary memory storage (array of
+ * structs) for the needed amount of buffers. After this, the buffers can be
+ * accessed from the pool through net_buf_alloc. The pool is defined as a
+ * static variable, so if it needs to be exported outside the current module
+ * this needs to happen with the help of a separate pointer rather than an
+ * extern declaration.
+ *
+ * The data payload of the buffers will be allocated from a set of memory
+ * slabs, one per size class. Each allocation is served from the smallest
+ * class that fits the requested size and has a free block, falling back to
+ * larger classes. If all fitting classes are exhausted, the allocation waits
+ * on the smallest fitting class for the timeout passed to net_buf_alloc.
+ * Requests larger than the largest class fail, so users that need more data
+ * must chain several buffers. The size of an allocated buffer is the size
+ * of its class, not the requested size.
+ *
+ * If provided with a custom destroy callback, this callback is
+ * responsible for eventually calling net_buf_destroy() to complete the
+ * process of returning the buffer to the pool.
+ *
+ * Example, with small buffers for control packets and large ones for full
+ * frames:
+ *
+ * @code{.c}
+ * NET_BUF_POOL_MULTI_DEFINE(my_pool, 24, 0, NULL, (128, 16), (1536, 8));
+ * @endcode
+ *
+ * @param _name      Name of the pool variable.
+ * @param _count     Number of buffers in the pool.
+ * @param _ud_size   User data space to reserve per buffer.
+ * @param _destroy   Optional destroy callback when buffer is freed.
+ * @param ...        Size classes, each given as (data size, number of
+ *                   blocks), in ascending order of data size.
+ */
+#define NET_BUF_POOL_MULTI_DEFINE(_name, _count, _ud_size, _destroy, ...)     \
+	_NET_BUF_ARRAY_DEFINE(_name, _count, _ud_size);                        \
+	FOR_EACH_IDX_FIXED_ARG(_NET_BUF_MULTI_SLAB_DEFINE, (;), _name, __VA_ARGS__); \
+	static const struct net_buf_pool_multi_class net_buf_multi_classes_##_name[] = { \
+		FOR_EACH_IDX_FIXED_ARG(_NET_BUF_MULTI_CLASS_INIT, (,), _name,  \
+				       __VA_ARGS__)                            \
+	};                                                                     \
+	BUILD_ASSERT(ARRAY_SIZE(net_buf_multi_classes_##_name) <= UINT8_MAX);  \
+	static const struct net_buf_pool_multi net_buf_multi_##_name = {       \
+		.classes = net_buf_multi_classes_##_name,                      \
+		.class_count = ARRAY_SIZE(net_buf_multi_classes_##_name),      \
+	};                                                                     \
+	static const struct net_buf_data_alloc net_buf_multi_alloc_##_name = { \
+		.cb = &net_buf_multi_cb,                                       \
+		.alloc_data = (void *)&net_buf_multi_##_name,                  \
+		.max_alloc_size = _NET_BUF_MULTI_CLASS_SIZE(                   \
+			GET_ARG_N(1, REVERSE_ARGS(__VA_ARGS__))),              \
+	};                                                                     \
+	static STRUCT_SECTION_ITERABLE(net_buf_pool, _name) =                  \
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_multi_alloc_##_name,  \
+					 _net_buf_##_name, _count, _ud_size,   \
+					 _destroy)
+
+/**
+ * @brief Statistics of one data size class of a multi-size pool.
+ */
+struct net_buf_multi_class_stats {
+	/** Data size of the buffers of this class. */
+	size_t size;
+
+	/** Number of data blocks of this class. */
+	uint32_t blocks;
+
+	/** Number of data blocks currently in use. */
+	uint32_t used;
+
+	/** Number of allocations served from this class. Only counted if
+	 *  CONFIG_NET_BUF_POOL_USAGE is enabled.
+	 */
+	uint32_t allocs;
+
+	/** Number of allocations served from this class because the smaller
+	 *  fitting classes were exhausted. Only counted if
+	 *  CONFIG_NET_BUF_POOL_USAGE is enabled.
+	 */
+	uint32_t fallbacks;
+
+	/** Number of allocations that failed while this was the best fitting
+	 *  class. Only counted if CONFIG_NET_BUF_POOL_USAGE is enabled.
+	 */
+	uint32_t failures;
+};
+
+/**
+ * @brief Get the statistics of a data size class of a multi-size pool.
+ *
+ * @param pool  Pool defined with NET_BUF_POOL_MULTI_DEFINE().
+ * @param idx   Index of the size class, in ascending order of size.
+ * @param stats Statistics are stored here.
+ *
+ * @return 0 on success, -EINVAL if the pool is not a multi-size pool,
+ *         -ENOENT if there is no such class.
+ */
+int net_buf_multi_class_stats_get(struct net_buf_pool *pool, size_t idx,
+				  struct net_buf_multi_class_stats *stats);
+
 /**
  *
  * @brief Define a new pool for buffers
@@ -1320,6 +1479,19 @@ struct net_buf_pool *net_buf_pool_get(int id);
  */
 int net_buf_id(struct net_buf *buf);
 
+/**
+ * @brief Check if a pool has a buffer available.
+ *
+ * Covers uninitialized buffers as well as freed ones, whichever free list
+ * the pool keeps them in. The result may be stale as soon as it is
+ * returned, if other threads allocate from or free to the pool.
+ *
+ * @param pool Pool to check.
+ *
+ * @return true if an allocation from the pool would not need to wait.
+ */
+bool net_buf_pool_has_free(struct net_buf_pool *pool);
+
 /**
  * @brief Allocate a new fixed buffer from a pool.
  *
@@ -1456,6 +1628,10 @@ struct net_buf * __must_check net_buf_get(struct k_fifo *fifo,
 					  k_timeout_t timeout);
 #endif
 
+/** @cond INTERNAL_HIDDEN */
+void z_net_buf_pool_free(struct net_buf_pool *pool, struct net_buf *buf);
+/** @endcond */
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1476,7 +1652,11 @@ static inline void net_buf_destroy(struct net_buf *buf)
 		buf->__buf = NULL;
 	}
 
+#if defined(CONFIG_NET_BUF_LOCKLESS_FREE_LIST)
+	z_net_buf_pool_free(pool, buf);
+#else
 	k_lifo_put(&pool->free, buf);
+#endif
 }
 
 /**
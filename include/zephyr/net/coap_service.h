@@ -258,6 +258,25 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 		       const struct sockaddr *addr, socklen_t addr_len,
 		       const struct coap_transmission_parameters *params);
 
+/**
+ * @brief Send a notification to all the observers of the provided @p resource .
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The notification is built once, without token, and is sent to each observer with its token
+ * and a new message ID. The options and the payload are not encoded again for each observer,
+ * so this is cheaper than building each notification from the @ref coap_resource.notify
+ * callback when a resource has many observers. The caller is responsible for the Observe
+ * option value, typically the resource age incremented for each notification.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param cpkt CoAP notification to send, with an empty token
+ * @param params Pointer to transmission parameters structure or NULL to use default values.
+ * @return the number of observers notified in case of success or negative in case of error.
+ */
+int coap_resource_notify_observers(struct coap_resource *resource, const struct coap_packet *cpkt,
+				   const struct coap_transmission_parameters *params);
+
 /**
  * @brief Parse a CoAP observe request for the provided @p resource .
  *
@@ -261,6 +261,12 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+		/** Index + 1 of the query slot this query shares the answer
+		 * of, as the same name and type was already being resolved
+		 * when this query was started. 0 if the query was sent.
+		 */
+		uint16_t leader;
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -199,6 +199,23 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported. The driver accepts TCP
+	 * packets larger than the MTU and splits them into segments of
+	 * net_pkt_gso_size() bytes of payload.
+	 */
+	ETHERNET_HW_TSO			= BIT(21),
+
+	/** Large receive offload supported. The driver may hand coalesced
+	 * in-order TCP segments of one flow to the stack as a single packet,
+	 * and TCP GRO is then not done for the interface.
+	 */
+	ETHERNET_HW_LRO			= BIT(22),
+
+	/** Receive side scaling supported. The driver provides the flow hash
+	 * of received packets with net_pkt_set_rx_hash().
+	 */
+	ETHERNET_HW_RX_HASH		= BIT(23),
 };
 
 /** @cond INTERNAL_HIDDEN */
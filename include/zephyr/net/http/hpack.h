@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -102,8 +103,86 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+#if defined(CONFIG_HTTP_SERVER)
+#define HTTP_SERVER_HPACK_DECODER_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DECODER_TABLE_SIZE
+#define HTTP_SERVER_HPACK_ENCODER_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_ENCODER_TABLE_SIZE
+#else
+#define HTTP_SERVER_HPACK_DECODER_TABLE_SIZE 0
+#define HTTP_SERVER_HPACK_ENCODER_TABLE_SIZE 0
+#endif
+
+/* Size of an entry in the dynamic table, besides its name and value */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+
 /** @endcond */
 
+/** HPACK dynamic table entry. */
+struct http_hpack_dynamic_entry {
+	/** Offset of the name in the table data, followed by the value. */
+	uint16_t offset;
+
+	/** Length of the header field name. */
+	uint16_t name_len;
+
+	/** Length of the header field value. */
+	uint16_t value_len;
+};
+
+/**
+ * HPACK dynamic table (RFC 7541, ch. 2.3.2). Names and values are stored
+ * in a ring buffer of @a capacity bytes, the entries in a ring of
+ * descriptors, the oldest entry being evicted first.
+ */
+struct http_hpack_dynamic_table {
+	/** Ring buffer holding the entry names and values. */
+	uint8_t *data;
+
+	/** Ring of entry descriptors. */
+	struct http_hpack_dynamic_entry *entries;
+
+	/** Size of the data buffer, the largest table size supported. */
+	uint16_t capacity;
+
+	/** Number of entry descriptors. */
+	uint16_t max_entries;
+
+	/** Index of the oldest entry descriptor. */
+	uint16_t first;
+
+	/** Number of entries in the table. */
+	uint16_t count;
+
+	/** Table size as defined in RFC 7541, ch. 4.1. */
+	uint32_t size;
+
+	/** Current maximum table size. */
+	uint32_t max_size;
+
+	/** Maximum table size change to signal to the peer (encoder only). */
+	bool size_update;
+
+	/** Signal a zero size first to empty the peer table (encoder only). */
+	bool flush;
+
+	/** Entries were evicted since the mark (encoder only). */
+	bool mark_evicted;
+
+	/** Index of the oldest entry descriptor at the mark (encoder only). */
+	uint16_t mark_first;
+
+	/** Number of entries in the table at the mark (encoder only). */
+	uint16_t mark_count;
+
+	/** Table size at the mark (encoder only). */
+	uint32_t mark_size;
+
+	/** Pending table size change at the mark (encoder only). */
+	bool mark_size_update;
+
+	/** Pending peer table flush at the mark (encoder only). */
+	bool mark_flush;
+};
+
 /** HTTP2 header field with decoding buffer. */
 struct http_hpack_header_buf {
 	/** A pointer to the decoded header field name. */
@@ -123,10 +202,34 @@ struct http_hpack_header_buf {
 
 	/** Length of the data in the decoding buffer. */
 	size_t datalen;
+
+/** @cond INTERNAL_HIDDEN */
+#if HTTP_SERVER_HPACK_DECODER_TABLE_SIZE > 0
+	uint8_t decoder_data[HTTP_SERVER_HPACK_DECODER_TABLE_SIZE];
+	struct http_hpack_dynamic_entry decoder_entries[
+		HTTP_SERVER_HPACK_DECODER_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD];
+#endif
+#if HTTP_SERVER_HPACK_ENCODER_TABLE_SIZE > 0
+	uint8_t encoder_data[HTTP_SERVER_HPACK_ENCODER_TABLE_SIZE];
+	struct http_hpack_dynamic_entry encoder_entries[
+		HTTP_SERVER_HPACK_ENCODER_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD];
+#endif
+/** @endcond */
+
+	/** Dynamic table used to decode the peer header blocks. */
+	struct http_hpack_dynamic_table decoder;
+
+	/** Dynamic table mirroring the peer decoder state when encoding. */
+	struct http_hpack_dynamic_table encoder;
 };
 
 /** @cond INTERNAL_HIDDEN */
 
+void http_hpack_init(struct http_hpack_header_buf *header);
+void http_hpack_set_encoder_max_size(struct http_hpack_header_buf *header,
+				     uint32_t max_size);
+void http_hpack_encoder_mark(struct http_hpack_header_buf *header);
+void http_hpack_encoder_rollback(struct http_hpack_header_buf *header);
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen);
 int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
@@ -25,6 +25,10 @@
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/socket.h>
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+#include <zephyr/fs/fs.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -68,6 +72,11 @@ enum http_resource_type {
 	 *  after and upgrade.
 	 */
 	HTTP_RESOURCE_TYPE_WEBSOCKET,
+
+	/** Static resource backed by a file, the file is sent to the client
+	 *  with zsock_sendfile().
+	 */
+	HTTP_RESOURCE_TYPE_STATIC_FS,
 };
 
 /**
@@ -115,6 +124,21 @@ struct http_resource_detail_static {
 BUILD_ASSERT(offsetof(struct http_resource_detail_static, common) == 0);
 /** @endcond */
 
+/**
+ * @brief Representation of a static server resource backed by a file.
+ */
+struct http_resource_detail_static_fs {
+	/** Common resource details. */
+	struct http_resource_detail common;
+
+	/** Path of the file in the file system. */
+	const char *fs_path;
+};
+
+/** @cond INTERNAL_HIDDEN */
+BUILD_ASSERT(offsetof(struct http_resource_detail_static_fs, common) == 0);
+/** @endcond */
+
 struct http_client_ctx;
 
 /** Indicates the status of the currently processed piece of data.  */
@@ -266,6 +290,7 @@ enum http1_parser_state {
 };
 
 #define HTTP_SERVER_INITIAL_WINDOW_SIZE 65536
+#define HTTP_SERVER_DEFAULT_PEER_WINDOW_SIZE 65535
 #define HTTP_SERVER_WS_MAX_SEC_KEY_LEN 32
 
 /** @endcond */
@@ -305,6 +330,12 @@ struct http_client_ctx {
 	/** Connection-level window size. */
 	int window_size;
 
+	/** Connection-level window size granted by the peer. */
+	int peer_window_size;
+
+	/** Stream-level window size the peer granted in its settings. */
+	int peer_initial_window_size;
+
 	/** Server state for the associated client. */
 	enum http_server_state server_state;
 
@@ -357,6 +388,17 @@ struct http_client_ctx {
 /** @cond INTERNAL_HIDDEN */
 	/** Websocket security key. */
 	IF_ENABLED(CONFIG_WEBSOCKET, (uint8_t ws_sec_key[HTTP_SERVER_WS_MAX_SEC_KEY_LEN]));
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	/** HTTP/2 file transfer waiting for the peer to open its window. */
+	struct {
+		struct fs_file_t file;
+		size_t remaining;
+		uint32_t stream_id;
+		int window_size;
+		bool active;
+	} http2_fs;
+#endif
 /** @endcond */
 
 	/** Flag indicating that headers were sent in the reply. */
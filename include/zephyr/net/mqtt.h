@@ -473,6 +473,26 @@ struct mqtt_transport {
 #endif
 };
 
+#if defined(CONFIG_MQTT_PUBLISH_ASYNC)
+/** @brief Publish message awaiting acknowledgment, see mqtt_publish_async. */
+struct mqtt_inflight {
+	/** Internal. Copy of the publish parameters. Topic and payload are
+	 *  referenced, not copied. A message id of 0 marks a free entry.
+	 */
+	struct mqtt_publish_param param;
+
+	/** Internal. Wall clock value (in milliseconds) of the last
+	 *  transmission. Needed for retransmission.
+	 */
+	uint32_t sent;
+
+	/** Internal. PUBREC received for a QoS 2 message, PUBREL is pending
+	 *  completion.
+	 */
+	uint8_t released : 1;
+};
+#endif /* CONFIG_MQTT_PUBLISH_ASYNC */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -491,6 +511,14 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_PUBLISH_ASYNC)
+	/** Internal. Publish messages awaiting acknowledgment. */
+	struct mqtt_inflight inflight[CONFIG_MQTT_PUBLISH_WINDOW];
+
+	/** Internal. Last message id assigned by mqtt_publish_async. */
+	uint16_t last_message_id;
+#endif /* CONFIG_MQTT_PUBLISH_ASYNC */
 };
 
 /**
@@ -633,6 +661,35 @@ int mqtt_connect(struct mqtt_client *client);
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to publish messages without waiting for their acknowledgment.
+ *
+ * QoS 1 and QoS 2 messages are kept in the client's in-flight window until
+ * @ref MQTT_EVT_PUBACK or @ref MQTT_EVT_PUBCOMP is received for them. The
+ * client replies to @ref MQTT_EVT_PUBREC with PUBREL on its own, and
+ * @ref mqtt_live retransmits messages that are not acknowledged within
+ * @kconfig{CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT}. Pending messages are also
+ * retransmitted once a new connection is accepted, unless the client uses a
+ * clean session, in which case they are dropped on disconnect.
+ *
+ * QoS 0 messages are sent as with @ref mqtt_publish.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message.
+ *                  Shall not be NULL. If the message id is 0, the client
+ *                  assigns one.
+ *
+ * @note The topic and payload are not copied, they shall remain valid until
+ *       the message is acknowledged or dropped.
+ *
+ * @return Message id of a QoS 1 or QoS 2 message, 0 for QoS 0, or a negative
+ *         error code (errno.h) indicating reason of failure. -EAGAIN means
+ *         the in-flight window is full.
+ */
+int mqtt_publish_async(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -751,6 +808,8 @@ int mqtt_abort(struct mqtt_client *client);
 /**
  * @brief This API should be called periodically for the client to be able
  *        to keep the connection alive by sending Ping Requests if need be.
+ *        It also retransmits timed out messages of the in-flight window, see
+ *        @ref mqtt_publish_async.
  *
  * @param[in] client Client instance for which the procedure is requested.
  *                   Shall not be NULL.
@@ -2666,6 +2666,27 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if the IP stack needs to split large TCP packets into
+ * segments before sending them. This is not needed if the device supports
+ * TCP segmentation offload.
+ *
+ * @param iface Network interface
+ *
+ * @return True if TCP segmentation needs to be done, false otherwise.
+ */
+bool net_if_need_tcp_segmentation(struct net_if *iface);
+
+/**
+ * @brief Check if the IP stack needs to merge received TCP segments itself.
+ * This is not needed if the device supports large receive offload.
+ *
+ * @param iface Network interface
+ *
+ * @return True if TCP segments need to be merged, false otherwise.
+ */
+bool net_if_need_tcp_coalescing(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
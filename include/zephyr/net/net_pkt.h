@@ -270,6 +270,31 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* If non-zero, the TCP payload of this packet is larger than one
+	 * segment and it must be split into segments carrying at most
+	 * gso_size bytes before it is passed to a driver that does not
+	 * support TCP segmentation offload.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	/* Flow hash of a received packet, used to select its RX queue.
+	 * Zero if not computed yet.
+	 */
+	uint32_t rx_hash;
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
+#if defined(CONFIG_NET_TCP) || defined(CONFIG_NET_UDP)
+	/* Unfolded one's complement sum of the last data_chksum_len bytes
+	 * of the packet, computed while the payload was copied in, so that
+	 * the TCP or UDP checksum does not need to read it again.
+	 */
+	uint16_t data_chksum;
+	uint16_t data_chksum_len;
+#endif
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 	/* TODO: Evolve this into a union of orthogonal
 	 *       control block declarations if further L2
@@ -983,6 +1008,98 @@ static inline void net_pkt_set_vlan_tci(struct net_pkt *pkt, uint16_t tci)
 }
 #endif
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
+#if defined(CONFIG_NET_TCP) || defined(CONFIG_NET_UDP)
+static inline uint16_t net_pkt_data_chksum(struct net_pkt *pkt)
+{
+	return pkt->data_chksum;
+}
+
+static inline uint16_t net_pkt_data_chksum_len(struct net_pkt *pkt)
+{
+	return pkt->data_chksum_len;
+}
+
+/* The sum covers the last len bytes of the packet, zero len clears it. */
+static inline void net_pkt_set_data_chksum(struct net_pkt *pkt, uint16_t sum,
+					   uint16_t len)
+{
+	pkt->data_chksum = sum;
+	pkt->data_chksum_len = len;
+}
+#else
+static inline uint16_t net_pkt_data_chksum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline uint16_t net_pkt_data_chksum_len(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_data_chksum(struct net_pkt *pkt, uint16_t sum,
+					   uint16_t len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+	ARG_UNUSED(len);
+}
+#endif
+
 #if defined(CONFIG_NET_PKT_TIMESTAMP) || defined(CONFIG_NET_PKT_TXTIME)
 static inline struct net_ptp_time *net_pkt_timestamp(struct net_pkt *pkt)
 {
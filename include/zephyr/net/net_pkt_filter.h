@@ -17,6 +17,7 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/ethernet.h>
 
@@ -34,6 +35,7 @@ extern "C" {
 /** @cond INTERNAL_HIDDEN */
 
 struct npf_test;
+struct npf_program;
 
 typedef bool (npf_test_fn_t)(struct npf_test *test, struct net_pkt *pkt);
 
@@ -61,6 +63,11 @@ extern struct npf_rule npf_default_drop;
 struct npf_rule_list {
 	sys_slist_t rule_head;   /**< List head */
 	struct k_spinlock lock;  /**< Lock protecting the list access */
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED) || defined(__DOXYGEN__)
+	struct npf_program *programs[2]; /**< Compiled rule list slots */
+	atomic_t active;                 /**< Slot of the program in use */
+	atomic_t readers[2];             /**< Evaluations running per slot */
+#endif
 };
 
 /** @brief  rule list applied to outgoing packets */
@@ -107,6 +114,18 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule);
  */
 bool npf_remove_all_rules(struct npf_rule_list *rules);
 
+/**
+ * @brief Take into account changes to the conditions of the rule list
+ *
+ * With CONFIG_NET_PKT_FILTER_COMPILED, the values the conditions compare
+ * packet fields against are copied when the rule list is compiled. This
+ * must be called after modifying a condition of a rule in the list, for
+ * example an entry of its address array.
+ *
+ * @param rules the affected rule list
+ */
+void npf_update_rules(struct npf_rule_list *rules);
+
 /** @cond INTERNAL_HIDDEN */
 
 /* convenience shortcuts */
@@ -118,12 +137,15 @@ bool npf_remove_all_rules(struct npf_rule_list *rules);
 #define npf_remove_recv_rule(rule) npf_remove_rule(&npf_recv_rules, rule)
 #define npf_remove_all_send_rules() npf_remove_all_rules(&npf_send_rules)
 #define npf_remove_all_recv_rules() npf_remove_all_rules(&npf_recv_rules)
+#define npf_update_send_rules() npf_update_rules(&npf_send_rules)
+#define npf_update_recv_rules() npf_update_rules(&npf_recv_rules)
 
 #ifdef CONFIG_NET_PKT_FILTER_LOCAL_IN_HOOK
 #define npf_insert_local_in_recv_rule(rule) npf_insert_rule(&npf_local_in_recv_rules, rule)
 #define npf_append_local_in_recv_rule(rule) npf_append_rule(&npf_local_in_recv_rules, rule)
 #define npf_remove_local_in_recv_rule(rule) npf_remove_rule(&npf_local_in_recv_rules, rule)
 #define npf_remove_all_local_in_recv_rules() npf_remove_all_rules(&npf_local_in_recv_rules)
+#define npf_update_local_in_recv_rules() npf_update_rules(&npf_local_in_recv_rules)
 #endif /* CONFIG_NET_PKT_FILTER_LOCAL_IN_HOOK */
 
 #ifdef CONFIG_NET_PKT_FILTER_IPV4_HOOK
@@ -131,6 +153,7 @@ bool npf_remove_all_rules(struct npf_rule_list *rules);
 #define npf_append_ipv4_recv_rule(rule) npf_append_rule(&npf_ipv4_recv_rules, rule)
 #define npf_remove_ipv4_recv_rule(rule) npf_remove_rule(&npf_ipv4_recv_rules, rule)
 #define npf_remove_all_ipv4_recv_rules() npf_remove_all_rules(&npf_ipv4_recv_rules)
+#define npf_update_ipv4_recv_rules() npf_update_rules(&npf_ipv4_recv_rules)
 #endif /* CONFIG_NET_PKT_FILTER_IPV4_HOOK */
 
 #ifdef CONFIG_NET_PKT_FILTER_IPV6_HOOK
@@ -138,6 +161,7 @@ bool npf_remove_all_rules(struct npf_rule_list *rules);
 #define npf_append_ipv6_recv_rule(rule) npf_append_rule(&npf_ipv6_recv_rules, rule)
 #define npf_remove_ipv6_recv_rule(rule) npf_remove_rule(&npf_ipv6_recv_rules, rule)
 #define npf_remove_all_ipv6_recv_rules() npf_remove_all_rules(&npf_ipv6_recv_rules)
+#define npf_update_ipv6_recv_rules() npf_update_rules(&npf_ipv6_recv_rules)
 #endif /* CONFIG_NET_PKT_FILTER_IPV6_HOOK */
 
 /** @endcond */
@@ -75,6 +75,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_send: More data follows, TCP may hold back a partial segment */
+#define ZSOCK_MSG_MORE 0x8000
 /** @} */
 
 /**
@@ -185,6 +187,11 @@ extern "C" {
 /** Socket option to control TLS session caching on a socket. Accepted values:
  *  - 0 - Disabled.
  *  - 1 - Enabled.
+ *
+ *  Client sessions are cached per hostname and port if @ref TLS_HOSTNAME is
+ *  set, so they can be resumed with any address of the server, and per peer
+ *  address otherwise. Servers cache sessions by ID and, if
+ *  CONFIG_MBEDTLS_SSL_TICKET_C is enabled, also issue session tickets.
  */
 #define TLS_SESSION_CACHE 12
 /** Write-only socket option to purge session cache immediately.
@@ -493,6 +500,35 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+struct fs_file_t;
+
+/**
+ * @brief Send the contents of a file to a socket
+ *
+ * @details
+ * Send up to @p count bytes read from @p file to a connected socket. On a
+ * native TCP socket the file is read directly into the network buffers,
+ * avoiding the intermediate copy of a read()/send() loop. Other sockets
+ * fall back to such a loop internally.
+ *
+ * If @p offset is not NULL, reading starts at @p *offset, which is updated
+ * to point past the last byte sent, and the file position is left
+ * unchanged. Otherwise reading starts at, and advances, the current file
+ * position.
+ *
+ * The call blocks according to the socket blocking mode and send timeout.
+ * The function cannot be called from user mode.
+ *
+ * @param sock Socket file descriptor
+ * @param file Opened file to send from
+ * @param offset Optional file offset to start reading from
+ * @param count Maximum number of bytes to send
+ *
+ * @return Number of bytes sent, 0 at end of file, or -1 with errno set.
+ */
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -541,6 +577,47 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Dequeue the next received chunk of data from a native TCP or UDP socket
+ * and hand over the network buffers that hold it. The data starts at
+ * the @c data pointer of the first fragment and continues through the
+ * fragment chain. For a datagram socket one call returns one datagram,
+ * for a stream socket it returns the data of one received segment.
+ *
+ * The caller owns the returned buffers and must give them back with
+ * zsock_recv_zc_release() once done with the data. The buffers are taken
+ * from the RX buffer pool, so they should not be held for long. For a
+ * stream socket the TCP receive window is opened again only when the
+ * buffers are released, and at most
+ * CONFIG_NET_SOCKETS_RECV_ZEROCOPY_MAX_LOANS chains can be held at a time.
+ *
+ * Only ZSOCK_MSG_DONTWAIT is supported in @p flags, the socket receive
+ * timeout and non-blocking mode are honored as with zsock_recv().
+ * The function cannot be called from user mode.
+ *
+ * @param sock Socket file descriptor
+ * @param frags Set to the received fragment chain, or NULL if no data
+ *        was returned
+ * @param flags Receive flags
+ *
+ * @return Number of bytes received, 0 on end of stream, or -1 with errno
+ *         set on error. errno is ENOBUFS if too many chains are held.
+ */
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags);
+
+/**
+ * @brief Release buffers returned by zsock_recv_zc()
+ *
+ * @param frags Fragment chain returned by zsock_recv_zc(), can be NULL.
+ *        The first fragment must be the one that was returned.
+ */
+void zsock_recv_zc_release(struct net_buf *frags);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -1059,6 +1136,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_MORE */
+#define MSG_MORE ZSOCK_MSG_MORE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1195,6 +1274,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Only send full segments until uncorked (at most 200 ms) */
+#define TCP_CORK 5
 
 /** @} */
 
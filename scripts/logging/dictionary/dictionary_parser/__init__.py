@@ -8,6 +8,7 @@
 Dictionary-based Logging Parser Module
 """
 
+from .log_frame import LogFrameDecoder
 from .log_parser_v1 import LogParserV1
 
 
@@ -20,3 +21,8 @@ def get_parser(database):
         return LogParserV1(database)
 
     return None
+
+
+def is_framed(database):
+    """Whether the log data is sent in frames"""
+    return "CONFIG_LOG_DICTIONARY_FRAMING" in database.get_kconfigs()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Frame decoder for Dictionary-based Logging
+
+With CONFIG_LOG_DICTIONARY_FRAMING, each log message is sent as:
+
+    sync (0xA5 0x5A) | seq (u16) | len (u16) | message (len bytes) | crc (u16)
+
+where crc is the CRC-16/CCITT (seed 0xFFFF, as crc16_ccitt() in Zephyr)
+of seq, len and the message. This decodes a byte stream into messages,
+skipping data which is not part of a valid frame and counting the frames
+lost according to the sequence numbers.
+"""
+
+import struct
+
+
+# Keep in sync with include/zephyr/logging/log_output_dict.h
+FRAME_SYNC = b'\xa5\x5a'
+FRAME_CRC_SEED = 0xFFFF
+
+# seq, len
+FMT_FRAME_HDR = "HH"
+FMT_FRAME_CRC = "H"
+
+SEQ_MASK = 0xFFFF
+
+# Largest message: header of a normal message with 64-bit source and
+# timestamp, then the 10-bit package length and 12-bit data length.
+MAX_MSG_LEN = 21 + 0x3FF + 0xFFF
+
+
+def crc16_ccitt(seed, data):
+    """CRC-16/CCITT, same as crc16_ccitt() in lib/crc/crc16_sw.c"""
+    crc = seed
+
+    for byte in data:
+        e = (crc ^ byte) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        crc = (crc >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)
+        crc &= 0xFFFF
+
+    return crc
+
+
+class LogFrameDecoder():
+    """Extract log messages from a stream of frames"""
+    def __init__(self, database):
+        if database.is_tgt_little_endian():
+            endian = "<"
+        else:
+            endian = ">"
+
+        self.fmt_hdr = endian + FMT_FRAME_HDR
+        self.fmt_crc = endian + FMT_FRAME_CRC
+        self.hdr_len = len(FRAME_SYNC) + struct.calcsize(self.fmt_hdr)
+        self.crc_len = struct.calcsize(self.fmt_crc)
+
+        self.buf = bytearray()
+        self.next_seq = None
+
+        # Frames missing from the sequence
+        self.lost = 0
+
+        # Bytes skipped while looking for a valid frame
+        self.skipped = 0
+
+
+    def __skip(self, cnt):
+        del self.buf[:cnt]
+        self.skipped += cnt
+
+
+    def __check_seq(self, seq):
+        if self.next_seq is not None:
+            self.lost += (seq - self.next_seq) & SEQ_MASK
+
+        self.next_seq = (seq + 1) & SEQ_MASK
+
+
+    def feed(self, data):
+        """
+        Add received data and return the list of (seq, message) tuples
+        of the complete frames.
+        """
+        frames = []
+
+        self.buf += data
+
+        while True:
+            idx = self.buf.find(FRAME_SYNC)
+            if idx < 0:
+                # Keep a last byte which may be the start of sync
+                if len(self.buf) > 1:
+                    self.__skip(len(self.buf) - 1)
+                break
+
+            if idx > 0:
+                self.__skip(idx)
+
+            if len(self.buf) < self.hdr_len:
+                break
+
+            seq, msg_len = struct.unpack_from(self.fmt_hdr, self.buf, len(FRAME_SYNC))
+            if msg_len > MAX_MSG_LEN:
+                self.__skip(1)
+                continue
+
+            frame_len = self.hdr_len + msg_len + self.crc_len
+
+            if len(self.buf) < frame_len:
+                break
+
+            crc = struct.unpack_from(self.fmt_crc, self.buf, frame_len - self.crc_len)[0]
+            if crc != crc16_ccitt(FRAME_CRC_SEED,
+                                  self.buf[len(FRAME_SYNC):frame_len - self.crc_len]):
+                # Not a frame, or a corrupted one: resynchronize on the next sync
+                self.__skip(1)
+                continue
+
+            self.__check_seq(seq)
+            frames.append((seq, bytes(self.buf[self.hdr_len:frame_len - self.crc_len])))
+            del self.buf[:frame_len]
+
+        return frames
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Live Log Parser for Dictionary-based Logging
+
+This decodes dictionary based log messages as they are received from
+a serial port, a network socket (net backend), a file being written
+(e.g. RTT logger output) or the standard input, and prints them.
+
+The target must be built with CONFIG_LOG_DICTIONARY_FRAMING so that the
+parser can find messages in the stream, skip other data and report lost
+messages.
+"""
+
+import argparse
+import logging
+import os
+import socket
+import sys
+import time
+
+import dictionary_parser
+from dictionary_parser.log_database import LogDatabase
+
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+READ_SIZE = 4096
+FILE_POLL_INTERVAL = 0.1
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+
+    source = argparser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--serial", metavar="PORT", help="Serial port")
+    source.add_argument("--udp", metavar="PORT", type=int,
+                        help="Receive log datagrams on this UDP port")
+    source.add_argument("--tcp", metavar="PORT", type=int,
+                        help="Accept a log connection on this TCP port")
+    source.add_argument("--file", metavar="PATH",
+                        help="File to follow as it grows, - for standard input")
+
+    argparser.add_argument("--baudrate", type=int, default=115200,
+                           help="Serial port baud rate (default 115200)")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def serial_reader(args):
+    """Read from a serial port"""
+    import serial # pylint: disable=import-outside-toplevel
+
+    with serial.Serial(args.serial, args.baudrate, timeout=FILE_POLL_INTERVAL) as ser:
+        while True:
+            yield ser.read(READ_SIZE)
+
+
+def udp_reader(args):
+    """Read datagrams from the net backend"""
+    with socket.socket(socket.AF_INET6, socket.SOCK_DGRAM) as sock:
+        sock.setsockopt(socket.IPPROTO_IPV6, socket.IPV6_V6ONLY, 0)
+        sock.bind(("::", args.udp))
+
+        while True:
+            yield sock.recv(65536)
+
+
+def tcp_reader(args):
+    """Read the stream of one connection from the net backend"""
+    with socket.socket(socket.AF_INET6, socket.SOCK_STREAM) as sock:
+        sock.setsockopt(socket.IPPROTO_IPV6, socket.IPV6_V6ONLY, 0)
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        sock.bind(("::", args.tcp))
+        sock.listen(1)
+
+        conn, addr = sock.accept()
+        logger.debug("# Connection from %s", addr[0])
+
+        with conn:
+            while True:
+                data = conn.recv(READ_SIZE)
+                if not data:
+                    return
+
+                yield data
+
+
+def file_reader(args):
+    """Read a file, waiting for more data at its end"""
+    if args.file == "-":
+        while True:
+            data = os.read(sys.stdin.fileno(), READ_SIZE)
+            if not data:
+                return
+
+            yield data
+
+    with open(args.file, "rb") as logfile:
+        while True:
+            data = logfile.read(READ_SIZE)
+            if not data:
+                time.sleep(FILE_POLL_INTERVAL)
+
+            yield data
+
+
+def get_reader(args):
+    """Get the generator of received data"""
+    if args.serial:
+        return serial_reader(args)
+
+    if args.udp:
+        return udp_reader(args)
+
+    if args.tcp:
+        return tcp_reader(args)
+
+    return file_reader(args)
+
+
+def main():
+    """Main function of live log parser"""
+    args = parse_args()
+
+    # Setup logging for parser
+    logging.basicConfig(format=LOGGER_FORMAT)
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    # Read from database file
+    database = LogDatabase.read_json_database(args.dbfile)
+    if database is None:
+        logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
+        sys.exit(1)
+
+    if not dictionary_parser.is_framed(database):
+        logger.error("ERROR: Target must be built with CONFIG_LOG_DICTIONARY_FRAMING")
+        sys.exit(1)
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    decoder = dictionary_parser.LogFrameDecoder(database)
+    lost = 0
+
+    try:
+        for data in get_reader(args):
+            for seq, msg in decoder.feed(data):
+                if decoder.lost != lost:
+                    print(f"--- {decoder.lost - lost} frames lost ---")
+                    lost = decoder.lost
+
+                if not log_parser.parse_log_data(msg, debug=args.debug):
+                    logger.error("------ Error parsing frame %d", seq)
+
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    logger.debug("# %d frames lost, %d bytes skipped", decoder.lost, decoder.skipped)
+
+
+if __name__ == "__main__":
+    main()
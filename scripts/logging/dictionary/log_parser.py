@@ -132,7 +132,18 @@ def main():
         else:
             logger.debug("# Endianness: Big")
 
-        ret = log_parser.parse_log_data(logdata, debug=args.debug)
+        if dictionary_parser.is_framed(database):
+            decoder = dictionary_parser.LogFrameDecoder(database)
+            ret = True
+
+            for _, msg in decoder.feed(logdata):
+                ret = log_parser.parse_log_data(msg, debug=args.debug) and ret
+
+            if decoder.lost > 0:
+                logger.info("--- %d frames lost ---", decoder.lost)
+        else:
+            ret = log_parser.parse_log_data(logdata, debug=args.debug)
+
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
@@ -834,16 +834,7 @@ static bool cannot_send_to_controller(struct bt_conn *conn)
 static bool dont_have_viewbufs(void)
 {
 #if defined(CONFIG_BT_CONN_TX)
-	/* The LIFO only tracks buffers that have been destroyed at least once,
-	 * hence the uninit check beforehand.
-	 */
-	if (fragments.uninit_count > 0) {
-		/* If there are uninitialized bufs, we are guaranteed allocation. */
-		return false;
-	}
-
-	/* In practice k_fifo == k_lifo ABI. */
-	return k_fifo_is_empty(&fragments.free);
+	return !net_buf_pool_has_free(&fragments);
 
 #else  /* !CONFIG_BT_CONN_TX */
 	return false;
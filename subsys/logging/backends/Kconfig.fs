@@ -58,4 +58,45 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_BUFFERED
+	bool "Buffer logs in RAM and write them from a thread"
+	help
+	  Collect the formatted log data in two RAM buffers instead of writing
+	  each chunk to the file from the logging thread. A full buffer is
+	  written to the file, and synced, by a dedicated low priority thread
+	  while the other buffer is being filled. Buffered data is also written
+	  when no more data was logged for
+	  CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS milliseconds. Data still
+	  buffered at a panic is lost.
+
+if LOG_BACKEND_FS_BUFFERED
+
+config LOG_BACKEND_FS_BUFFER_SIZE
+	int "Size of each log buffer"
+	default 2048
+	help
+	  Size in bytes of each of the two buffers. Use a multiple of the
+	  flash page or file system block size so that full buffers are
+	  written as whole pages.
+
+config LOG_BACKEND_FS_FLUSH_TIMEOUT_MS
+	int "Idle time before buffered logs are written"
+	default 1000
+	help
+	  Partially filled buffer is written to the file after that many
+	  milliseconds without it getting full.
+
+config LOG_BACKEND_FS_THREAD_STACK_SIZE
+	int "Stack size of the file writer thread"
+	default 2048
+
+config LOG_BACKEND_FS_THREAD_PRIORITY
+	int "Priority of the file writer thread"
+	default 14
+	help
+	  Keep this at or below the priority of the logging thread, so that
+	  file system operations do not delay log processing.
+
+endif # LOG_BACKEND_FS_BUFFERED
+
 endif # LOG_BACKEND_FS
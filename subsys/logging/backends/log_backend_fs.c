@@ -451,8 +451,108 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+/* The logging thread fills one buffer while the writer thread writes the
+ * other one to the file.
+ */
+struct fs_log_buffer {
+	uint8_t data[CONFIG_LOG_BACKEND_FS_BUFFER_SIZE];
+	size_t len;
+};
+
+static struct fs_log_buffer __aligned(4) fs_bufs[2];
+static struct fs_log_buffer *fill_buf = &fs_bufs[0];
+static struct fs_log_buffer *write_buf;
+static K_MUTEX_DEFINE(fs_buf_lock);
+/* Given when write_buf is free, taken to hand over a buffer. */
+static K_SEM_DEFINE(fs_buf_free, 1, 1);
+static K_SEM_DEFINE(fs_buf_full, 0, 1);
+
+/* Must be called with fs_buf_lock held and fs_buf_free taken. */
+static void swap_buffers(void)
+{
+	write_buf = fill_buf;
+	fill_buf = (fill_buf == &fs_bufs[0]) ? &fs_bufs[1] : &fs_bufs[0];
+}
+
+static int buffer_log_data(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len;
+
+	ARG_UNUSED(ctx);
+
+	k_mutex_lock(&fs_buf_lock, K_FOREVER);
+
+	len = MIN(length, sizeof(fill_buf->data) - fill_buf->len);
+	memcpy(&fill_buf->data[fill_buf->len], data, len);
+	fill_buf->len += len;
+
+	if (fill_buf->len == sizeof(fill_buf->data)) {
+		/* Only blocks if the writer is still busy with the other buffer. */
+		k_mutex_unlock(&fs_buf_lock);
+		(void)k_sem_take(&fs_buf_free, K_FOREVER);
+		k_mutex_lock(&fs_buf_lock, K_FOREVER);
+		swap_buffers();
+		k_sem_give(&fs_buf_full);
+	}
+
+	k_mutex_unlock(&fs_buf_lock);
+
+	return len;
+}
+
+static void fs_writer_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (k_sem_take(&fs_buf_full, K_MSEC(CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS))) {
+			/* Idle, write out a partially filled buffer. */
+			if (k_sem_take(&fs_buf_free, K_NO_WAIT)) {
+				continue;
+			}
+
+			k_mutex_lock(&fs_buf_lock, K_FOREVER);
+			if (fill_buf->len == 0) {
+				k_mutex_unlock(&fs_buf_lock);
+				k_sem_give(&fs_buf_free);
+				continue;
+			}
+
+			swap_buffers();
+			k_mutex_unlock(&fs_buf_lock);
+		}
+
+		/* Like log_output, retry when the file was full and old logs were
+		 * removed to make room.
+		 */
+		for (size_t off = 0; off < write_buf->len;) {
+			int rc = write_log_to_file(&write_buf->data[off], write_buf->len - off,
+						   NULL);
+
+			if (rc < 0) {
+				break;
+			}
+
+			off += rc;
+		}
+
+		write_buf->len = 0;
+		k_sem_give(&fs_buf_free);
+	}
+}
+
+K_THREAD_DEFINE(log_backend_fs_thread, CONFIG_LOG_BACKEND_FS_THREAD_STACK_SIZE,
+		fs_writer_thread, NULL, NULL, NULL, CONFIG_LOG_BACKEND_FS_THREAD_PRIORITY, 0, 0);
+
+static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
+LOG_OUTPUT_DEFINE(log_output, buffer_log_data, buf, MAX_FLASH_WRITE_SIZE);
+#else
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
 LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+#endif
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
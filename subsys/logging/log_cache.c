@@ -23,8 +23,8 @@
 
 int log_cache_init(struct log_cache *cache, const struct log_cache_config *config)
 {
-	sys_slist_init(&cache->active);
-	sys_slist_init(&cache->idle);
+	sys_dlist_init(&cache->active);
+	sys_dlist_init(&cache->idle);
 
 	size_t entry_size = ROUND_UP(sizeof(struct log_cache_entry) + config->item_size,
 				     sizeof(uintptr_t));
@@ -36,13 +36,30 @@ int log_cache_init(struct log_cache *cache, const struct log_cache_config *confi
 		return -EINVAL;
 	}
 
+	if (config->hash && config->buckets) {
+		if (!IS_POWER_OF_TWO(config->bucket_cnt)) {
+			return -EINVAL;
+		}
+
+		cache->buckets = config->buckets;
+		cache->bucket_mask = config->bucket_cnt - 1;
+	} else {
+		cache->buckets = &cache->bucket;
+		cache->bucket_mask = 0;
+	}
+
+	for (uint32_t i = 0; i <= cache->bucket_mask; i++) {
+		sys_slist_init(&cache->buckets[i]);
+	}
+
 	/* Add all entries to idle list */
 	for (uint32_t i = 0; i < entry_cnt; i++) {
-		sys_slist_append(&cache->idle, &entry->node);
+		sys_dlist_append(&cache->idle, &entry->node);
 		entry = (struct log_cache_entry *)((uintptr_t)entry + entry_size);
 	}
 
 	cache->cmp = config->cmp;
+	cache->hash = cache->bucket_mask ? config->hash : NULL;
 	cache->item_size = config->item_size;
 	cache->hit = 0;
 	cache->miss = 0;
@@ -50,42 +67,48 @@ int log_cache_init(struct log_cache *cache, const struct log_cache_config *confi
 	return 0;
 }
 
+static sys_slist_t *id_bucket(struct log_cache *cache, uintptr_t id)
+{
+	uint32_t hash = cache->hash ? cache->hash(id) : 0;
+
+	return &cache->buckets[hash & cache->bucket_mask];
+}
+
 bool log_cache_get(struct log_cache *cache, uintptr_t id, uint8_t **data)
 {
-	sys_snode_t *prev_node = NULL;
 	struct log_cache_entry *entry;
 	bool hit = false;
 
 	LOG_CACHE_PRINT("cache_get for id %lx\n", id);
-	SYS_SLIST_FOR_EACH_CONTAINER(&cache->active, entry, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(id_bucket(cache, id), entry, hash_node) {
 		LOG_CACHE_DBG_ENTRY("checking", entry);
 		if (cache->cmp(entry->id, id)) {
 			cache->hit++;
 			hit = true;
 			break;
 		}
-
-		if (&entry->node == sys_slist_peek_tail(&cache->active)) {
-			break;
-		}
-		prev_node = &entry->node;
 	}
 
 	if (hit) {
 		LOG_CACHE_DBG_ENTRY("moving up", entry);
-		sys_slist_remove(&cache->active, prev_node, &entry->node);
-		sys_slist_prepend(&cache->active, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&cache->active, &entry->node);
 	} else {
 		cache->miss++;
 
-		sys_snode_t *from_idle = sys_slist_get(&cache->idle);
+		sys_dnode_t *node = sys_dlist_get(&cache->idle);
 
-		if (from_idle) {
-			entry = CONTAINER_OF(from_idle, struct log_cache_entry, node);
-		} else {
+		if (node == NULL) {
+			/* Evict the least recently used entry. */
+			node = sys_dlist_peek_tail(&cache->active);
+			entry = CONTAINER_OF(node, struct log_cache_entry, node);
 			LOG_CACHE_DBG_ENTRY("removing", entry);
-			sys_slist_remove(&cache->active, prev_node, &entry->node);
+			sys_dlist_remove(node);
+			(void)sys_slist_find_and_remove(id_bucket(cache, entry->id),
+							&entry->hash_node);
 		}
+
+		entry = CONTAINER_OF(node, struct log_cache_entry, node);
 	}
 
 	*data = entry->data;
@@ -99,7 +122,8 @@ void log_cache_put(struct log_cache *cache, uint8_t *data)
 	struct log_cache_entry *entry = CONTAINER_OF(data, struct log_cache_entry, data[0]);
 
 	LOG_CACHE_DBG_ENTRY("cache_put", entry);
-	sys_slist_prepend(&cache->active, &entry->node);
+	sys_dlist_prepend(&cache->active, &entry->node);
+	sys_slist_prepend(id_bucket(cache, entry->id), &entry->hash_node);
 }
 
 void log_cache_release(struct log_cache *cache, uint8_t *data)
@@ -107,5 +131,5 @@ void log_cache_release(struct log_cache *cache, uint8_t *data)
 	struct log_cache_entry *entry = CONTAINER_OF(data, struct log_cache_entry, data[0]);
 
 	LOG_CACHE_DBG_ENTRY("cache_release", entry);
-	sys_slist_prepend(&cache->idle, &entry->node);
+	sys_dlist_prepend(&cache->idle, &entry->node);
 }
@@ -7,30 +7,45 @@
 #define ZEPHYR_SUBSYS_LOGGING_LOG_CACHE_H_
 
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 struct log_cache_entry {
-	sys_snode_t node;
+	sys_dnode_t node;
+	sys_snode_t hash_node;
 	uintptr_t id;
 	uint8_t data[];
 };
 
 typedef bool (*log_cache_cmp_func_t)(uintptr_t id0, uintptr_t id1);
 
+/* Hash of an id, ids that compare equal must have the same hash. */
+typedef uint32_t (*log_cache_hash_func_t)(uintptr_t id);
+
 struct log_cache_config {
 	void *buf;
 	size_t buf_len;
 	size_t item_size;
 	log_cache_cmp_func_t cmp;
+	/* Optional, without it all entries are in a single hash bucket. */
+	log_cache_hash_func_t hash;
+	/* Hash buckets, number of buckets must be a power of 2. */
+	sys_slist_t *buckets;
+	size_t bucket_cnt;
 };
 
 struct log_cache {
-	sys_slist_t active;
-	sys_slist_t idle;
+	/* Cached entries, most recently used first. */
+	sys_dlist_t active;
+	sys_dlist_t idle;
+	sys_slist_t *buckets;
+	uint32_t bucket_mask;
+	sys_slist_t bucket;
 	log_cache_cmp_func_t cmp;
+	log_cache_hash_func_t hash;
 	uint32_t hit;
 	uint32_t miss;
 	size_t item_size;
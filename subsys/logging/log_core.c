@@ -138,6 +138,19 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* CPU 0 uses log_buffer, other CPUs use a buffer of their own. Each one has
+ * a message pointer so that z_log_msg_claim_oldest() merges them.
+ */
+#define LOG_CPU_BUFFERS (CONFIG_MP_MAX_NUM_CPUS - 1)
+
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[LOG_CPU_BUFFERS][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, cpu_log_msg_ptr, LOG_CPU_BUFFERS);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer,
+					       cpu_log_buffer, LOG_CPU_BUFFERS);
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -479,12 +492,22 @@ static bool msg_filter_check(struct log_backend const *backend,
 
 	level = log_msg_get_level(&msg->log);
 	domain_id = log_msg_get_domain(&msg->log);
-	source_id = log_msg_get_source_id(&msg->log);
 
 	/* Accept all non-logging messages. */
 	if (level == LOG_LEVEL_NONE) {
 		return true;
 	}
+
+#ifdef CONFIG_LOG_RUNTIME_FILTER_BITMAP
+	if (z_log_is_local_domain(domain_id)) {
+		const struct log_source_dynamic_data *source = log_msg_get_source(&msg->log);
+
+		return (source == NULL) ||
+		       (Z_LOG_LEVEL_MASK(source, level) & BIT(log_backend_id_get(backend)));
+	}
+#endif
+
+	source_id = log_msg_get_source_id(&msg->log);
 	if (source_id >= 0) {
 		backend_level = log_filter_get(backend, domain_id, source_id, true);
 
@@ -634,6 +657,46 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+	}
+#endif
+}
+
+/* Buffer used by the CPU the caller runs on. The caller may migrate right
+ * after reading the CPU id, it then only shares the buffer of another CPU.
+ */
+static struct mpsc_pbuf_buffer *cpu_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	uint8_t id = arch_curr_cpu()->id;
+
+	if (id > 0) {
+		return &cpu_log_buffer[id - 1];
+	}
+#endif
+	return &log_buffer;
+}
+
+/* Buffer from which a message was allocated. */
+static struct mpsc_pbuf_buffer *msg_buffer(struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	uint32_t *addr = (uint32_t *)msg;
+
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		if (addr >= cpu_buf32[i] && addr < cpu_buf32[i] + ARRAY_SIZE(cpu_buf32[i])) {
+			return &cpu_log_buffer[i];
+		}
+	}
+#endif
+	ARG_UNUSED(msg);
+
+	return &log_buffer;
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -651,7 +714,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(cpu_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -673,7 +736,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -760,7 +823,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -795,7 +859,8 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -877,6 +942,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t cpu_size, cpu_usage;
+
+		mpsc_pbuf_get_utilization(&cpu_log_buffer[i], &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
+#endif
+
 	return 0;
 }
 
@@ -888,7 +963,20 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	uint32_t cpu_max;
+	int err;
+
+	err = mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	for (int i = 0; (err == 0) && (i < LOG_CPU_BUFFERS); i++) {
+		err = mpsc_pbuf_get_max_utilization(&cpu_log_buffer[i], &cpu_max);
+		*max += cpu_max;
+	}
+
+	return err;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
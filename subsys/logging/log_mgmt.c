@@ -42,6 +42,9 @@ LOG_MODULE_REGISTER(log_mgmt);
 static uint8_t dname_cache_buffer[DCACHE_BUF_SIZE] __aligned(sizeof(uint32_t));
 static uint8_t sname_cache_buffer[SCACHE_BUF_SIZE] __aligned(sizeof(uint32_t));
 
+static sys_slist_t dname_cache_buckets[NHPOT(CONFIG_LOG_DOMAIN_NAME_CACHE_ENTRY_COUNT)];
+static sys_slist_t sname_cache_buckets[NHPOT(CONFIG_LOG_SOURCE_NAME_CACHE_ENTRY_COUNT)];
+
 static struct log_cache dname_cache;
 static struct log_cache sname_cache;
 
@@ -69,6 +72,19 @@ static bool source_id_cmp(uintptr_t id0, uintptr_t id1)
 		(s0.id.domain_id == s1.id.domain_id);
 }
 
+static uint32_t domain_id_hash(uintptr_t id)
+{
+	return (uint32_t)id;
+}
+
+/* Only hash the fields compared by source_id_cmp(), not the padding. */
+static uint32_t source_id_hash(uintptr_t id)
+{
+	union log_source_ids s = { .raw = id };
+
+	return ((uint32_t)s.id.domain_id * 0x9e3779b1U) ^ s.id.source_id;
+}
+
 /* Implementation of functions related to controlling logging sources and backends:
  * - getting/setting source details like name, filtering
  * - controlling backends filtering
@@ -158,13 +174,19 @@ static void cache_init(void)
 		.buf = dname_cache_buffer,
 		.buf_len = sizeof(dname_cache_buffer),
 		.item_size = CONFIG_LOG_DOMAIN_NAME_CACHE_ENTRY_SIZE,
-		.cmp = domain_id_cmp
+		.cmp = domain_id_cmp,
+		.hash = domain_id_hash,
+		.buckets = dname_cache_buckets,
+		.bucket_cnt = ARRAY_SIZE(dname_cache_buckets)
 	};
 	static const struct log_cache_config sname_cache_config = {
 		.buf = sname_cache_buffer,
 		.buf_len = sizeof(sname_cache_buffer),
 		.item_size = CONFIG_LOG_SOURCE_NAME_CACHE_ENTRY_SIZE,
-		.cmp = source_id_cmp
+		.cmp = source_id_cmp,
+		.hash = source_id_hash,
+		.buckets = sname_cache_buckets,
+		.bucket_cnt = ARRAY_SIZE(sname_cache_buckets)
 	};
 
 	err = log_cache_init(&dname_cache, &dname_cache_config);
@@ -231,6 +253,7 @@ static const char *link_source_name_get(uint8_t domain_id, uint32_t source_id)
 		err = log_link_get_source_name(link, rel_domain_id, source_id,
 					       cached, &cache_size);
 		if (err < 0) {
+			log_cache_release(&sname_cache, cached);
 			return NULL;
 		}
 
@@ -338,6 +361,29 @@ static uint32_t *get_dynamic_filter(uint8_t domain_id, uint32_t source_id)
 	return z_log_link_get_dynamic_filter(domain_id, source_id);
 }
 
+/* Recompute the level masks of a local source after its filters changed. */
+static void level_masks_update(uint32_t source_id)
+{
+#ifdef CONFIG_LOG_RUNTIME_FILTER_BITMAP
+	struct log_source_dynamic_data *source = &TYPE_SECTION_START(log_dynamic)[source_id];
+
+	BUILD_ASSERT(LOG_FILTERS_NUM_OF_SLOTS <= 16);
+	BUILD_ASSERT(ARRAY_SIZE(source->level_masks) == LOG_LEVEL_DBG);
+
+	for (uint32_t level = LOG_LEVEL_ERR; level <= LOG_LEVEL_DBG; level++) {
+		uint16_t mask = 0U;
+
+		for (int i = 0; i < LOG_FILTERS_NUM_OF_SLOTS; i++) {
+			if (LOG_FILTER_SLOT_GET(&source->filters, i) >= level) {
+				mask |= BIT(i);
+			}
+		}
+
+		source->level_masks[level - 1] = mask;
+	}
+#endif
+}
+
 void z_log_runtime_filters_init(void)
 {
 	/*
@@ -357,6 +403,7 @@ void z_log_runtime_filters_init(void)
 		LOG_FILTER_SLOT_SET(filters,
 				    LOG_FILTER_AGGR_SLOT_IDX,
 				    level);
+		level_masks_update(i);
 	}
 }
 
@@ -407,7 +454,9 @@ static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 
 	LOG_FILTER_SLOT_SET(filters, LOG_FILTER_AGGR_SLOT_IDX, new_max);
 
-	if (!z_log_is_local_domain(domain_id) && (new_max != prev_max)) {
+	if (z_log_is_local_domain(domain_id)) {
+		level_masks_update(source_id);
+	} else if (new_max != prev_max) {
 		(void)z_log_link_set_runtime_level(domain_id, source_id, level);
 	}
 }
@@ -10,7 +10,11 @@
 #include <zephyr/logging/log_output.h>
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
+
+#define FRAME_CRC_SEED 0xFFFFU
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 			 void *ctx)
@@ -24,19 +28,79 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+/* Copy data to the output buffer so that a whole message is usually passed
+ * to the backend in a single call, e.g. one datagram for the net backend.
+ */
+static void dict_write(const struct log_output *output, const void *data, size_t len,
+		       uint16_t *crc)
+{
+	struct log_output_control_block *cb = output->control_block;
+	const uint8_t *src = data;
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING) && (crc != NULL)) {
+		*crc = crc16_ccitt(*crc, src, len);
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE) || (output->size == 0U)) {
+		buffer_write(output->func, (uint8_t *)src, len, cb->ctx);
+		return;
+	}
+
+	while (len > 0U) {
+		size_t chunk;
+
+		if (atomic_get(&cb->offset) == output->size) {
+			log_output_flush(output);
+		}
+
+		chunk = MIN(len, output->size - atomic_get(&cb->offset));
+		memcpy(&output->buf[atomic_get(&cb->offset)], src, chunk);
+		atomic_add(&cb->offset, chunk);
+		src += chunk;
+		len -= chunk;
+	}
+}
+
+/* Write the frame header of a message of len bytes and start its CRC. */
+static void frame_start(const struct log_output *output, size_t len, uint16_t *crc)
+{
+#ifdef CONFIG_LOG_DICTIONARY_FRAMING
+	struct log_dict_output_frame_hdr_t hdr = {
+		.sync = { LOG_DICT_FRAME_SYNC0, LOG_DICT_FRAME_SYNC1 },
+		.seq = output->control_block->frame_seq++,
+		.len = len,
+	};
+
+	dict_write(output, hdr.sync, sizeof(hdr.sync), NULL);
+	*crc = FRAME_CRC_SEED;
+	dict_write(output, &hdr.seq, sizeof(hdr) - sizeof(hdr.sync), crc);
+#endif
+}
+
+static void frame_end(const struct log_output *output, uint16_t crc)
+{
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		dict_write(output, &crc, sizeof(crc), NULL);
+	}
+}
+
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
 {
-	struct log_dict_output_normal_msg_hdr_t output_hdr;
-	void *source = (void *)log_msg_get_source(msg);
-
 	/* Keep sync with header in struct log_msg */
-	output_hdr.type = MSG_NORMAL;
-	output_hdr.domain = msg->hdr.desc.domain;
-	output_hdr.level = msg->hdr.desc.level;
-	output_hdr.package_len = msg->hdr.desc.package_len;
-	output_hdr.data_len = msg->hdr.desc.data_len;
-	output_hdr.timestamp = msg->hdr.timestamp;
+	struct log_dict_output_normal_msg_hdr_t output_hdr = {
+		.type = MSG_NORMAL,
+		.domain = msg->hdr.desc.domain,
+		.level = msg->hdr.desc.level,
+		.package_len = msg->hdr.desc.package_len,
+		.data_len = msg->hdr.desc.data_len,
+		.timestamp = msg->hdr.timestamp,
+	};
+	void *source = (void *)log_msg_get_source(msg);
+	size_t package_len, data_len;
+	uint8_t *package = log_msg_get_package(msg, &package_len);
+	uint8_t *data = log_msg_get_data(msg, &data_len);
+	uint16_t crc = 0;
 
 	output_hdr.source = (source != NULL) ?
 				(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
@@ -44,31 +108,34 @@ void log_dict_output_msg_process(const struct log_output *output,
 					log_const_source_id(source)) :
 				0U;
 
-	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-		     (void *)output->control_block->ctx);
+	frame_start(output, sizeof(output_hdr) + package_len + data_len, &crc);
 
-	size_t len;
-	uint8_t *data = log_msg_get_package(msg, &len);
+	dict_write(output, &output_hdr, sizeof(output_hdr), &crc);
 
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output->control_block->ctx);
+	if (package_len > 0U) {
+		dict_write(output, package, package_len, &crc);
 	}
 
-	data = log_msg_get_data(msg, &len);
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output->control_block->ctx);
+	if (data_len > 0U) {
+		dict_write(output, data, data_len, &crc);
 	}
 
+	frame_end(output, crc);
+
 	log_output_flush(output);
 }
 
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
 {
 	struct log_dict_output_dropped_msg_t msg;
+	uint16_t crc = 0;
 
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
-		     (void *)output->control_block->ctx);
+	frame_start(output, sizeof(msg), &crc);
+	dict_write(output, &msg, sizeof(msg), &crc);
+	frame_end(output, crc);
+
+	log_output_flush(output);
 }
@@ -85,6 +85,123 @@ static inline struct net_buf *pool_get_uninit(struct net_buf_pool *pool,
 	return buf;
 }
 
+#if defined(CONFIG_NET_BUF_LOCKLESS_FREE_LIST)
+/* The head of the lock-free free list holds the index plus one of the first
+ * free buffer, or zero for an empty list, in the low bits and a tag in the
+ * high bits. Every pop bumps the tag, so that a pop which raced with others
+ * that removed and put back its head buffer (ABA) fails its compare and swap
+ * instead of installing a stale next index. Free buffers keep the index of
+ * the next one in their node.
+ */
+#define FREE_HEAD_IDX_MASK 0xffffUL
+#define FREE_HEAD_TAG_INC  (FREE_HEAD_IDX_MASK + 1UL)
+
+static inline struct net_buf *pool_buf_get(struct net_buf_pool *pool, size_t idx)
+{
+	size_t struct_size = ROUND_UP(sizeof(struct net_buf) + pool->user_data_size,
+				__alignof__(struct net_buf));
+
+	return (struct net_buf *)(((uint8_t *)pool->__bufs) + idx * struct_size);
+}
+
+static struct net_buf *free_list_pop(struct net_buf_pool *pool)
+{
+	unsigned long head, next;
+	struct net_buf *buf;
+
+	do {
+		head = atomic_get(&pool->free_head);
+		if (!(head & FREE_HEAD_IDX_MASK)) {
+			return NULL;
+		}
+
+		buf = pool_buf_get(pool, (head & FREE_HEAD_IDX_MASK) - 1);
+
+		/* Stale if the buffer was taken meanwhile, but then the tag
+		 * has changed and the compare and swap fails.
+		 */
+		next = POINTER_TO_UINT(buf->node.next);
+		next = ((head & ~FREE_HEAD_IDX_MASK) + FREE_HEAD_TAG_INC) |
+		       (next & FREE_HEAD_IDX_MASK);
+	} while (!atomic_cas(&pool->free_head, head, next));
+
+	return buf;
+}
+
+static void free_list_push(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	unsigned long idx = net_buf_id(buf) + 1;
+	unsigned long head;
+
+	do {
+		head = atomic_get(&pool->free_head);
+		buf->node.next = UINT_TO_POINTER(head & FREE_HEAD_IDX_MASK);
+	} while (!atomic_cas(&pool->free_head, head,
+			     (head & ~FREE_HEAD_IDX_MASK) | idx));
+}
+
+void z_net_buf_pool_free(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	free_list_push(pool, buf);
+
+	/* Waiters only look at the LIFO, so hand a buffer over to them. A
+	 * waiter which registered before our push may also take it from
+	 * the free list, in which case the LIFO ends up with one buffer that
+	 * is picked up by a later allocation.
+	 */
+	if (atomic_get(&pool->free_waiters)) {
+		buf = free_list_pop(pool);
+		if (buf) {
+			k_lifo_put(&pool->free, buf);
+		}
+	}
+}
+#endif /* CONFIG_NET_BUF_LOCKLESS_FREE_LIST */
+
+static struct net_buf *pool_free_get(struct net_buf_pool *pool, k_timeout_t timeout)
+{
+#if defined(CONFIG_NET_BUF_LOCKLESS_FREE_LIST)
+	struct net_buf *buf;
+
+	buf = free_list_pop(pool);
+	if (buf) {
+		return buf;
+	}
+
+	/* Buffers freed from now on are handed over through the LIFO. Check
+	 * the free list again for the ones freed before we registered.
+	 */
+	atomic_inc(&pool->free_waiters);
+
+	buf = free_list_pop(pool);
+	if (!buf) {
+		buf = k_lifo_get(&pool->free, timeout);
+	}
+
+	atomic_dec(&pool->free_waiters);
+
+	return buf;
+#else
+	return k_lifo_get(&pool->free, timeout);
+#endif
+}
+
+bool net_buf_pool_has_free(struct net_buf_pool *pool)
+{
+	/* Uninitialized buffers are not on any free list */
+	if (pool->uninit_count > 0) {
+		return true;
+	}
+
+#if defined(CONFIG_NET_BUF_LOCKLESS_FREE_LIST)
+	if (atomic_get(&pool->free_head) & FREE_HEAD_IDX_MASK) {
+		return true;
+	}
+#endif
+
+	return !k_queue_is_empty(&pool->free._queue);
+}
+
 void net_buf_reset(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf->flags == 0U);
@@ -166,6 +283,123 @@ const struct net_buf_data_cb net_buf_fixed_cb = {
 	.unref = fixed_data_unref,
 };
 
+static uint8_t *multi_data_alloc(struct net_buf *buf, size_t *size,
+				 k_timeout_t timeout)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	const struct net_buf_pool_multi *multi = pool->alloc->alloc_data;
+	const struct net_buf_pool_multi_class *class;
+	size_t best = multi->class_count;
+	size_t idx;
+	uint8_t *hdr;
+
+	/* Use the smallest fitting class with a free block */
+	for (idx = 0; idx < multi->class_count; idx++) {
+		class = &multi->classes[idx];
+
+		if (class->size < *size) {
+			continue;
+		}
+
+		if (best == multi->class_count) {
+			best = idx;
+		}
+
+		if (k_mem_slab_alloc(class->slab, (void **)&hdr, K_NO_WAIT) == 0) {
+			goto success;
+		}
+	}
+
+	if (best == multi->class_count) {
+		NET_BUF_ERR("No data size class for %zu bytes", *size);
+		return NULL;
+	}
+
+	/* All fitting classes are exhausted, wait for the best fit */
+	idx = best;
+	class = &multi->classes[idx];
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+	    k_mem_slab_alloc(class->slab, (void **)&hdr, timeout) != 0) {
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+		atomic_inc(&class->usage->failures);
+#endif
+		return NULL;
+	}
+
+success:
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_inc(&class->usage->allocs);
+	if (idx != best) {
+		atomic_inc(&class->usage->fallbacks);
+	}
+#endif
+
+	/* Reference count, as expected by generic_data_ref() */
+	hdr[0] = 1U;
+	hdr[1] = idx;
+
+	*size = class->size;
+
+	return hdr + sizeof(void *);
+}
+
+static void multi_data_unref(struct net_buf *buf, uint8_t *data)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	const struct net_buf_pool_multi *multi = pool->alloc->alloc_data;
+	uint8_t *hdr;
+
+	hdr = data - sizeof(void *);
+	if (--hdr[0]) {
+		return;
+	}
+
+	__ASSERT_NO_MSG(hdr[1] < multi->class_count);
+
+	k_mem_slab_free(multi->classes[hdr[1]].slab, hdr);
+}
+
+const struct net_buf_data_cb net_buf_multi_cb = {
+	.alloc = multi_data_alloc,
+	.ref   = generic_data_ref,
+	.unref = multi_data_unref,
+};
+
+int net_buf_multi_class_stats_get(struct net_buf_pool *pool, size_t idx,
+				  struct net_buf_multi_class_stats *stats)
+{
+	const struct net_buf_pool_multi *multi;
+	const struct net_buf_pool_multi_class *class;
+
+	if (pool->alloc->cb != &net_buf_multi_cb) {
+		return -EINVAL;
+	}
+
+	multi = pool->alloc->alloc_data;
+	if (idx >= multi->class_count) {
+		return -ENOENT;
+	}
+
+	class = &multi->classes[idx];
+
+	stats->size = class->size;
+	stats->blocks = class->slab->info.num_blocks;
+	stats->used = k_mem_slab_num_used_get(class->slab);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	stats->allocs = atomic_get(&class->usage->allocs);
+	stats->fallbacks = atomic_get(&class->usage->fallbacks);
+	stats->failures = atomic_get(&class->usage->failures);
+#else
+	stats->allocs = 0U;
+	stats->fallbacks = 0U;
+	stats->failures = 0U;
+#endif
+
+	return 0;
+}
+
 #if (K_HEAP_MEM_POOL_SIZE > 0)
 
 static uint8_t *heap_data_alloc(struct net_buf *buf, size_t *size,
@@ -239,6 +473,13 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_LOCKLESS_FREE_LIST)
+	buf = free_list_pop(pool);
+	if (buf) {
+		goto success;
+	}
+#endif
+
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -255,7 +496,7 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 		 * buffer from the LIFO with K_NO_WAIT.
 		 */
 		if (pool->uninit_count < pool->buf_count) {
-			buf = k_lifo_get(&pool->free, K_NO_WAIT);
+			buf = pool_free_get(pool, K_NO_WAIT);
 			if (buf) {
 				k_spin_unlock(&pool->lock, key);
 				goto success;
@@ -280,7 +521,7 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
-		buf = k_lifo_get(&pool->free, K_NO_WAIT);
+		buf = pool_free_get(pool, K_NO_WAIT);
 		while (!buf) {
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
 			NET_BUF_WARN("%s():%d: Pool %s low on buffers.",
@@ -289,7 +530,7 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 			NET_BUF_WARN("%s():%d: Pool %p low on buffers.",
 				     func, line, pool);
 #endif
-			buf = k_lifo_get(&pool->free, WARN_ALLOC_INTERVAL);
+			buf = pool_free_get(pool, WARN_ALLOC_INTERVAL);
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
 			NET_BUF_WARN("%s():%d: Pool %s blocked for %u secs",
 				     func, line, pool->name,
@@ -301,10 +542,10 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #endif
 		}
 	} else {
-		buf = k_lifo_get(&pool->free, timeout);
+		buf = pool_free_get(pool, timeout);
 	}
 #else
-	buf = k_lifo_get(&pool->free, timeout);
+	buf = pool_free_get(pool, timeout);
 #endif
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
@@ -112,10 +112,10 @@ struct net_ipv6_nbr_data {
 	bool is_router;
 
 #if defined(CONFIG_NET_IPV6_NBR_CACHE) || defined(CONFIG_NET_IPV6_ND)
-	/** Stale counter used to removed oldest nbr in STALE state,
-	 *  when table is full.
+	/** Node in the list of neighbors in STALE state, used to remove
+	 *  the oldest one when table is full.
 	 */
-	uint32_t stale_counter;
+	sys_dnode_t stale_node;
 #endif
 };
 
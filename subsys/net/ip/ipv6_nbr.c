@@ -56,14 +56,12 @@ LOG_MODULE_REGISTER(net_ipv6_nd, CONFIG_NET_IPV6_ND_LOG_LEVEL);
 #define MAX_IPV6_MTU 0xffff
 
 #if defined(CONFIG_NET_IPV6_NBR_CACHE) || defined(CONFIG_NET_IPV6_ND)
-/* Global stale counter, whenever ipv6 neighbor enters into
- * stale state, stale counter is incremented by one.
- * When network stack tries to add new neighbor and if table
- * is full, oldest (oldest stale counter) neighbor in stale
- * state will be removed from the table and new entry will be
- * added.
+/* Neighbors in stale state, in the order they entered it. When
+ * network stack tries to add new neighbor and if table is full,
+ * oldest neighbor in stale state will be removed from the table
+ * and new entry will be added.
  */
-static uint32_t stale_counter;
+static sys_dlist_t stale_list = SYS_DLIST_STATIC_INIT(&stale_list);
 #endif
 
 #if defined(CONFIG_NET_IPV6_ND)
@@ -91,10 +89,10 @@ NET_NBR_POOL_INIT(net_neighbor_pool,
 		  sizeof(struct net_ipv6_nbr_data),
 		  net_neighbor_remove);
 
-NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
-		   neighbor,
-		   net_neighbor_pool,
-		   net_neighbor_table_clear);
+NET_NBR_TABLE_HASH_INIT(NET_NBR_GLOBAL,
+			neighbor,
+			net_neighbor_pool,
+			net_neighbor_table_clear);
 
 static K_MUTEX_DEFINE(nbr_lock);
 
@@ -135,17 +133,8 @@ static inline struct net_nbr *get_nbr(int idx)
 
 static inline struct net_nbr *get_nbr_from_data(struct net_ipv6_nbr_data *data)
 {
-	int i;
-
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
-
-		if (nbr->data == (uint8_t *)data) {
-			return nbr;
-		}
-	}
-
-	return NULL;
+	/* The neighbor data lives in the trailing storage of the neighbor */
+	return (struct net_nbr *)((uint8_t *)data - offsetof(struct net_nbr, __nbr));
 }
 
 static void ipv6_nbr_set_state(struct net_nbr *nbr,
@@ -163,36 +152,9 @@ static void ipv6_nbr_set_state(struct net_nbr *nbr,
 	net_ipv6_nbr_data(nbr)->state = new_state;
 
 	if (net_ipv6_nbr_data(nbr)->state == NET_IPV6_NBR_STATE_STALE) {
-		if (stale_counter + 1 != UINT32_MAX) {
-			net_ipv6_nbr_data(nbr)->stale_counter = stale_counter++;
-		} else {
-			/* Global stale counter reached UINT32_MAX, reset it and
-			 * respective neighbors stale counter too.
-			 */
-			struct net_nbr *n = NULL;
-			struct net_ipv6_nbr_data *data = NULL;
-			int i;
-
-			stale_counter = 0U;
-
-			for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-				n = get_nbr(i);
-				if (!n || !n->ref) {
-					continue;
-				}
-
-				data = net_ipv6_nbr_data(nbr);
-				if (!data) {
-					continue;
-				}
-
-				if (data->state != NET_IPV6_NBR_STATE_STALE) {
-					continue;
-				}
-
-				data->stale_counter = stale_counter++;
-			}
-		}
+		sys_dlist_append(&stale_list, &net_ipv6_nbr_data(nbr)->stale_node);
+	} else if (sys_dnode_is_linked(&net_ipv6_nbr_data(nbr)->stale_node)) {
+		sys_dlist_remove(&net_ipv6_nbr_data(nbr)->stale_node);
 	}
 }
 
@@ -265,16 +227,29 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+/* The neighbors are indexed by address only, so that lookups without
+ * an interface can use the index too.
+ */
+static uint32_t nbr_hash(const struct in6_addr *addr)
+{
+	uint32_t hash = 0U;
+
+	for (int i = 0; i < 4; i++) {
+		hash = (hash ^ UNALIGNED_GET(&addr->s6_addr32[i])) * 0x9e3779b1U;
+	}
+
+	return hash ^ (hash >> 16);
+}
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
-
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	uint32_t hash = nbr_hash(addr);
+	struct net_nbr *nbr;
 
-		if (!nbr->ref) {
+	SYS_SLIST_FOR_EACH_CONTAINER(net_nbr_hash_bucket(table, hash), nbr, hash_node) {
+		if (!nbr->ref || nbr->hash != hash) {
 			continue;
 		}
 
@@ -425,6 +400,9 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	nbr->iface = iface;
 
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
+
+	/* The neighbor may be reused, start from a known state */
+	net_ipv6_nbr_data(nbr)->state = NET_IPV6_NBR_STATE_INCOMPLETE;
 	ipv6_nbr_set_state(nbr, state);
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
@@ -448,6 +426,8 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 
 	nbr_init(nbr, iface, addr, is_router, state);
 
+	net_nbr_hash_add(&net_neighbor.table, nbr, nbr_hash(addr));
+
 	NET_DBG("nbr %p iface %p/%d state %d IPv6 %s",
 		nbr, iface, net_if_get_by_iface(iface), state,
 		net_sprint_ipv6_addr(addr));
@@ -518,46 +498,18 @@ static void dbg_update_neighbor_lladdr_raw(uint8_t *new_lladdr,
 
 static void ipv6_nd_remove_old_stale_nbr(void)
 {
-	struct net_nbr *nbr = NULL;
-	struct net_ipv6_nbr_data *data = NULL;
-	int nbr_idx = -1;
-	uint32_t oldest = UINT32_MAX;
-	int i;
-
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		nbr = get_nbr(i);
-		if (!nbr || !nbr->ref) {
-			continue;
-		}
-
-		data = net_ipv6_nbr_data(nbr);
-		if (!data || data->is_router ||
-		    data->state != NET_IPV6_NBR_STATE_STALE) {
-			continue;
-		}
-
-		if (nbr_idx == -1) {
-			nbr_idx = i;
-			oldest = data->stale_counter;
-			continue;
-		}
+	struct net_ipv6_nbr_data *data;
+	struct net_nbr *nbr;
 
-		if (oldest == MIN(oldest, data->stale_counter)) {
+	/* The stale list is ordered, the first non-router is the oldest */
+	SYS_DLIST_FOR_EACH_CONTAINER(&stale_list, data, stale_node) {
+		if (data->is_router) {
 			continue;
 		}
 
-		nbr_idx = i;
-		oldest = data->stale_counter;
-	}
-
-	if (nbr_idx != -1) {
-		nbr = get_nbr(nbr_idx);
-		if (!nbr) {
-			return;
-		}
-
-		net_ipv6_nbr_rm(nbr->iface,
-				&net_ipv6_nbr_data(nbr)->addr);
+		nbr = get_nbr_from_data(data);
+		net_ipv6_nbr_rm(nbr->iface, &data->addr);
+		return;
 	}
 }
 
@@ -668,7 +620,15 @@ void net_neighbor_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	net_ipv6_nbr_lock();
+
+	net_nbr_hash_remove(&net_neighbor.table, nbr);
+
+	if (sys_dnode_is_linked(&net_ipv6_nbr_data(nbr)->stale_node)) {
+		sys_dlist_remove(&net_ipv6_nbr_data(nbr)->stale_node);
+	}
+
+	net_ipv6_nbr_unlock();
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -806,9 +766,11 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. Packets that
+	 * are segmented by the device (TCP segmentation offload) are not
+	 * fragmented either.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && net_pkt_gso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -1514,7 +1476,7 @@ static void ipv6_nd_reachable_timeout(struct k_work *work)
 			break;
 
 		case NET_IPV6_NBR_STATE_REACHABLE:
-			data->state = NET_IPV6_NBR_STATE_STALE;
+			ipv6_nbr_set_state(nbr, NET_IPV6_NBR_STATE_STALE);
 
 			NET_DBG("nbr %p moving %s state to STALE (%d)",
 				nbr,
@@ -1530,7 +1492,7 @@ static void ipv6_nd_reachable_timeout(struct k_work *work)
 			break;
 
 		case NET_IPV6_NBR_STATE_DELAY:
-			data->state = NET_IPV6_NBR_STATE_PROBE;
+			ipv6_nbr_set_state(nbr, NET_IPV6_NBR_STATE_PROBE);
 			data->ns_count = 0U;
 
 			NET_DBG("nbr %p moving %s state to PROBE (%d)",
@@ -57,9 +57,11 @@ struct net_nbr *net_nbr_ref(struct net_nbr *nbr)
 	return nbr;
 }
 
-static inline struct net_nbr *get_nbr(struct net_nbr *start, int idx)
+static inline struct net_nbr *get_nbr(struct net_nbr_table *table, int idx)
 {
-	NET_ASSERT(idx < CONFIG_NET_IPV6_MAX_NEIGHBORS);
+	struct net_nbr *start = table->nbr;
+
+	NET_ASSERT(idx < table->nbr_count);
 
 	return (struct net_nbr *)((uint8_t *)start +
 			((sizeof(struct net_nbr) + start->size) * idx));
@@ -70,7 +72,7 @@ struct net_nbr *net_nbr_get(struct net_nbr_table *table)
 	int i;
 
 	for (i = 0; i < table->nbr_count; i++) {
-		struct net_nbr *nbr = get_nbr(table->nbr, i);
+		struct net_nbr *nbr = get_nbr(table, i);
 
 		if (!nbr->ref) {
 			nbr->data = nbr->__nbr;
@@ -82,6 +84,23 @@ struct net_nbr *net_nbr_get(struct net_nbr_table *table)
 	return NULL;
 }
 
+void net_nbr_hash_add(struct net_nbr_table *table, struct net_nbr *nbr,
+		      uint32_t hash)
+{
+	NET_ASSERT(table->buckets != NULL);
+
+	nbr->hash = hash;
+	sys_slist_prepend(net_nbr_hash_bucket(table, hash), &nbr->hash_node);
+}
+
+void net_nbr_hash_remove(struct net_nbr_table *table, struct net_nbr *nbr)
+{
+	NET_ASSERT(table->buckets != NULL);
+
+	(void)sys_slist_find_and_remove(net_nbr_hash_bucket(table, nbr->hash),
+					&nbr->hash_node);
+}
+
 int net_nbr_link(struct net_nbr *nbr, struct net_if *iface,
 		 const struct net_linkaddr *lladdr)
 {
@@ -163,7 +182,7 @@ struct net_nbr *net_nbr_lookup(struct net_nbr_table *table,
 	int i;
 
 	for (i = 0; i < table->nbr_count; i++) {
-		struct net_nbr *nbr = get_nbr(table->nbr, i);
+		struct net_nbr *nbr = get_nbr(table, i);
 
 		if (nbr->ref && nbr->iface == iface &&
 		    net_neighbor_lladdr[nbr->idx].ref &&
@@ -190,7 +209,7 @@ void net_nbr_clear_table(struct net_nbr_table *table)
 	int i;
 
 	for (i = 0; i < table->nbr_count; i++) {
-		struct net_nbr *nbr = get_nbr(table->nbr, i);
+		struct net_nbr *nbr = get_nbr(table, i);
 		struct net_linkaddr lladdr = {
 			.addr = net_neighbor_lladdr[i].lladdr.addr,
 			.len = net_neighbor_lladdr[i].lladdr.len
@@ -210,7 +229,7 @@ void net_nbr_print(struct net_nbr_table *table)
 		int i;
 
 		for (i = 0; i < table->nbr_count; i++) {
-			struct net_nbr *nbr = get_nbr(table->nbr, i);
+			struct net_nbr *nbr = get_nbr(table, i);
 
 			if (!nbr->ref) {
 				continue;
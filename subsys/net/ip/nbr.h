@@ -13,6 +13,7 @@
 #include <stddef.h>
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <zephyr/sys/slist.h>
 
 #include <zephyr/net/net_if.h>
 
@@ -65,6 +66,12 @@ struct net_nbr {
 	/** Function to be called when the neighbor is removed. */
 	void (*const remove)(struct net_nbr *nbr);
 
+	/** Node in the hash bucket, if the neighbor table is hashed. */
+	sys_snode_t hash_node;
+
+	/** Hash of the neighbor key, computed by the table owner. */
+	uint32_t hash;
+
 	/** Start of the data storage. Not to be accessed directly
 	 *  (the data pointer should be used instead).
 	 */
@@ -90,6 +97,12 @@ struct net_nbr_table {
 	/** Function to be called when the table is cleared. */
 	void (*const clear)(struct net_nbr_table *table);
 
+	/** Hash buckets indexing the neighbors, NULL if not hashed */
+	sys_slist_t *const buckets;
+
+	/** Number of hash buckets, a power of two */
+	const uint16_t bucket_count;
+
 	/** Max number of neighbors in the pool */
 	const uint16_t nbr_count;
 };
@@ -110,6 +123,24 @@ struct net_nbr_table {
 		}							\
 	}
 
+/* Same as NET_NBR_TABLE_INIT() but the table also gets hash buckets, so
+ * that neighbors can be indexed by a key of the table owner with
+ * net_nbr_hash_add() and found with net_nbr_hash_bucket().
+ */
+#define NET_NBR_TABLE_HASH_INIT(_type, _name, _pool, _clear)		\
+	static sys_slist_t net_##_name##_buckets[NHPOT(ARRAY_SIZE(_pool))]; \
+	_type struct net_nbr_table_##_name {				\
+		struct net_nbr_table table;				\
+	} net_##_name __used = {					\
+		.table = {						\
+			.clear = _clear,				\
+			.nbr = (struct net_nbr *)_pool,			\
+			.buckets = net_##_name##_buckets,		\
+			.bucket_count = ARRAY_SIZE(net_##_name##_buckets), \
+			.nbr_count = ARRAY_SIZE(_pool),			\
+		}							\
+	}
+
 /**
  * @brief Decrement the reference count. If count goes to 0, the neighbor
  * is released and returned to free list.
@@ -153,6 +184,36 @@ struct net_nbr *net_nbr_lookup(struct net_nbr_table *table,
 			       struct net_if *iface,
 			       struct net_linkaddr *lladdr);
 
+/**
+ * @brief Get the hash bucket of the neighbors with a given key hash.
+ * The neighbors are linked to the bucket with their hash_node.
+ * @param table Hashed neighbor table
+ * @param hash Hash of the key
+ * @return Pointer to the bucket list
+ */
+static inline sys_slist_t *net_nbr_hash_bucket(struct net_nbr_table *table,
+					       uint32_t hash)
+{
+	return &table->buckets[hash & (table->bucket_count - 1)];
+}
+
+/**
+ * @brief Index a neighbor in a hashed table.
+ * @param table Hashed neighbor table
+ * @param nbr Neighbor, not already indexed
+ * @param hash Hash of the neighbor key
+ */
+void net_nbr_hash_add(struct net_nbr_table *table, struct net_nbr *nbr,
+		      uint32_t hash);
+
+/**
+ * @brief Remove a neighbor from the index of a hashed table. Does nothing
+ * if the neighbor is not indexed.
+ * @param table Hashed neighbor table
+ * @param nbr Neighbor
+ */
+void net_nbr_hash_remove(struct net_nbr_table *table, struct net_nbr *nbr);
+
 /**
  * @brief Link a neighbor to specific link layer address.
  * @param table Neighbor table
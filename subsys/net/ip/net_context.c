@@ -1739,9 +1739,32 @@ static int get_context_addr_preferences(struct net_context *context,
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
+static int write_data(struct net_pkt *pkt, const void *buf, size_t len,
+		      uint16_t *sum, size_t offset)
+{
+	uint16_t part = 0U;
+	int ret;
+
+	if (sum == NULL) {
+		return net_pkt_write(pkt, buf, len);
+	}
+
+	ret = net_pkt_write_chksum(pkt, buf, len, &part);
+	if (ret == 0) {
+		*sum = calc_chksum_add(*sum, part, offset);
+	}
+
+	return ret;
+}
+
+/* If sum is given, the data is checksummed while it is written, see
+ * net_calc_chksum().
+ */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      uint16_t *sum)
 {
+	size_t offset = 0;
 	int ret = 0;
 
 	if (msghdr) {
@@ -1750,19 +1773,20 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
 			int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
 
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    len);
+			ret = write_data(pkt, msghdr->msg_iov[i].iov_base,
+					 len, sum, offset);
 			if (ret < 0) {
 				break;
 			}
 
+			offset += len;
 			buf_len -= len;
 			if (buf_len == 0) {
 				break;
 			}
 		}
 	} else {
-		ret = net_pkt_write(pkt, buf, buf_len);
+		ret = write_data(pkt, buf, buf_len, sum, offset);
 	}
 
 	return ret;
@@ -1779,6 +1803,7 @@ static int context_setup_udp_packet(struct net_context *context,
 {
 	int ret = -EINVAL;
 	uint16_t dst_port = 0U;
+	uint16_t sum = 0U;
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
 		struct sockaddr_in6 *addr6 = (struct sockaddr_in6 *)dst_addr;
@@ -1813,11 +1838,18 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	/* No point in summing the data if the checksum is offloaded */
+	if (!net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+		return context_write_data(pkt, buf, len, msg, NULL);
+	}
+
+	ret = context_write_data(pkt, buf, len, msg, &sum);
 	if (ret) {
 		return ret;
 	}
 
+	net_pkt_set_data_chksum(pkt, sum, len);
+
 	return 0;
 }
 
@@ -1900,6 +1932,7 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
+			  int flags,
 			  bool sendto)
 {
 	const struct msghdr *msghdr = NULL;
@@ -2186,7 +2219,7 @@ static int context_sendto(struct net_context *context,
 skip_alloc:
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2215,7 +2248,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		ret = net_tcp_queue(context, buf, len, msghdr, flags);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2224,7 +2257,7 @@ skip_alloc:
 
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && family == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2254,7 +2287,7 @@ skip_alloc:
 		}
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == AF_CAN &&
 		   net_context_get_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2317,7 +2350,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, 0, false);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -2336,7 +2369,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, flags, true);
 
 	k_mutex_unlock(&context->lock);
 
@@ -2357,7 +2390,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, 0, true);
 
 	k_mutex_unlock(&context->lock);
 
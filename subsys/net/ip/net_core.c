@@ -409,6 +409,7 @@ int net_send_data(struct net_pkt *pkt)
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
 		processing_data(pkt, true);
+		net_tcp_gro_flush();
 		return 0;
 	}
 
@@ -481,6 +482,7 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
+		net_tcp_gro_flush();
 	} else {
 		net_tc_submit_to_rx_queue(tc, pkt);
 	}
@@ -31,6 +31,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -485,6 +486,14 @@ enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 		goto done;
 	}
 
+	/* Split large TCP packets into segments unless the device does it */
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U) {
+		verdict = net_tcp_gso_prepare_for_send(pkt);
+		if (verdict != NET_OK) {
+			goto done;
+		}
+	}
+
 	/* If the ll dst address is not set check if it is present in the nbr
 	 * cache.
 	 */
@@ -4976,7 +4985,7 @@ void net_if_call_link_cb(struct net_if *iface, struct net_linkaddr *lladdr,
 	k_mutex_unlock(&lock);
 }
 
-static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
+static bool need_sw_offload(struct net_if *iface, enum ethernet_hw_caps caps)
 {
 #if defined(CONFIG_NET_L2_ETHERNET)
 	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
@@ -4994,12 +5003,22 @@ static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
 
 bool net_if_need_calc_tx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
+	return need_sw_offload(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
 }
 
 bool net_if_need_calc_rx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+	return need_sw_offload(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+}
+
+bool net_if_need_tcp_segmentation(struct net_if *iface)
+{
+	return need_sw_offload(iface, ETHERNET_HW_TSO);
+}
+
+bool net_if_need_tcp_coalescing(struct net_if *iface)
+{
+	return need_sw_offload(iface, ETHERNET_HW_LRO);
 }
 
 int net_if_get_by_iface(struct net_if *iface)
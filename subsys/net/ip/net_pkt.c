@@ -101,6 +101,14 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #endif
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
+#if defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+BUILD_ASSERT(CONFIG_NET_BUF_MULTI_LARGE_SIZE >= MAX_IP_PROTO_LEN + MAX_NEXT_PROTO_LEN,
+	     "Too small net_buf fragment size");
+BUILD_ASSERT(CONFIG_NET_BUF_MULTI_SMALL_SIZE < CONFIG_NET_BUF_MULTI_MEDIUM_SIZE &&
+	     CONFIG_NET_BUF_MULTI_MEDIUM_SIZE < CONFIG_NET_BUF_MULTI_LARGE_SIZE,
+	     "Data size classes must be in ascending order");
+#endif /* CONFIG_NET_BUF_MULTI_DATA_SIZE */
+
 #if CONFIG_NET_PKT_RX_COUNT <= 0
 #error "Minimum value for CONFIG_NET_PKT_RX_COUNT is 1"
 #endif
@@ -127,7 +135,14 @@ NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_BUF_DATA_
 NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT, CONFIG_NET_BUF_DATA_SIZE,
 			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
 
-#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#elif defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+
+NET_BUF_POOL_MULTI_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_PKT_BUF_USER_DATA_SIZE,
+			  NULL, NET_BUF_MULTI_CLASSES);
+NET_BUF_POOL_MULTI_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT, CONFIG_NET_PKT_BUF_USER_DATA_SIZE,
+			  NULL, NET_BUF_MULTI_CLASSES);
+
+#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE && !CONFIG_NET_BUF_MULTI_DATA_SIZE */
 
 NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE,
 			CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
@@ -913,7 +928,65 @@ error:
 	return NULL;
 }
 
-#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#elif defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
+					size_t size, k_timeout_t timeout,
+					const char *caller, int line)
+#else
+static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
+					size_t size, k_timeout_t timeout)
+#endif
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct net_buf *first = NULL;
+	struct net_buf *current = NULL;
+
+	/* Each fragment comes from the best fitting size class, requests
+	 * bigger than the largest class are split over several fragments.
+	 */
+	do {
+		struct net_buf *new;
+
+		new = net_buf_alloc_len(pool, MIN(size, CONFIG_NET_BUF_MULTI_LARGE_SIZE),
+					timeout);
+		if (!new) {
+			goto error;
+		}
+
+		if (!first && !current) {
+			first = new;
+		} else {
+			current->frags = new;
+		}
+
+		current = new;
+		size -= MIN(size, current->size);
+
+		timeout = sys_timepoint_timeout(end);
+
+#if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
+		NET_FRAG_CHECK_IF_NOT_IN_USE(new, new->ref + 1);
+
+		net_pkt_alloc_add(new, false, caller, line);
+
+		NET_DBG("%s (%s) [%d] frag %p ref %d (%s():%d)",
+			pool2str(pool), get_name(pool), get_frees(pool),
+			new, new->ref, caller, line);
+#endif
+	} while (size);
+
+	return first;
+error:
+	if (first) {
+		net_buf_unref(first);
+	}
+
+	return NULL;
+}
+
+#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE && !CONFIG_NET_BUF_MULTI_DATA_SIZE */
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
@@ -1103,6 +1176,8 @@ int net_pkt_remove_tail(struct net_pkt *pkt, size_t length)
 		return -EINVAL;
 	}
 
+	net_pkt_set_data_chksum(pkt, 0U, 0U);
+
 	remaining_len -= length;
 
 	while (buf) {
@@ -1543,6 +1618,9 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
 
 void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer)
 {
+	/* The payload sum no longer covers the end of the packet */
+	net_pkt_set_data_chksum(pkt, 0U, 0U);
+
 	if (!pkt->buffer) {
 		pkt->buffer = buffer;
 		net_pkt_cursor_init(pkt);
@@ -1803,6 +1881,103 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 	return 0;
 }
 
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 uint16_t *sum)
+{
+	struct net_pkt_cursor *c_op = &pkt->cursor;
+	const uint8_t *src = data;
+	size_t done = 0;
+
+	while (c_op->buf && done < length) {
+		bool ow = net_pkt_is_being_overwritten(pkt);
+		size_t d_len, len;
+
+		pkt_cursor_advance(pkt, !ow);
+		if (c_op->buf == NULL) {
+			break;
+		}
+
+		if (ow) {
+			d_len = c_op->buf->len - (c_op->pos - c_op->buf->data);
+		} else {
+			d_len = net_buf_max_len(c_op->buf) -
+				(c_op->pos - c_op->buf->data);
+		}
+
+		if (!d_len) {
+			break;
+		}
+
+		len = MIN(length - done, d_len);
+
+		*sum = calc_chksum_add(*sum, calc_chksum_copy(0, c_op->pos,
+							 src + done, len),
+				  done);
+
+		if (!ow) {
+			net_buf_add(c_op->buf, len);
+		}
+
+		pkt_cursor_update(pkt, len, true);
+
+		done += len;
+	}
+
+	if (done < length) {
+		NET_DBG("Still some length to go %zu", length - done);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
+int net_pkt_copy_chksum(struct net_pkt *pkt_dst, struct net_pkt *pkt_src,
+			size_t length, uint16_t *sum)
+{
+	struct net_pkt_cursor *c_dst = &pkt_dst->cursor;
+	struct net_pkt_cursor *c_src = &pkt_src->cursor;
+	size_t done = 0;
+
+	while (c_dst->buf && c_src->buf && done < length) {
+		size_t s_len, d_len, len;
+
+		pkt_cursor_advance(pkt_dst, true);
+		pkt_cursor_advance(pkt_src, false);
+
+		if (!c_dst->buf || !c_src->buf) {
+			break;
+		}
+
+		s_len = c_src->buf->len - (c_src->pos - c_src->buf->data);
+		d_len = net_buf_max_len(c_dst->buf) - (c_dst->pos - c_dst->buf->data);
+		len = MIN(length - done, MIN(s_len, d_len));
+
+		if (!len) {
+			break;
+		}
+
+		*sum = calc_chksum_add(*sum, calc_chksum_copy(0, c_dst->pos,
+							 c_src->pos, len),
+				  done);
+
+		if (!net_pkt_is_being_overwritten(pkt_dst)) {
+			net_buf_add(c_dst->buf, len);
+		}
+
+		pkt_cursor_update(pkt_dst, len, true);
+		pkt_cursor_update(pkt_src, len, false);
+
+		done += len;
+	}
+
+	if (done < length) {
+		NET_DBG("Still some length to go %zu", length - done);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
 static int32_t net_pkt_find_offset(struct net_pkt *pkt, uint8_t *ptr)
 {
 	struct net_buf *buf;
@@ -1879,6 +2054,8 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
+	net_pkt_set_rx_hash(clone_pkt, net_pkt_rx_hash(pkt));
 
 	if (pkt->buffer && clone_pkt->buffer) {
 		memcpy(net_pkt_lladdr_src(clone_pkt), net_pkt_lladdr_src(pkt),
@@ -2030,6 +2207,8 @@ int net_pkt_update_length(struct net_pkt *pkt, size_t length)
 {
 	struct net_buf *buf;
 
+	net_pkt_set_data_chksum(pkt, 0U, 0U);
+
 	for (buf = pkt->buffer; buf; buf = buf->frags) {
 		if (buf->len < length) {
 			length -= buf->len;
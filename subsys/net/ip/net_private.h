@@ -53,6 +53,20 @@ union net_mgmt_events {
 
 #endif
 
+#if defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+/* Data size classes of the multi-size network buffer pools */
+#define NET_BUF_MULTI_CLASSES							\
+	(CONFIG_NET_BUF_MULTI_SMALL_SIZE, CONFIG_NET_BUF_MULTI_SMALL_COUNT),	\
+	(CONFIG_NET_BUF_MULTI_MEDIUM_SIZE, CONFIG_NET_BUF_MULTI_MEDIUM_COUNT),	\
+	(CONFIG_NET_BUF_MULTI_LARGE_SIZE, CONFIG_NET_BUF_MULTI_LARGE_COUNT)
+
+/* Total data memory of one multi-size network buffer pool */
+#define NET_BUF_MULTI_DATA_POOL_SIZE						\
+	(CONFIG_NET_BUF_MULTI_SMALL_SIZE * CONFIG_NET_BUF_MULTI_SMALL_COUNT +	\
+	 CONFIG_NET_BUF_MULTI_MEDIUM_SIZE * CONFIG_NET_BUF_MULTI_MEDIUM_COUNT +	\
+	 CONFIG_NET_BUF_MULTI_LARGE_SIZE * CONFIG_NET_BUF_MULTI_LARGE_COUNT)
+#endif /* CONFIG_NET_BUF_MULTI_DATA_SIZE */
+
 #include "connection.h"
 
 extern void net_if_init(void);
@@ -229,8 +243,63 @@ extern char *net_byte_to_hex(char *ptr, uint8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
+extern uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst,
+				 const uint8_t *src, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/* Add the partial checksum of a chunk which starts at the given offset of
+ * the checksummed data, odd offsets swap the bytes of the partial sum.
+ */
+static inline uint16_t calc_chksum_add(uint16_t sum, uint16_t part,
+				       size_t offset)
+{
+	if (offset & 1) {
+		part = BSWAP_16(part);
+	}
+
+	sum += part;
+	if (sum < part) {
+		sum++;
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Write data into a net_pkt and add it to a running checksum
+ *
+ * Same as net_pkt_write() but the data is checksummed while it is copied,
+ * so it is only read once. The checksum is the unfolded one's complement
+ * sum in host byte order of the written data, as if it started at an even
+ * offset. Use calc_chksum_add() to combine the sums of data written by
+ * several calls.
+ *
+ * @param pkt The network packet to write into
+ * @param data Data to be written
+ * @param length Length of the data to be written
+ * @param sum Running checksum, updated on return
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 uint16_t *sum);
+
+/**
+ * @brief Copy data from a packet into another one and checksum it
+ *
+ * Same as net_pkt_copy() with the checksum handling of
+ * net_pkt_write_chksum().
+ *
+ * @param pkt_dst Destination network packet
+ * @param pkt_src Source network packet
+ * @param length Length of data to be copied
+ * @param sum Running checksum, updated on return
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_copy_chksum(struct net_pkt *pkt_dst, struct net_pkt *pkt_src,
+			size_t length, uint16_t *sum);
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
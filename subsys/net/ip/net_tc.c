@@ -13,23 +13,40 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
+#include "tcp_internal.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With RX flow steering, the RX thread names are "rx_q[y.z]" where z is the
+ * flow queue of the traffic class.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.z]")
+
+/* With flow steering, each RX traffic class has NET_RX_FLOW_QUEUES queues
+ * and the queue of traffic class y for flow queue z is at index
+ * y * NET_RX_FLOW_QUEUES + z.
+ */
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+#define NET_RX_FLOW_QUEUES CONFIG_NET_RX_FLOW_QUEUES
+#else
+#define NET_RX_FLOW_QUEUES 1
+#endif
+
+#define NET_RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_RX_FLOW_QUEUES)
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +54,7 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_RX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -60,12 +77,163 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+#define FLOW_HASH_OFFSET 2166136261U
+#define FLOW_HASH_PRIME 16777619U
+
+static uint32_t flow_hash_update(uint32_t hash, const uint8_t *data, size_t len)
+{
+	while (len-- > 0) {
+		hash = (hash ^ *data++) * FLOW_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+/* Return the ethernet type of the network packet in the buffer and skip
+ * its L2 header, or 0 if the L2 is not known.
+ */
+static uint16_t flow_l3_type(struct net_if *iface, const uint8_t **data, size_t *len)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		const struct net_eth_hdr *eth = (const struct net_eth_hdr *)*data;
+		size_t hdr_len = sizeof(struct net_eth_hdr);
+		uint16_t type;
+
+		if (*len < hdr_len) {
+			return 0;
+		}
+
+		type = ntohs(eth->type);
+
+		if (type == NET_ETH_PTYPE_VLAN) {
+			hdr_len = sizeof(struct net_eth_vlan_hdr);
+			if (*len < hdr_len) {
+				return 0;
+			}
+
+			type = ntohs(((const struct net_eth_vlan_hdr *)*data)->type);
+		}
+
+		*data += hdr_len;
+		*len -= hdr_len;
+
+		return type;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_DUMMY)
+	/* Dummy interfaces, like the loopback one, carry raw IP packets */
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		if (*len < 1) {
+			return 0;
+		}
+
+		return ((*data)[0] & 0xf0) == 0x60 ? NET_ETH_PTYPE_IPV6 :
+						     NET_ETH_PTYPE_IP;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return 0;
+}
+
+/* Hash the addresses, protocol and, when present, the ports of the
+ * packet. Only the first buffer of the packet is looked at, which holds
+ * the headers for any sane driver. Packets that cannot be parsed get
+ * hash 0 and all go to the first queue.
+ */
+static uint32_t flow_hash(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	uint32_t hash = FLOW_HASH_OFFSET;
+	const uint8_t *data;
+	uint16_t type;
+	size_t len, l4;
+	uint8_t proto;
+
+	if (buf == NULL) {
+		return 0;
+	}
+
+	data = buf->data;
+	len = buf->len;
+	type = flow_l3_type(net_pkt_iface(pkt), &data, &len);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && type == NET_ETH_PTYPE_IP) {
+		const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)data;
+		uint16_t offset;
+
+		if (len < sizeof(*hdr)) {
+			return 0;
+		}
+
+		proto = hdr->proto;
+		hash = flow_hash_update(hash, hdr->src, sizeof(hdr->src));
+		hash = flow_hash_update(hash, hdr->dst, sizeof(hdr->dst));
+
+		/* Only the first fragment has the ports */
+		offset = (hdr->offset[0] << 8) | hdr->offset[1];
+		l4 = offset & (NET_IPV4_FRAGH_OFFSET_MASK | (NET_IPV4_MF << 13)) ?
+			len : (hdr->vhl & 0x0f) * 4U;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && type == NET_ETH_PTYPE_IPV6) {
+		const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)data;
+
+		if (len < sizeof(*hdr)) {
+			return 0;
+		}
+
+		proto = hdr->nexthdr;
+		hash = flow_hash_update(hash, hdr->src, sizeof(hdr->src));
+		hash = flow_hash_update(hash, hdr->dst, sizeof(hdr->dst));
+		l4 = sizeof(*hdr);
+	} else {
+		return 0;
+	}
+
+	hash = flow_hash_update(hash, &proto, sizeof(proto));
+
+	/* Source and destination ports are the first 4 bytes of both
+	 * the TCP and the UDP header.
+	 */
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) && l4 + 4 <= len) {
+		hash = flow_hash_update(hash, data + l4, 4);
+	}
+
+	return hash;
+}
+
+static uint8_t rx_flow_queue(struct net_pkt *pkt)
+{
+	uint32_t hash = net_pkt_rx_hash(pkt);
+
+	if (hash == 0) {
+		hash = flow_hash(pkt);
+		net_pkt_set_rx_hash(pkt, hash);
+	}
+
+	return hash % NET_RX_FLOW_QUEUES;
+}
+#else
+static inline uint8_t rx_flow_queue(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[tc * NET_RX_FLOW_QUEUES +
+				    rx_flow_queue(pkt)].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -255,6 +423,13 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 		}
 
 		net_process_rx_packet(pkt);
+
+		/* Segments merged by TCP GRO are processed once there is
+		 * nothing more to merge them with.
+		 */
+		if (k_fifo_is_empty(fifo)) {
+			net_tcp_gro_flush();
+		}
 	}
 }
 #endif
@@ -354,12 +529,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_RX_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -389,10 +564,25 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (IS_ENABLED(CONFIG_NET_RX_FLOW_STEERING)) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]",
+					 i / NET_RX_FLOW_QUEUES,
+					 i % NET_RX_FLOW_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Spread the flow queues of a traffic class over the CPUs */
+		if (arch_num_cpus() > 1) {
+			(void)k_thread_cpu_pin(tid, (i % NET_RX_FLOW_QUEUES) %
+						    arch_num_cpus());
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <limits.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_core.h>
@@ -32,7 +33,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -125,6 +126,266 @@ static inline struct net_route_entry *net_route_data(struct net_nbr *nbr)
 	return (struct net_route_entry *)nbr->data;
 }
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+/* Path-compressed binary trie indexing the routes by prefix. A node holds
+ * the routes whose prefix is exactly the node prefix. Nodes without routes
+ * are only kept as branching points and always have two children, so the
+ * trie never needs more than two nodes per route.
+ */
+struct net_route_trie_node {
+	struct net_route_trie_node *parent;
+	struct net_route_trie_node *child[2];
+	sys_slist_t routes;
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(route_trie_slab, sizeof(struct net_route_trie_node),
+			 2 * CONFIG_NET_MAX_ROUTES, sizeof(void *));
+
+/* The root is the zero length prefix and is never freed */
+static struct net_route_trie_node route_trie_root;
+
+static inline uint8_t addr_bit(const struct in6_addr *addr, uint8_t bit)
+{
+	return (addr->s6_addr[bit / 8U] >> (7U - (bit % 8U))) & 1U;
+}
+
+/* Return how many leading bits, at most max_len, a and b have in common */
+static uint8_t common_prefix_len(const struct in6_addr *a,
+				 const struct in6_addr *b,
+				 uint8_t max_len)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < sizeof(a->s6_addr) && len < max_len; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24U;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct net_route_trie_node *route_trie_node_alloc(const struct in6_addr *addr,
+							 uint8_t prefix_len)
+{
+	struct net_route_trie_node *node;
+	uint8_t bytes = prefix_len / 8U;
+
+	if (k_mem_slab_alloc(&route_trie_slab, (void **)&node, K_NO_WAIT) < 0) {
+		return NULL;
+	}
+
+	memset(node, 0, sizeof(*node));
+
+	memcpy(node->prefix.s6_addr, addr->s6_addr, bytes);
+	if (prefix_len % 8U) {
+		node->prefix.s6_addr[bytes] = addr->s6_addr[bytes] &
+					      (0xff << (8U - (prefix_len % 8U)));
+	}
+
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void route_trie_link(struct net_route_trie_node *parent,
+			    struct net_route_trie_node *child)
+{
+	parent->child[addr_bit(&child->prefix, parent->prefix_len)] = child;
+	child->parent = parent;
+}
+
+/* Drop nodes that no longer hold routes and are not needed for branching */
+static void route_trie_prune(struct net_route_trie_node *node)
+{
+	while (node != &route_trie_root && sys_slist_is_empty(&node->routes)) {
+		struct net_route_trie_node *parent = node->parent;
+		struct net_route_trie_node *child;
+
+		if (node->child[0] != NULL && node->child[1] != NULL) {
+			break;
+		}
+
+		child = node->child[0] != NULL ? node->child[0] : node->child[1];
+
+		parent->child[addr_bit(&node->prefix, parent->prefix_len)] = child;
+		if (child != NULL) {
+			child->parent = parent;
+		}
+
+		k_mem_slab_free(&route_trie_slab, node);
+
+		if (child != NULL) {
+			/* Parent still has the same number of children */
+			break;
+		}
+
+		node = parent;
+	}
+}
+
+static int route_trie_insert(struct net_route_entry *route)
+{
+	struct net_route_trie_node *node = &route_trie_root;
+
+	while (node->prefix_len < route->prefix_len) {
+		struct net_route_trie_node *child, *new_node;
+		uint8_t len;
+
+		child = node->child[addr_bit(&route->addr, node->prefix_len)];
+		if (child != NULL) {
+			len = common_prefix_len(&route->addr, &child->prefix,
+						MIN(route->prefix_len,
+						    child->prefix_len));
+			if (len == child->prefix_len) {
+				node = child;
+				continue;
+			}
+		} else {
+			len = route->prefix_len;
+		}
+
+		/* Either there is no child yet, or the route prefix diverges
+		 * from the child prefix (or is shorter than it), in which case
+		 * a new node is inserted above the child.
+		 */
+		new_node = route_trie_node_alloc(&route->addr, len);
+		if (new_node == NULL) {
+			route_trie_prune(node);
+			return -ENOMEM;
+		}
+
+		route_trie_link(node, new_node);
+		if (child != NULL) {
+			route_trie_link(new_node, child);
+		}
+
+		node = new_node;
+	}
+
+	sys_slist_append(&node->routes, &route->trie_node);
+	route->trie = node;
+
+	return 0;
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct net_route_trie_node *node = route->trie;
+
+	if (node == NULL) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&node->routes, &route->trie_node);
+	route->trie = NULL;
+
+	route_trie_prune(node);
+}
+
+static struct net_route_entry *route_trie_lookup(struct net_if *iface,
+						 struct in6_addr *dst)
+{
+	struct net_route_trie_node *node = &route_trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[addr_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Direct mapped cache of recent lookup results. Any change to the routing
+ * table flushes it, so an entry is valid as long as its route is set.
+ */
+struct net_route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct net_route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static struct net_route_cache_entry *route_cache_slot(struct net_if *iface,
+						      struct in6_addr *dst)
+{
+	uint32_t hash = dst->s6_addr32[0] ^ dst->s6_addr32[1] ^
+			dst->s6_addr32[2] ^ dst->s6_addr32[3] ^
+			(uint32_t)POINTER_TO_UINT(iface);
+
+	/* Fibonacci hashing spreads the low entropy of the folded address */
+	hash *= 0x9e3779b1U;
+
+	return &route_cache[(hash >> 16) % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       struct in6_addr *dst)
+{
+	struct net_route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	if (entry->route != NULL && entry->iface == iface &&
+	    net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return entry->route;
+	}
+
+	return NULL;
+}
+
+static void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct net_route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	net_ipaddr_copy(&entry->dst, dst);
+	entry->iface = iface;
+	entry->route = route;
+}
+
+static void route_cache_flush(void)
+{
+	memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+static inline struct net_route_entry *route_cache_get(struct net_if *iface,
+						      struct in6_addr *dst)
+{
+	return NULL;
+}
+
+static inline void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+				   struct net_route_entry *route)
+{
+}
+
+static inline void route_cache_flush(void)
+{
+}
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
 struct net_nbr *net_route_get_nbr(struct net_route_entry *route)
 {
 	struct net_nbr *ret = NULL;
@@ -263,19 +524,20 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static struct net_route_entry *route_table_lookup(struct net_if *iface,
+						  struct in6_addr *dst)
 {
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	return route_trie_lookup(iface, dst);
+#else
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +560,25 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+#endif
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_cache_get(iface, dst);
+	if (found == NULL) {
+		found = route_table_lookup(iface, dst);
+		if (found != NULL) {
+			route_cache_put(iface, dst, found);
+		}
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -308,6 +589,33 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 	return found;
 }
 
+/* Find the route having exactly the given prefix */
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct net_nbr *nbr = get_nbr(i);
+		struct net_route_entry *route;
+
+		if (!nbr->ref || nbr->iface != iface) {
+			continue;
+		}
+
+		route = net_route_data(nbr);
+
+		if (route->prefix_len == prefix_len &&
+		    net_ipv6_is_prefix(addr->s6_addr, route->addr.s6_addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
 static inline bool route_preference_is_lower(uint8_t old, uint8_t new)
 {
 	if (new == NET_ROUTE_PREFERENCE_RESERVED || (new & 0xfc) != 0) {
@@ -361,7 +669,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	route = route_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -393,9 +701,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -432,6 +740,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	tmp = get_nexthop_route();
 	if (!tmp) {
 		NET_ERR("No nexthop route available!");
+		nbr_free(nbr);
 		route = NULL;
 		goto exit;
 	}
@@ -439,12 +748,23 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nexthop_route = net_nexthop_data(tmp);
 
 	route = net_route_data(nbr);
+
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	if (route_trie_insert(route) < 0) {
+		NET_ERR("Cannot index route to %s", net_sprint_ipv6_addr(addr));
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
 	route->iface = iface;
 	route->preference = preference;
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -455,6 +775,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	sys_slist_init(&route->nexthop);
 	sys_slist_prepend(&route->nexthop, &nexthop_route->node);
 
+	route_cache_flush();
+
 	net_route_info("Added", route, addr);
 
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
@@ -586,7 +908,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -594,6 +918,12 @@ int net_route_del(struct net_route_entry *route)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	route_trie_remove(route);
+#endif
+
+	route_cache_flush();
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
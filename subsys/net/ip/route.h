@@ -15,6 +15,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_timeout.h>
@@ -38,6 +39,8 @@ struct net_route_nexthop {
 	struct net_nbr *nbr;
 };
 
+struct net_route_trie_node;
+
 /**
  * @brief Route entry to a specific neighbor.
  */
@@ -47,7 +50,7 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
@@ -68,6 +71,14 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	/** Trie node holding this route, NULL if the route is not indexed. */
+	struct net_route_trie_node *trie;
+
+	/** Next route having the same prefix in the trie node. */
+	sys_snode_t trie_node;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/udp.h>
+#include <zephyr/net/socket.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
@@ -32,6 +33,8 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define LAST_ACK_TIMEOUT K_MSEC(LAST_ACK_TIMEOUT_MS)
 #define FIN_TIMEOUT K_MSEC(tcp_max_timeout_ms)
 #define ACK_DELAY K_MSEC(100)
+/* Upper bound of the time TCP_CORK or MSG_MORE hold back a partial segment */
+#define TCP_CORK_TIMEOUT_MS 200
 #define ZWP_MAX_DELAY_MS 120000
 #define DUPLICATE_ACK_RETRANSMIT_TRHESHOLD 3
 
@@ -44,6 +47,8 @@ static int tcp_rx_window =
 #else
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 	(CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3;
+#elif defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+	NET_BUF_MULTI_DATA_POOL_SIZE / 3;
 #else
 	CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
@@ -54,6 +59,8 @@ static int tcp_tx_window =
 #else
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 	(CONFIG_NET_BUF_TX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3;
+#elif defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+	NET_BUF_MULTI_DATA_POOL_SIZE / 3;
 #else
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
@@ -792,6 +799,7 @@ static void tcp_conn_release(struct k_work *work)
 	tcp_send_queue_flush(conn);
 
 	(void)k_work_cancel_delayable(&conn->send_data_timer);
+	(void)k_work_cancel_delayable(&conn->cork_timer);
 	tcp_pkt_unref(conn->send_data);
 
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
@@ -1531,6 +1539,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
 	size_t alloc_len = sizeof(struct tcphdr);
+	size_t data_len = data ? net_pkt_get_len(data) : 0;
 	struct net_pkt *pkt;
 	int ret = 0;
 
@@ -1548,6 +1557,9 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+
+		net_pkt_set_data_chksum(pkt, net_pkt_data_chksum(data),
+					net_pkt_data_chksum_len(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1576,6 +1588,13 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
+	if (data_len > conn_mss(conn)) {
+		/* Segmented right before the driver, see
+		 * net_tcp_gso_prepare_for_send()
+		 */
+		net_pkt_set_gso_size(pkt, conn_mss(conn));
+	}
+
 	if (tcp_send_cb) {
 		ret = tcp_send_cb(pkt);
 		goto out;
@@ -1620,9 +1639,13 @@ static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 	return ret;
 }
 
+/* The data is checksummed while it is copied, see net_calc_chksum() */
 static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 			size_t len)
 {
+	uint16_t sum = 0U;
+	int ret;
+
 	net_pkt_cursor_init(to);
 	net_pkt_cursor_init(from);
 
@@ -1631,7 +1654,16 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 		net_pkt_skip(from, pos);
 	}
 
-	return net_pkt_copy(to, from, len);
+	if (!net_if_need_calc_tx_checksum(net_pkt_iface(to))) {
+		return net_pkt_copy(to, from, len);
+	}
+
+	ret = net_pkt_copy_chksum(to, from, len, &sum);
+	if (ret == 0) {
+		net_pkt_set_data_chksum(to, sum, len);
+	}
+
+	return ret;
 }
 
 static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
@@ -1721,13 +1753,27 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+/* Maximum amount of data sent in one packet. With GSO the packet can
+ * span several segments.
+ */
+static int tcp_send_len_max(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_GSO)
+	return MAX(mss, (CONFIG_NET_TCP_GSO_MAX_SIZE / mss) * mss);
+#else
+	return mss;
+#endif
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), tcp_send_len_max(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1777,29 +1823,72 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+/* Decide whether a trailing segment smaller than the MSS is held back.
+ * TCP_CORK and MSG_MORE hold it until more data is queued or the cork
+ * timer fires. Otherwise Nagle's algorithm, or autocork when TCP_NODELAY
+ * is set, hold it while earlier data is unacknowledged.
+ */
+static bool tcp_hold_partial(struct tcp *conn)
+{
+	if (conn->tx_push) {
+		return false;
+	}
+
+	if (conn->tcp_cork || conn->tx_more) {
+		if (!k_work_delayable_is_pending(&conn->cork_timer)) {
+			k_work_reschedule_for_queue(&tcp_work_q, &conn->cork_timer,
+						    K_MSEC(TCP_CORK_TIMEOUT_MS));
+		}
+
+		return true;
+	}
+
+	if (conn->unacked_len == 0) {
+		return false;
+	}
+
+	/* Implement Nagle's algorithm */
+	if (conn->tcp_nodelay == false) {
+		return true;
+	}
+
+#if defined(CONFIG_NET_TCP_AUTOCORK)
+	/* The ACK of the data in flight flushes the held segment, the timer
+	 * only bounds the delay if that ACK is late.
+	 */
+	if (!k_work_delayable_is_pending(&conn->cork_timer)) {
+		k_work_reschedule_for_queue(&tcp_work_q, &conn->cork_timer,
+					    K_MSEC(CONFIG_NET_TCP_AUTOCORK_TIMEOUT));
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
 {
 	int ret = 0;
 	bool subscribe = false;
+	bool held = false;
 
 	if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 		goto out;
 	}
 
 	while (tcp_unsent_len(conn) > 0) {
-		/* Implement Nagle's algorithm */
-		if ((conn->tcp_nodelay == false) && (conn->unacked_len > 0)) {
-			/* If there is already pending data */
-			if (tcp_unsent_len(conn) < conn_mss(conn)) {
-				/* The number of bytes to be transmitted is less than an MSS,
-				 * skip transmission for now.
-				 * Wait for more data to be transmitted or all pending data
-				 * being acknowledged.
-				 */
-				break;
-			}
+		if (tcp_unsent_len(conn) < conn_mss(conn) &&
+		    tcp_hold_partial(conn)) {
+			/* The number of bytes to be transmitted is less than an MSS,
+			 * skip transmission for now.
+			 * Wait for more data to be transmitted, all pending data
+			 * being acknowledged or the cork timer.
+			 */
+			held = true;
+			break;
 		}
 
 		ret = tcp_send_data(conn);
@@ -1808,7 +1897,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 		}
 	}
 
-	if (conn->send_data_total) {
+	/* Data held back by TCP_CORK or MSG_MORE while nothing is in flight
+	 * is sent by the cork timer, there is nothing to retransmit yet.
+	 */
+	if (conn->send_data_total && (conn->unacked_len > 0 || !held)) {
 		subscribe = true;
 	}
 
@@ -1825,6 +1917,61 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+static void tcp_cork_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, cork_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	NET_DBG("conn: %p push %d bytes", conn, tcp_unsent_len(conn));
+
+	conn->tx_push = true;
+	(void)tcp_send_queued_data(conn);
+	conn->tx_push = false;
+
+	k_mutex_unlock(&conn->lock);
+}
+
+static int set_tcp_cork(struct tcp *conn, const void *value, size_t len)
+{
+	int cork_int;
+
+	if (len != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	cork_int = *(int *)value;
+
+	if ((cork_int < 0) || (cork_int > 1)) {
+		return -EINVAL;
+	}
+
+	conn->tcp_cork = (bool)cork_int;
+
+	/* Uncorking sends out whatever was held back */
+	if (!conn->tcp_cork && tcp_unsent_len(conn) > 0) {
+		(void)k_work_cancel_delayable(&conn->cork_timer);
+		conn->tx_push = true;
+		(void)tcp_send_queued_data(conn);
+		conn->tx_push = false;
+	}
+
+	return 0;
+}
+
+static int get_tcp_cork(struct tcp *conn, void *value, size_t *len)
+{
+	int cork_int = (int)conn->tcp_cork;
+
+	*((int *)value) = cork_int;
+
+	if (len) {
+		*len = sizeof(int);
+	}
+	return 0;
+}
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -2115,6 +2262,9 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
 	conn->send_win = conn->send_win_max;
 	conn->tcp_nodelay = false;
+	conn->tcp_cork = false;
+	conn->tx_more = false;
+	conn->tx_push = false;
 	conn->addr_ref_done = false;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	conn->dup_ack_cnt = 0;
@@ -2140,6 +2290,7 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+	k_work_init_delayable(&conn->cork_timer, tcp_cork_timeout);
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
 
@@ -2221,6 +2372,320 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* In-order data segments of a connection are merged into the first held
+ * segment while more packets are waiting in the RX queue. The merged packet
+ * is passed to tcp_in() when the queue drains, see net_tcp_gro_flush().
+ * With RX flow steering there are several RX queue threads, and each one
+ * only flushes the flows it holds itself, so that a thread does not pass
+ * on segments held by another queue ahead of the packets still waiting in
+ * that queue.
+ *
+ * A flushed flow stays reserved for its connection until the merged packet
+ * has been passed to tcp_in(), and other threads receiving data for the
+ * connection wait for that, so that the data cannot be reordered.
+ */
+struct tcp_gro_flow {
+	struct tcp *conn;
+	struct net_pkt *pkt;
+	/* RX thread which held the packet */
+	k_tid_t holder;
+	/* Thread delivering the flushed packet, NULL while it is held */
+	k_tid_t owner;
+	uint32_t next_seq;
+	uint8_t segs;
+	uint8_t budget;
+};
+
+static struct tcp_gro_flow tcp_gro_flows[CONFIG_NET_TCP_GRO_MAX_FLOWS];
+static K_MUTEX_DEFINE(tcp_gro_lock);
+static K_CONDVAR_DEFINE(tcp_gro_done);
+static atomic_t tcp_gro_held;
+
+static void tcp_gro_deliver(struct net_pkt *pkt)
+{
+	struct tcp *conn;
+
+	/* The connection might have gone away while the packet was held */
+	conn = tcp_conn_search(pkt);
+	if (!conn || tcp_in(conn, pkt) != NET_OK) {
+		net_pkt_unref(pkt);
+	}
+}
+
+/* Called with tcp_gro_lock held, the flow stays reserved until
+ * tcp_gro_release().
+ */
+static struct net_pkt *tcp_gro_detach(struct tcp_gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+
+	flow->pkt = NULL;
+	flow->owner = k_current_get();
+
+	return pkt;
+}
+
+static void tcp_gro_release(struct tcp_gro_flow **flows, int count)
+{
+	if (count == 0) {
+		return;
+	}
+
+	k_mutex_lock(&tcp_gro_lock, K_FOREVER);
+
+	for (int i = 0; i < count; i++) {
+		flows[i]->conn = NULL;
+		flows[i]->owner = NULL;
+		atomic_dec(&tcp_gro_held);
+	}
+
+	k_condvar_broadcast(&tcp_gro_done);
+	k_mutex_unlock(&tcp_gro_lock);
+}
+
+/* Upper bound of the wait for another thread delivering the same connection */
+#define TCP_GRO_DELIVERY_TIMEOUT K_MSEC(100)
+
+/* Called with tcp_gro_lock held. Waits until no other thread is delivering
+ * data of the connection. Returns false if the current thread is doing that
+ * itself, i.e. TCP input processing looped the packet back to us, or if the
+ * data cannot be serialised without risking a deadlock. The packet is then
+ * passed to tcp_in() directly, TCP copes with the possible reordering.
+ */
+static bool tcp_gro_wait_delivered(struct tcp *conn)
+{
+	k_timepoint_t end = sys_timepoint_calc(TCP_GRO_DELIVERY_TIMEOUT);
+	bool delivering_other;
+	bool delivering;
+
+	while (true) {
+		delivering_other = false;
+		delivering = false;
+
+		ARRAY_FOR_EACH(tcp_gro_flows, i) {
+			struct tcp_gro_flow *flow = &tcp_gro_flows[i];
+
+			if (flow->owner == k_current_get()) {
+				if (flow->conn == conn) {
+					return false;
+				}
+
+				delivering_other = true;
+				continue;
+			}
+
+			if (flow->conn == conn && flow->owner != NULL) {
+				delivering = true;
+			}
+		}
+
+		if (!delivering) {
+			break;
+		}
+
+		/* The owner might in turn be waiting for the flow we are
+		 * delivering, e.g. with two connections looped back to each
+		 * other, so do not block then.
+		 */
+		if (delivering_other) {
+			return false;
+		}
+
+		if (k_condvar_wait(&tcp_gro_done, &tcp_gro_lock,
+				   sys_timepoint_timeout(end)) != 0) {
+			NET_DBG("conn: %p GRO delivery wait timed out", conn);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Only plain data segments without options are merged */
+static bool tcp_gro_mergeable(struct tcphdr *th, size_t len)
+{
+	return len > 0 && th_off(th) == 5 &&
+		(th_flags(th) == ACK || th_flags(th) == (PSH | ACK));
+}
+
+static bool tcp_gro_merge(struct tcp_gro_flow *flow, struct net_pkt *pkt,
+			  struct tcphdr *th, size_t len)
+{
+	struct tcphdr *held_th;
+
+	if (th_seq(th) != flow->next_seq ||
+	    flow->segs >= CONFIG_NET_TCP_GRO_MAX_SEGS) {
+		return false;
+	}
+
+	held_th = th_get(flow->pkt);
+	if (!held_th || net_tcp_seq_cmp(th_ack(th), th_ack(held_th)) < 0) {
+		return false;
+	}
+
+	/* The newest segment carries the latest ACK and window */
+	UNALIGNED_PUT(UNALIGNED_GET(&th->th_ack), &held_th->th_ack);
+	UNALIGNED_PUT(UNALIGNED_GET(&th->th_win), &held_th->th_win);
+	UNALIGNED_PUT(th_flags(held_th) | th_flags(th), &held_th->th_flags);
+
+	/* Strip the headers, only the payload is appended */
+	if (tcp_pkt_pull(pkt, net_pkt_get_len(pkt) - len) < 0) {
+		return false;
+	}
+
+	net_pkt_append_buffer(flow->pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	flow->next_seq += len;
+	flow->segs++;
+
+	return true;
+}
+
+/* Returns true if the packet was held, merged or delivered, i.e. consumed. */
+static bool tcp_gro_receive(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcp_gro_flow *flushed[CONFIG_NET_TCP_GRO_MAX_FLOWS];
+	struct net_pkt *flush[CONFIG_NET_TCP_GRO_MAX_FLOWS];
+	struct tcp_gro_flow *free_flow = NULL;
+	struct tcphdr *th = th_get(pkt);
+	size_t len = th ? tcp_data_len(pkt) : 0;
+	bool mergeable = th && tcp_gro_mergeable(th, len);
+	uint8_t flags = th ? th_flags(th) : 0U;
+	bool consumed = false;
+	bool found = false;
+	int count = 0;
+
+	if (!mergeable && atomic_get(&tcp_gro_held) == 0) {
+		return false;
+	}
+
+	/* Segments already coalesced by the hardware */
+	if (!net_if_need_tcp_coalescing(net_pkt_iface(pkt))) {
+		return false;
+	}
+
+	k_mutex_lock(&tcp_gro_lock, K_FOREVER);
+
+	if (!tcp_gro_wait_delivered(conn)) {
+		k_mutex_unlock(&tcp_gro_lock);
+		return false;
+	}
+
+	ARRAY_FOR_EACH(tcp_gro_flows, i) {
+		struct tcp_gro_flow *flow = &tcp_gro_flows[i];
+
+		if (!flow->pkt) {
+			if (!flow->conn) {
+				free_flow = free_flow ? free_flow : flow;
+			}
+
+			continue;
+		}
+
+		if (flow->conn == conn) {
+			found = true;
+
+			if (mergeable && tcp_gro_merge(flow, pkt, th, len)) {
+				/* pkt and th are gone now */
+				consumed = true;
+
+				if (!(flags & PSH)) {
+					continue;
+				}
+			}
+
+			/* Anything else for this connection must not
+			 * overtake the held data.
+			 */
+			flushed[count] = flow;
+			flush[count++] = tcp_gro_detach(flow);
+			continue;
+		}
+
+		/* Do not hold other connections' data for too long */
+		if (flow->holder == k_current_get() && --flow->budget == 0U) {
+			flushed[count] = flow;
+			flush[count++] = tcp_gro_detach(flow);
+		}
+	}
+
+	/* The first segment is held only if there is nothing to flush for
+	 * the connection, so that the held data cannot be reordered.
+	 */
+	if (!consumed && !found && mergeable && free_flow && !(flags & PSH)) {
+		free_flow->conn = conn;
+		free_flow->pkt = pkt;
+		free_flow->holder = k_current_get();
+		free_flow->next_seq = th_seq(th) + len;
+		free_flow->segs = 1U;
+		free_flow->budget = CONFIG_NET_TCP_GRO_MAX_SEGS;
+		atomic_inc(&tcp_gro_held);
+		consumed = true;
+	}
+
+	k_mutex_unlock(&tcp_gro_lock);
+
+	for (int i = 0; i < count; i++) {
+		tcp_gro_deliver(flush[i]);
+	}
+
+	/* The packet follows the flushed data while the flow is still
+	 * reserved.
+	 */
+	if (!consumed && found) {
+		if (tcp_in(conn, pkt) != NET_OK) {
+			net_pkt_unref(pkt);
+		}
+
+		consumed = true;
+	}
+
+	tcp_gro_release(flushed, count);
+
+	return consumed;
+}
+
+void net_tcp_gro_flush(void)
+{
+	struct tcp_gro_flow *flushed[CONFIG_NET_TCP_GRO_MAX_FLOWS];
+	struct net_pkt *flush[CONFIG_NET_TCP_GRO_MAX_FLOWS];
+	int count = 0;
+
+	if (atomic_get(&tcp_gro_held) == 0) {
+		return;
+	}
+
+	k_mutex_lock(&tcp_gro_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH(tcp_gro_flows, i) {
+		if (tcp_gro_flows[i].pkt &&
+		    tcp_gro_flows[i].holder == k_current_get()) {
+			flushed[count] = &tcp_gro_flows[i];
+			flush[count++] = tcp_gro_detach(&tcp_gro_flows[i]);
+		}
+	}
+
+	k_mutex_unlock(&tcp_gro_lock);
+
+	for (int i = 0; i < count; i++) {
+		tcp_gro_deliver(flush[i]);
+	}
+
+	tcp_gro_release(flushed, count);
+}
+#else
+static inline bool tcp_gro_receive(struct tcp *conn, struct net_pkt *pkt)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 struct net_pkt *pkt,
 				 union net_ip_header *ip,
@@ -2254,6 +2719,10 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	}
 in:
 	if (conn) {
+		if (tcp_gro_receive(conn, pkt)) {
+			return NET_OK;
+		}
+
 		verdict = tcp_in(conn, pkt);
 	} else {
 		net_tcp_reply_rst(pkt);
@@ -3614,6 +4083,16 @@ int net_tcp_put(struct net_context *context)
 
 	if (conn && (conn->state == TCP_ESTABLISHED ||
 		     conn->state == TCP_SYN_RECEIVED)) {
+		/* Flush data held back by cork or autocork first. */
+		conn->tcp_cork = false;
+		conn->tx_more = false;
+		if (tcp_unsent_len(conn) > 0) {
+			(void)k_work_cancel_delayable(&conn->cork_timer);
+			conn->tx_push = true;
+			(void)tcp_send_queued_data(conn);
+			conn->tx_push = false;
+		}
+
 		/* Send all remaining data if possible. */
 		if (conn->send_data_total > 0) {
 			NET_DBG("conn %p pending %zu bytes", conn,
@@ -3683,8 +4162,34 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+/* Account freshly queued data and kick the transmission, must be called
+ * with the connection lock held.
+ */
+static int tcp_queue_commit(struct tcp *conn, size_t queued_len)
+{
+	int ret;
+
+	conn->send_data_total += queued_len;
+
+	/* Successfully queued data for transmission. Even if there's a transmit
+	 * failure now (out-of-buf case), it can be ignored for now, retransmit
+	 * timer will take care of queued data retransmission.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+		return ret;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	return queued_len;
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg)
+		  const struct msghdr *msg, int flags)
 {
 	struct tcp *conn = context->tcp;
 	size_t queued_len = 0;
@@ -3751,23 +4256,113 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		queued_len = len;
 	}
 
-	conn->send_data_total += queued_len;
+	conn->tx_more = (flags & ZSOCK_MSG_MORE) != 0;
 
-	/* Successfully queued data for transmission. Even if there's a transmit
-	 * failure now (out-of-buf case), it can be ignored for now, retransmit
-	 * timer will take care of queued data retransmission.
-	 */
-	ret = tcp_send_queued_data(conn);
-	if (ret < 0 && ret != -ENOBUFS) {
-		tcp_conn_close(conn, ret);
-		goto out;
+	ret = tcp_queue_commit(conn, queued_len);
+out:
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t fill, void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	struct net_buf *buf, *last;
+	struct net_pkt *pkt;
+	size_t queued_len = 0;
+	int ret = 0;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
 	}
 
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
 	if (tcp_window_full(conn)) {
-		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		k_mutex_unlock(&conn->lock);
+		return -EAGAIN;
+	}
+
+	len = MIN(conn->send_win - conn->send_data_total, len);
+
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (pkt != NULL &&
+	    net_pkt_alloc_buffer_raw(pkt, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+		tcp_pkt_unref(pkt);
+		pkt = NULL;
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	if (pkt == NULL) {
+		return -ENOBUFS;
 	}
 
-	ret = queued_len;
+	/* The producer can be slow, like a file system read, so the buffers
+	 * are filled without holding the connection lock, which would block
+	 * the timers and the ACK processing of the connection. The producer
+	 * writes straight into the buffers, which are then appended to the
+	 * send queue, so the data is not staged in a bounce buffer.
+	 */
+	buf = pkt->buffer;
+
+	while (buf != NULL && queued_len < len) {
+		size_t room = MIN(len - queued_len, net_buf_tailroom(buf));
+
+		if (room == 0) {
+			buf = buf->frags;
+			continue;
+		}
+
+		ret = fill(net_buf_tail(buf), room, user_data);
+		if (ret < 0) {
+			break;
+		}
+
+		net_buf_add(buf, ret);
+		queued_len += ret;
+
+		if (ret < room) {
+			break;
+		}
+
+		buf = buf->frags;
+	}
+
+	if (queued_len == 0) {
+		tcp_pkt_unref(pkt);
+		return ret;
+	}
+
+	/* Drop the buffers the producer did not fill */
+	last = pkt->buffer;
+	while (last->frags != NULL) {
+		if (last->frags->len == 0) {
+			net_buf_unref(last->frags);
+			last->frags = NULL;
+			break;
+		}
+
+		last = last->frags;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_ESTABLISHED) {
+		tcp_pkt_unref(pkt);
+		ret = -ENOTCONN;
+		goto out;
+	}
+
+	net_pkt_append_buffer(conn->send_data, pkt->buffer);
+	pkt->buffer = NULL;
+	tcp_pkt_unref(pkt);
+
+	conn->tx_more = false;
+
+	ret = tcp_queue_commit(conn, queued_len);
 out:
 	k_mutex_unlock(&conn->lock);
 
@@ -4059,6 +4654,149 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static int tcp_gso_send_segment(struct net_pkt *pkt, size_t hdr_len,
+				size_t offset, size_t len, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	uint16_t sum = 0U;
+	int ret = -ENOBUFS;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					net_pkt_family(pkt), IPPROTO_TCP,
+					TCP_PKT_ALLOC_TIMEOUT);
+	if (!seg) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	/* Headers of the original packet, then the payload of this segment */
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset)) {
+		goto fail;
+	}
+
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(seg))) {
+		if (net_pkt_copy_chksum(seg, pkt, len, &sum)) {
+			goto fail;
+		}
+
+		net_pkt_set_data_chksum(seg, sum, len);
+	} else if (net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+		NET_IPV4_HDR(seg)->chksum = 0U;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	net_pkt_set_overwrite(seg, true);
+	net_pkt_cursor_init(seg);
+
+	if (net_pkt_skip(seg, ip_len)) {
+		goto fail;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!th) {
+		goto fail;
+	}
+
+	UNALIGNED_PUT(htonl(th_seq(th) + offset), &th->th_seq);
+
+	/* PSH and FIN only belong to the last segment */
+	if (!last) {
+		UNALIGNED_PUT(th_flags(th) & ~(PSH | FIN), &th->th_flags);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		goto fail;
+	}
+
+	ret = tcp_finalize_pkt(seg);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (last) {
+		net_pkt_set_context(seg, net_pkt_context(pkt));
+	}
+
+	ret = net_send_data(seg);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return 0;
+
+fail:
+	net_pkt_unref(seg);
+
+	return ret;
+}
+
+enum net_verdict net_tcp_gso_prepare_for_send(struct net_pkt *pkt)
+{
+	uint16_t gso_size = net_pkt_gso_size(pkt);
+	size_t hdr_len, data_len, offset;
+	struct tcphdr *th;
+	int ret;
+
+	if (gso_size == 0U || !net_if_need_tcp_segmentation(net_pkt_iface(pkt))) {
+		return NET_OK;
+	}
+
+	th = th_get(pkt);
+	if (!th) {
+		return NET_DROP;
+	}
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		  th_off(th) * 4;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (offset = 0; offset < data_len; offset += gso_size) {
+		size_t len = MIN(gso_size, data_len - offset);
+
+		ret = tcp_gso_send_segment(pkt, hdr_len, offset, len,
+					   offset + len >= data_len);
+		if (ret < 0) {
+			NET_DBG("Cannot send TCP segment (%d)", ret);
+
+			if (offset == 0) {
+				return NET_DROP;
+			}
+
+			/* The segments sent so far are on their way, the
+			 * rest of the data is sent again by the TCP
+			 * retransmission logic once they are acknowledged.
+			 */
+			break;
+		}
+	}
+
+	/* We need to unref here because we simulate the packet being sent. */
+	net_pkt_unref(pkt);
+
+	return NET_CONTINUE;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -4427,6 +5165,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CORK:
+		ret = set_tcp_cork(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4464,6 +5205,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CORK:
+		ret = get_tcp_cork(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CORK = 6,
 };
 
 /**
@@ -293,20 +294,65 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
  * @param data		Pointer to the data
  * @param len		Number of bytes
  * @param msg		Data for a vector array operation
+ * @param flags		ZSOCK_MSG_* send flags, ZSOCK_MSG_MORE holds back
+ *			a trailing partial segment
  *
  * @return 0 if ok, < 0 if error
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg);
+		  const struct msghdr *msg, int flags);
 #else
 static inline int net_tcp_queue(struct net_context *context, const void *data,
-				size_t len, const struct msghdr *msg)
+				size_t len, const struct msghdr *msg, int flags)
 {
 	ARG_UNUSED(context);
 	ARG_UNUSED(data);
 	ARG_UNUSED(len);
 	ARG_UNUSED(msg);
+	ARG_UNUSED(flags);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
+/**
+ * @brief Callback filling TCP send buffer space with data
+ *
+ * @param dst		Buffer space to fill
+ * @param len		Number of bytes available at @p dst
+ * @param user_data	User data given to net_tcp_queue_fill()
+ *
+ * @return Number of bytes written, less than @p len when the source runs
+ *         out of data, or < 0 on error.
+ */
+typedef int (*net_tcp_fill_cb_t)(uint8_t *dst, size_t len, void *user_data);
+
+/**
+ * @brief Enqueue data for transmission, writing it in place
+ *
+ * Works like net_tcp_queue() but instead of copying from a caller supplied
+ * buffer, the send buffer space is handed to @p fill which writes the data
+ * straight into the network buffers.
+ *
+ * @param context	Network context
+ * @param len		Maximum number of bytes to queue
+ * @param fill		Callback producing the data
+ * @param user_data	User data passed to @p fill
+ *
+ * @return Number of bytes queued, 0 if @p fill had no data, < 0 if error
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t fill, void *user_data);
+#else
+static inline int net_tcp_queue_fill(struct net_context *context, size_t len,
+				     net_tcp_fill_cb_t fill, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(len);
+	ARG_UNUSED(fill);
+	ARG_UNUSED(user_data);
 
 	return -EPROTONOSUPPORT;
 }
@@ -448,6 +494,44 @@ static inline void net_tcp_reply_rst(struct net_pkt *pkt)
 }
 #endif
 
+/**
+ * @brief Segment a TCP GSO packet before it is passed to the driver.
+ *
+ * If the packet carries more than one segment worth of data and the
+ * network interface cannot do TCP segmentation offload, the packet is
+ * split into segments that are sent separately.
+ *
+ * @param pkt TCP packet to send
+ *
+ * @return NET_OK if the packet can be sent as is, NET_CONTINUE if the
+ *         packet was segmented and consumed, NET_DROP if no segment could
+ *         be sent. If only some segments were sent, the packet is consumed
+ *         and the rest of the data is retransmitted by TCP.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+enum net_verdict net_tcp_gso_prepare_for_send(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_tcp_gso_prepare_for_send(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_OK;
+}
+#endif
+
+/**
+ * @brief Pass the TCP segments merged by GRO to TCP input processing.
+ *
+ * Called by the RX path when there are no more packets waiting to be
+ * processed. Only the segments held by the calling thread are flushed, the
+ * other RX queues flush their own when they drain.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(void);
+#else
+#define net_tcp_gro_flush(...)
+#endif
+
 /**
  * @brief Get the TCP connection endpoint information.
  *
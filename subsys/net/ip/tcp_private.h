@@ -282,6 +282,7 @@ struct tcp { /* TCP connection */
 	struct k_work_delayable timewait_timer;
 	struct k_work_delayable persist_timer;
 	struct k_work_delayable ack_timer;
+	struct k_work_delayable cork_timer;
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
@@ -336,6 +337,9 @@ struct tcp { /* TCP connection */
 	bool keep_alive : 1;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
+	bool tcp_cork : 1;
+	bool tx_more : 1;
+	bool tx_push : 1;
 	bool addr_ref_done : 1;
 };
 
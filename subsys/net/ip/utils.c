@@ -26,6 +26,8 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/socketcan.h>
 
+#include "net_private.h"
+
 char *net_sprint_addr(sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -533,6 +535,183 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+/* Bulk summing kernels. Each one adds as many bytes as it can from a 4 byte
+ * aligned buffer into the 64-bit accumulator and returns the number of bytes
+ * consumed, which is always a multiple of 4 so that the 32-bit word loop of
+ * calc_chksum() can carry on from there. The partial results are folded to 32
+ * bits before they are added, so the accumulator can never overflow.
+ */
+static inline uint64_t chksum_fold64(uint64_t sum)
+{
+	sum = (sum & 0xffffffffULL) + (sum >> 32);
+	sum = (sum & 0xffffffffULL) + (sum >> 32);
+
+	return sum;
+}
+
+#if defined(CONFIG_NET_CHKSUM_ARCH_OPTIMIZED) && defined(__AVX2__)
+#include <immintrin.h>
+
+static size_t chksum_bulk(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i acc = _mm256_setzero_si256();
+	uint64_t lanes[4];
+	size_t done = 0;
+
+	while (len - done >= 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(data + done));
+
+		/* Widen the 32-bit words to 64 bits, no carries are lost */
+		acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(v, zero));
+		acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(v, zero));
+		done += 32;
+	}
+
+	_mm256_storeu_si256((__m256i *)lanes, acc);
+
+	*sum += chksum_fold64(lanes[0]) + chksum_fold64(lanes[1]) +
+		chksum_fold64(lanes[2]) + chksum_fold64(lanes[3]);
+
+	return done;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH_OPTIMIZED) && defined(__SSE2__)
+#include <emmintrin.h>
+
+static size_t chksum_bulk(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc = _mm_setzero_si128();
+	uint64_t lanes[2];
+	size_t done = 0;
+
+	while (len - done >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + done));
+
+		/* Widen the 32-bit words to 64 bits, no carries are lost */
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, zero));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, zero));
+		done += 16;
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, acc);
+
+	*sum += chksum_fold64(lanes[0]) + chksum_fold64(lanes[1]);
+
+	return done;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH_OPTIMIZED) && defined(__ARM_FEATURE_MVE) && \
+	(__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+
+static size_t chksum_bulk(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	uint64_t acc = 0;
+	size_t done = 0;
+
+	while (len - done >= 16) {
+		uint32x4_t v = vld1q_u32((const uint32_t *)(data + done));
+
+		/* Widening add across the vector into the 64-bit accumulator */
+		acc = vaddlvaq_u32(acc, v);
+		done += 16;
+	}
+
+	*sum += chksum_fold64(acc);
+
+	return done;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH_OPTIMIZED) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+static size_t chksum_bulk(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	uint64x2_t acc = vdupq_n_u64(0);
+	size_t done = 0;
+
+	while (len - done >= 16) {
+		uint32x4_t v = vld1q_u32((const uint32_t *)(data + done));
+
+		/* Pairwise widening add of the 32-bit words */
+		acc = vpadalq_u32(acc, v);
+		done += 16;
+	}
+
+	*sum += chksum_fold64(vgetq_lane_u64(acc, 0)) +
+		chksum_fold64(vgetq_lane_u64(acc, 1));
+
+	return done;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH_OPTIMIZED) && defined(CONFIG_64BIT)
+
+static size_t chksum_bulk(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	const uint64_t *p;
+	uint64_t acc = 0;
+	uint64_t carry = 0;
+	size_t done = 0;
+
+	/* 64-bit loads need 8 byte alignment on some architectures */
+	if (((uintptr_t)data & 0x04) != 0) {
+		if (len < sizeof(uint32_t)) {
+			return 0;
+		}
+
+		*sum += *((const uint32_t *)data);
+		done = sizeof(uint32_t);
+	}
+
+	p = (const uint64_t *)(data + done);
+
+	/* One's complement addition of 64-bit words, the carries are
+	 * collected separately and added back at the end.
+	 */
+	while (len - done >= sizeof(uint64_t) * 4) {
+		uint64_t w0 = p[0], w1 = p[1], w2 = p[2], w3 = p[3];
+
+		acc += w0;
+		carry += (acc < w0);
+		acc += w1;
+		carry += (acc < w1);
+		acc += w2;
+		carry += (acc < w2);
+		acc += w3;
+		carry += (acc < w3);
+
+		p += 4;
+		done += sizeof(uint64_t) * 4;
+	}
+
+	while (len - done >= sizeof(uint64_t)) {
+		acc += *p;
+		carry += (acc < *p);
+
+		p++;
+		done += sizeof(uint64_t);
+	}
+
+	*sum += chksum_fold64(acc) + carry;
+
+	return done;
+}
+
+#else
+
+static inline size_t chksum_bulk(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(sum);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return 0;
+}
+
+#endif
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -546,6 +725,7 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	uint32_t *p;
 	size_t i = 0;
 	size_t pending = len;
+	size_t done;
 	int odd_start = ((uintptr_t)data & 0x01);
 
 	/* Sum in is in host endiannes, working order endiannes is both dependent on endianness
@@ -568,6 +748,12 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+	/* Let the architecture specific kernel do the bulk of the work */
+	done = chksum_bulk(&sum, data, pending);
+	data += done;
+	pending -= done;
+
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -610,6 +796,39 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+/* Copy in chunks that stay hot in the L1 cache, so that the checksum pass
+ * reads the data the copy just wrote instead of going back to memory.
+ */
+#define CHKSUM_COPY_CHUNK 256
+
+uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src,
+			  size_t len)
+{
+	uint16_t sum = sum_in;
+	size_t copied = 0;
+
+	while (copied < len) {
+		size_t chunk = MIN(len - copied, CHKSUM_COPY_CHUNK);
+		uint16_t part;
+
+		memcpy(dst + copied, src + copied, chunk);
+
+		/* CHKSUM_COPY_CHUNK is even, so every chunk but the last one
+		 * starts at an even offset of the checksummed data.
+		 */
+		part = calc_chksum(0, dst + copied, chunk);
+
+		sum += part;
+		if (sum < part) {
+			sum++;
+		}
+
+		copied += chunk;
+	}
+
+	return sum;
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
@@ -648,6 +867,43 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 }
 
 #if defined(CONFIG_NET_IP)
+/* If the sum of the TCP or UDP payload was computed when it was copied
+ * into the packet, only checksum the transport header. The cursor is at
+ * the start of the transport header.
+ */
+static bool pkt_calc_chksum_hdr(struct net_pkt *pkt, uint8_t proto,
+				uint16_t *sum)
+{
+	size_t data_len = net_pkt_data_chksum_len(pkt);
+	struct net_pkt_cursor backup;
+	/* Largest TCP header */
+	uint8_t hdr[15 * 4];
+	size_t hdr_len;
+
+	if (data_len == 0U || (proto != IPPROTO_TCP && proto != IPPROTO_UDP)) {
+		return false;
+	}
+
+	hdr_len = net_pkt_remaining_data(pkt);
+	if (hdr_len < data_len || hdr_len - data_len > sizeof(hdr)) {
+		return false;
+	}
+
+	hdr_len -= data_len;
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	if (net_pkt_read(pkt, hdr, hdr_len) < 0) {
+		net_pkt_cursor_restore(pkt, &backup);
+		return false;
+	}
+
+	*sum = calc_chksum(*sum, hdr, hdr_len);
+	*sum = calc_chksum_add(*sum, net_pkt_data_chksum(pkt), hdr_len);
+
+	return true;
+}
+
 uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 {
 	size_t len = 0U;
@@ -685,7 +941,9 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	if (!pkt_calc_chksum_hdr(pkt, proto, &sum)) {
+		sum = pkt_calc_chksum(pkt, sum);
+	}
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
@@ -10,6 +10,7 @@
 #if defined(CONFIG_NET_ARP) && defined(CONFIG_NET_NATIVE)
 
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 #include <zephyr/net/ethernet.h>
 
 #ifdef __cplusplus
@@ -53,7 +54,8 @@ int net_arp_clear_pending(struct net_if *iface,
 				struct in_addr *dst);
 
 struct arp_entry {
-	sys_snode_t node;
+	sys_dnode_t node;
+	sys_snode_t hash_node;
 	uint32_t req_start;
 	struct net_if *iface;
 	struct in_addr ip;
@@ -40,6 +40,9 @@ NET_PKT_SLAB_DEFINE(capture_pkts, CONFIG_NET_CAPTURE_PKT_COUNT);
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 NET_BUF_POOL_FIXED_DEFINE(capture_bufs, CONFIG_NET_CAPTURE_BUF_COUNT,
 			  CONFIG_NET_BUF_DATA_SIZE, 4, NULL);
+#elif defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+NET_BUF_POOL_MULTI_DEFINE(capture_bufs, CONFIG_NET_CAPTURE_BUF_COUNT, 4, NULL,
+			  NET_BUF_MULTI_CLASSES);
 #else
 #define DATA_POOL_SIZE MAX(NET_PKT_BUF_RX_DATA_POOL_SIZE, NET_PKT_BUF_TX_DATA_POOL_SIZE)
 
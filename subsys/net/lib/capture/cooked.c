@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_cooked, CONFIG_NET_CAPTURE_LOG_LEVEL);
 #include <zephyr/net/capture.h>
 #include <zephyr/net/net_l2.h>
 
+#include "net_private.h"
 #include "sll.h"
 
 #define BUF_ALLOC_TIMEOUT 100 /* ms */
@@ -29,6 +30,9 @@ NET_PKT_SLAB_DEFINE(cooked_pkts, CONFIG_NET_CAPTURE_PKT_COUNT);
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 NET_BUF_POOL_FIXED_DEFINE(cooked_bufs, CONFIG_NET_CAPTURE_BUF_COUNT,
 			  CONFIG_NET_BUF_DATA_SIZE, 4, NULL);
+#elif defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+NET_BUF_POOL_MULTI_DEFINE(cooked_bufs, CONFIG_NET_CAPTURE_BUF_COUNT, 4, NULL,
+			  NET_BUF_MULTI_CLASSES);
 #else
 NET_BUF_POOL_VAR_DEFINE(cooked_bufs, CONFIG_NET_CAPTURE_BUF_COUNT,
 			CONFIG_NET_BUF_DATA_POOL_SIZE, 4, NULL);
@@ -17,6 +17,7 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #include <zephyr/net/coap_mgmt.h>
 #include <zephyr/net/coap_service.h>
 #include <zephyr/posix/fcntl.h>
+#include <zephyr/sys/byteorder.h>
 
 #if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
 /* Lowest priority cooperative thread */
@@ -34,12 +35,39 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #define MAX_PENDINGS   CONFIG_COAP_SERVICE_PENDING_MESSAGES
 #define MAX_OBSERVERS  CONFIG_COAP_SERVICE_OBSERVERS
 #define MAX_POLL_FD    CONFIG_NET_SOCKETS_POLL_MAX
+#define WORKERS        CONFIG_COAP_SERVER_WORKERS
 
 BUILD_ASSERT(CONFIG_NET_SOCKETS_POLL_MAX > 0, "CONFIG_NET_SOCKETS_POLL_MAX can't be 0");
 
 static K_MUTEX_DEFINE(lock);
 static int control_socks[2];
 
+#if WORKERS > 0
+/* A request received by the server thread, handled by a worker */
+struct coap_server_request {
+	const struct coap_service *service;
+	int sock_fd;
+	socklen_t addr_len;
+	struct sockaddr addr;
+	size_t len;
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+};
+
+K_MEM_SLAB_DEFINE_STATIC(request_slab, sizeof(struct coap_server_request),
+			 CONFIG_COAP_SERVER_WORKER_QUEUE_SIZE, 4);
+
+/* Holds all the request buffers, so it never fills up */
+K_MSGQ_DEFINE(request_queue, sizeof(struct coap_server_request *),
+	      CONFIG_COAP_SERVER_WORKER_QUEUE_SIZE, sizeof(void *));
+
+/* Set while the server thread waits for a free request buffer */
+static atomic_t request_wait;
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, WORKERS,
+				   CONFIG_COAP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread worker_threads[WORKERS];
+#endif
+
 #if defined(CONFIG_COAP_SERVER_PENDING_ALLOCATOR_STATIC)
 K_MEM_SLAB_DEFINE_STATIC(pending_data, CONFIG_COAP_SERVER_MESSAGE_SIZE,
 			 CONFIG_COAP_SERVER_PENDING_ALLOCATOR_STATIC_BLOCKS, 4);
@@ -121,34 +149,17 @@ static int coap_service_remove_observer(const struct coap_service *service,
 	return 0;
 }
 
-static int coap_server_process(int sock_fd)
+static int coap_server_handle(const struct coap_service *service, int sock_fd,
+			      uint8_t *buf, size_t received,
+			      const struct sockaddr *client_addr, socklen_t client_addr_len)
 {
-	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
-
-	struct sockaddr client_addr;
-	socklen_t client_addr_len = sizeof(client_addr);
-	struct coap_service *service = NULL;
 	struct coap_packet request;
 	struct coap_pending *pending;
 	struct coap_option options[MAX_OPTIONS] = { 0 };
 	uint8_t opt_num = MAX_OPTIONS;
 	uint8_t type;
-	ssize_t received;
 	int ret;
 
-	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT, &client_addr,
-				  &client_addr_len);
-	__ASSERT_NO_MSG(received <= sizeof(buf));
-
-	if (received < 0) {
-		if (errno == EWOULDBLOCK) {
-			return 0;
-		}
-
-		LOG_ERR("Failed to process client request (%d)", -errno);
-		return -errno;
-	}
-
 	ret = coap_packet_parse(&request, buf, received, options, opt_num);
 	if (ret < 0) {
 		LOG_ERR("Failed To parse coap message (%d)", ret);
@@ -156,14 +167,11 @@ static int coap_server_process(int sock_fd)
 	}
 
 	(void)k_mutex_lock(&lock, K_FOREVER);
-	/* Find the active service */
-	COAP_SERVICE_FOREACH(svc) {
-		if (svc->data->sock_fd == sock_fd) {
-			service = svc;
-			break;
-		}
-	}
-	if (service == NULL) {
+
+	/* The service may have been stopped, and its socket descriptor reused,
+	 * since the request was received.
+	 */
+	if (service->data->sock_fd != sock_fd) {
 		ret = -ENOENT;
 		goto unlock;
 	}
@@ -178,7 +186,7 @@ static int coap_server_process(int sock_fd)
 		switch (type) {
 		case COAP_TYPE_RESET:
 			tkl = coap_header_get_token(&request, token);
-			coap_service_remove_observer(service, NULL, &client_addr, token, tkl);
+			coap_service_remove_observer(service, NULL, client_addr, token, tkl);
 			__fallthrough;
 		case COAP_TYPE_ACK:
 			coap_server_free(pending->data);
@@ -197,6 +205,14 @@ static int coap_server_process(int sock_fd)
 		goto unlock;
 	}
 
+	/* With workers, resource handlers take the lock when they need it, so
+	 * that they can run concurrently. Without workers they keep running
+	 * with the lock held.
+	 */
+	if (WORKERS > 0) {
+		(void)k_mutex_unlock(&lock);
+	}
+
 	if (IS_ENABLED(CONFIG_COAP_SERVER_WELL_KNOWN_CORE) &&
 	    coap_header_get_code(&request) == COAP_METHOD_GET &&
 	    coap_uri_path_match(COAP_WELL_KNOWN_CORE_PATH, options, opt_num)) {
@@ -209,14 +225,15 @@ static int coap_server_process(int sock_fd)
 						   well_known_buf, sizeof(well_known_buf));
 		if (ret < 0) {
 			LOG_ERR("Failed to build well known core for %s (%d)", service->name, ret);
-			goto unlock;
+			goto out;
 		}
 
-		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
+		ret = coap_service_send(service, &response, client_addr, client_addr_len, NULL);
 	} else {
 		ret = coap_handle_request_len(&request, service->res_begin,
 					      COAP_SERVICE_RESOURCE_COUNT(service),
-					      options, opt_num, &client_addr, client_addr_len);
+					      options, opt_num, (struct sockaddr *)client_addr,
+					      client_addr_len);
 
 		/* Translate errors to response codes */
 		switch (ret) {
@@ -240,13 +257,18 @@ static int coap_server_process(int sock_fd)
 			ret = coap_ack_init(&ack, &request, ack_buf, sizeof(ack_buf), (uint8_t)ret);
 			if (ret < 0) {
 				LOG_ERR("Failed to init ACK (%d)", ret);
-				goto unlock;
+				goto out;
 			}
 
-			ret = coap_service_send(service, &ack, &client_addr, client_addr_len, NULL);
+			ret = coap_service_send(service, &ack, client_addr, client_addr_len, NULL);
 		}
 	}
 
+out:
+	if (WORKERS > 0) {
+		return ret;
+	}
+
 unlock:
 	(void)k_mutex_unlock(&lock);
 
@@ -598,6 +620,79 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 	return -ENOENT;
 }
 
+int coap_resource_notify_observers(struct coap_resource *resource, const struct coap_packet *cpkt,
+				   const struct coap_transmission_parameters *params)
+{
+	/* Room for the longest token */
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE + COAP_TOKEN_MAX_LEN];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	const struct coap_service *service = NULL;
+	struct coap_packet notification;
+	struct coap_observer *obs;
+	uint16_t tail_len;
+	uint8_t hdr_len;
+	uint8_t tkl = 0U;
+	int count = 0;
+	int ret;
+
+	if (coap_header_get_token(cpkt, token) != 0U ||
+	    cpkt->offset > CONFIG_COAP_SERVER_MESSAGE_SIZE) {
+		return -EINVAL;
+	}
+
+	/* Find owning service */
+	COAP_SERVICE_FOREACH(svc) {
+		if (COAP_SERVICE_HAS_RESOURCE(svc, resource)) {
+			service = svc;
+			break;
+		}
+	}
+
+	if (service == NULL) {
+		return -ENOENT;
+	}
+
+	/* The header and token are followed by the options and payload, which
+	 * are copied once and moved only when the token length changes.
+	 */
+	hdr_len = cpkt->hdr_len;
+	tail_len = cpkt->offset - hdr_len;
+	memcpy(buf, cpkt->data, cpkt->offset);
+
+	notification = *cpkt;
+	notification.data = buf;
+	notification.max_len = sizeof(buf);
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&resource->observers, obs, list) {
+		if (obs->tkl != tkl) {
+			memmove(buf + hdr_len + obs->tkl, buf + hdr_len + tkl, tail_len);
+			tkl = obs->tkl;
+			buf[0] = (buf[0] & 0xF0) | tkl;
+		}
+
+		memcpy(buf + hdr_len, obs->token, tkl);
+		sys_put_be16(coap_next_id(), buf + 2);
+
+		notification.hdr_len = hdr_len + tkl;
+		notification.offset = hdr_len + tkl + tail_len;
+
+		ret = coap_service_send(service, &notification, &obs->addr, ADDRLEN(&obs->addr),
+					params);
+		if (ret < 0) {
+			LOG_WRN("Failed to notify observer of %s (%d)", service->name, ret);
+			continue;
+		}
+
+		count++;
+	}
+
+	(void)k_mutex_unlock(&lock);
+
+	return count;
+}
+
 int coap_resource_parse_observe(struct coap_resource *resource, const struct coap_packet *request,
 				const struct sockaddr *addr)
 {
@@ -714,9 +809,130 @@ int coap_resource_remove_observer_by_token(struct coap_resource *resource,
 	return coap_resource_remove_observer(resource, NULL, token, token_len);
 }
 
+#if WORKERS > 0
+/* Receive a request and queue it to the workers. When all the request
+ * buffers are in use the request is left in the socket.
+ */
+static int coap_server_dispatch(const struct coap_service *service, int sock_fd)
+{
+	struct coap_server_request *req;
+	ssize_t received;
+
+	if (k_mem_slab_alloc(&request_slab, (void **)&req, K_NO_WAIT) < 0) {
+		return -ENOBUFS;
+	}
+
+	req->addr_len = sizeof(req->addr);
+	received = zsock_recvfrom(sock_fd, req->buf, sizeof(req->buf), ZSOCK_MSG_DONTWAIT,
+				  &req->addr, &req->addr_len);
+	if (received < 0) {
+		k_mem_slab_free(&request_slab, req);
+
+		if (errno == EWOULDBLOCK) {
+			return 0;
+		}
+
+		LOG_ERR("Failed to process client request (%d)", -errno);
+		return -errno;
+	}
+
+	__ASSERT_NO_MSG(received <= sizeof(req->buf));
+
+	req->service = service;
+	req->sock_fd = sock_fd;
+	req->len = received;
+
+	(void)k_msgq_put(&request_queue, &req, K_NO_WAIT);
+
+	return 0;
+}
+
+/* Tell whether the server thread can receive requests. If not, the next
+ * worker done with a request wakes it up.
+ */
+static bool coap_server_can_dispatch(void)
+{
+	if (k_mem_slab_num_free_get(&request_slab) > 0) {
+		return true;
+	}
+
+	atomic_set(&request_wait, 1);
+
+	/* A worker may have freed a buffer before the flag was set */
+	return k_mem_slab_num_free_get(&request_slab) > 0;
+}
+
+static void coap_server_worker(void *p1, void *p2, void *p3)
+{
+	struct coap_server_request *req;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&request_queue, &req, K_FOREVER);
+
+		(void)coap_server_handle(req->service, req->sock_fd, req->buf, req->len,
+					 &req->addr, req->addr_len);
+
+		k_mem_slab_free(&request_slab, req);
+
+		if (atomic_cas(&request_wait, 1, 0)) {
+			coap_server_update_services();
+		}
+	}
+}
+
+static void coap_server_start_workers(void)
+{
+	for (int i = 0; i < WORKERS; i++) {
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				coap_server_worker, NULL, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&worker_threads[i], "coap_worker");
+	}
+}
+#else
+/* Receive and handle a request */
+static int coap_server_dispatch(const struct coap_service *service, int sock_fd)
+{
+	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+
+	struct sockaddr client_addr;
+	socklen_t client_addr_len = sizeof(client_addr);
+	ssize_t received;
+
+	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT, &client_addr,
+				  &client_addr_len);
+	if (received < 0) {
+		if (errno == EWOULDBLOCK) {
+			return 0;
+		}
+
+		LOG_ERR("Failed to process client request (%d)", -errno);
+		return -errno;
+	}
+
+	__ASSERT_NO_MSG(received <= sizeof(buf));
+
+	return coap_server_handle(service, sock_fd, buf, received, &client_addr,
+				  client_addr_len);
+}
+
+static inline bool coap_server_can_dispatch(void)
+{
+	return true;
+}
+
+static inline void coap_server_start_workers(void) {}
+#endif /* WORKERS > 0 */
+
 static void coap_server_thread(void *p1, void *p2, void *p3)
 {
 	struct zsock_pollfd sock_fds[MAX_POLL_FD];
+	const struct coap_service *sock_svcs[MAX_POLL_FD];
 	int sock_nfds;
 	int ret;
 
@@ -743,6 +959,8 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 		}
 	}
 
+	coap_server_start_workers();
+
 	COAP_SERVICE_FOREACH(svc) {
 		if (svc->flags & COAP_SERVICE_AUTOSTART) {
 			ret = coap_service_start(svc);
@@ -753,9 +971,11 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 	}
 
 	while (true) {
+		bool receive = coap_server_can_dispatch();
+
 		sock_nfds = 0;
 		COAP_SERVICE_FOREACH(svc) {
-			if (svc->data->sock_fd < 0) {
+			if (svc->data->sock_fd < 0 || !receive) {
 				continue;
 			}
 			if (sock_nfds >= MAX_POLL_FD) {
@@ -765,6 +985,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 				break;
 			}
 
+			sock_svcs[sock_nfds] = svc;
 			sock_fds[sock_nfds].fd = svc->data->sock_fd;
 			sock_fds[sock_nfds].events = ZSOCK_POLLIN;
 			sock_fds[sock_nfds].revents = 0;
@@ -799,7 +1020,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 
 			/* Check if socket can receive/was closed first */
 			if (sock_fds[i].revents & ZSOCK_POLLIN) {
-				coap_server_process(sock_fds[i].fd);
+				coap_server_dispatch(sock_svcs[i], sock_fds[i].fd);
 				continue;
 			}
 
@@ -9,7 +9,163 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+/* Number of entries checked for expiry on each cache access */
+#define DNS_CACHE_CLEAN_STEP 2
+
+static void dns_cache_clean(struct dns_cache *cache);
+
+static uint32_t dns_cache_hash(const char *query)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash = (hash ^ (uint8_t)*query++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static inline uint16_t *dns_cache_bucket(struct dns_cache *cache, uint32_t hash)
+{
+	return &cache->buckets[hash & (cache->bucket_count - 1)];
+}
+
+static inline struct dns_cache_entry *dns_cache_entry(struct dns_cache *cache, uint16_t link)
+{
+	return link == 0 ? NULL : &cache->entries[link - 1];
+}
+
+static inline uint16_t dns_cache_link(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	return (uint16_t)(entry - cache->entries) + 1;
+}
+
+static enum dns_query_type dns_cache_family_type(int family)
+{
+	if (family == AF_INET) {
+		return DNS_QUERY_TYPE_A;
+	} else if (family == AF_INET6) {
+		return DNS_QUERY_TYPE_AAAA;
+	}
+
+	return 0;
+}
+
+/* Needs to be called when lock is already acquired. The link pointing to
+ * the entry is given so that chain walks do not need to search it again.
+ */
+static void dns_cache_unlink(struct dns_cache *cache, uint16_t *link,
+			     struct dns_cache_entry *entry)
+{
+	*link = entry->next;
+	sys_dlist_remove(&entry->lru_node);
+
+	entry->in_use = false;
+	entry->next = cache->free;
+	cache->free = dns_cache_link(cache, entry);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_release(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	uint16_t *link = dns_cache_bucket(cache, entry->hash);
+	uint16_t target = dns_cache_link(cache, entry);
+
+	while (*link != target) {
+		link = &dns_cache_entry(cache, *link)->next;
+	}
+
+	dns_cache_unlink(cache, link, entry);
+}
+
+/* Needs to be called when lock is already acquired. Checks a few entries
+ * for expiry, so that expired entries are released over time without
+ * scanning the whole cache on each access.
+ */
+static void dns_cache_clean_step(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+
+	for (int i = 0; i < DNS_CACHE_CLEAN_STEP && cache->unused > 0; i++) {
+		if (cache->clean_pos >= cache->unused) {
+			cache->clean_pos = 0;
+		}
+
+		entry = &cache->entries[cache->clean_pos++];
+
+		if (entry->in_use && sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, entry);
+		}
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_alloc(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+
+	if (cache->free == 0 && cache->unused == cache->size) {
+		dns_cache_clean(cache);
+	}
+
+	if (cache->free != 0) {
+		entry = dns_cache_entry(cache, cache->free);
+		cache->free = entry->next;
+	} else if (cache->unused < cache->size) {
+		entry = &cache->entries[cache->unused++];
+	} else {
+		entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru),
+				     struct dns_cache_entry, lru_node);
+
+		NET_DBG("Overwrite \"%s\"", entry->query);
+
+		dns_cache_release(cache, entry);
+		cache->free = entry->next;
+	}
+
+	return entry;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, const char *query, uint32_t hash,
+			     enum dns_query_type type, int status, uint32_t ttl,
+			     struct dns_addrinfo const *addrinfo)
+{
+	struct dns_cache_entry *entry = dns_cache_alloc(cache);
+	uint16_t *bucket = dns_cache_bucket(cache, hash);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+
+	if (addrinfo != NULL) {
+		entry->data = *addrinfo;
+	} else {
+		memset(&entry->data, 0, sizeof(entry->data));
+	}
+
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->hash = hash;
+	entry->type = type;
+	entry->status = status;
+	entry->in_use = true;
+
+	entry->next = *bucket;
+	*bucket = dns_cache_link(cache, entry);
+	sys_dlist_prepend(&cache->lru, &entry->lru_node);
+}
+
+static int dns_cache_check_query(const char *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
+	}
+
+	return 0;
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
@@ -17,6 +173,12 @@ int dns_cache_flush(struct dns_cache *cache)
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
 	}
+
+	memset(cache->buckets, 0, cache->bucket_count * sizeof(cache->buckets[0]));
+	sys_dlist_init(&cache->lru);
+	cache->free = 0;
+	cache->unused = 0;
+	cache->clean_pos = 0;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -25,47 +187,83 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	enum dns_query_type type;
+	struct dns_cache_entry *entry;
+	uint16_t *link;
+	uint32_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+	type = dns_cache_family_type(addrinfo->ai_family);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	dns_cache_clean_step(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
+	/* An address replaces a negative entry of the same type */
+	link = dns_cache_bucket(cache, hash);
+	while ((entry = dns_cache_entry(cache, *link)) != NULL) {
+		if (entry->status != 0 && entry->type == type && entry->hash == hash &&
+		    strcmp(entry->query, query) == 0) {
+			dns_cache_unlink(cache, link, entry);
+			continue;
 		}
+
+		link = &entry->next;
+	}
+
+	dns_cache_insert(cache, query, hash, type, 0, ttl, addrinfo);
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query,
+			   enum dns_query_type type, int status, uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	uint16_t *link;
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0 || status >= 0 || status < INT8_MIN) {
+		return -EINVAL;
+	}
+
+	if (dns_cache_check_query(query) < 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" type %d with TTL %" PRIu32, query, type, ttl);
+
+	dns_cache_clean_step(cache);
+
+	/* Replaces whatever was cached for this type */
+	link = dns_cache_bucket(cache, hash);
+	while ((entry = dns_cache_entry(cache, *link)) != NULL) {
+		if (entry->type == type && entry->hash == hash &&
+		    strcmp(entry->query, query) == 0) {
+			dns_cache_unlink(cache, link, entry);
+			continue;
+		}
+
+		link = &entry->next;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	dns_cache_insert(cache, query, hash, type, status, ttl, NULL);
 
 	k_mutex_unlock(cache->lock);
 
@@ -74,22 +272,27 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	struct dns_cache_entry *entry;
+	uint16_t *link;
+	uint32_t hash;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = dns_cache_hash(query);
 
-	dns_cache_clean(cache);
+	k_mutex_lock(cache->lock, K_FOREVER);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	link = dns_cache_bucket(cache, hash);
+	while ((entry = dns_cache_entry(cache, *link)) != NULL) {
+		if (entry->hash == hash && strcmp(entry->query, query) == 0) {
+			dns_cache_unlink(cache, link, entry);
+			continue;
 		}
+
+		link = &entry->next;
 	}
 
 	k_mutex_unlock(cache->lock);
@@ -97,38 +300,61 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
-		   size_t addrinfo_array_len)
+int dns_cache_find_type(struct dns_cache *cache, const char *query, enum dns_query_type type,
+			struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, int *status)
 {
+	struct dns_cache_entry *entry;
+	int negative = 0;
 	size_t found = 0;
+	uint16_t *link;
+	uint32_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	dns_cache_clean_step(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	link = dns_cache_bucket(cache, hash);
+	while ((entry = dns_cache_entry(cache, *link)) != NULL) {
+		if (sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_unlink(cache, link, entry);
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+
+		link = &entry->next;
+
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
 			continue;
 		}
+		if (type != 0 && entry->type != type) {
+			continue;
+		}
+
+		if (entry->status != 0) {
+			if (type != 0) {
+				negative = entry->status;
+			}
+			continue;
+		}
+
+		sys_dlist_remove(&entry->lru_node);
+		sys_dlist_prepend(&cache->lru, &entry->lru_node);
+
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -140,23 +366,37 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		return -ENOSR;
 	}
 
+	if (found == 0 && negative != 0) {
+		NET_DBG("Found negative \"%s\" (%d)", query, negative);
+		if (status != NULL) {
+			*status = negative;
+		}
+		return -ENODATA;
+	}
+
 	if (found == 0) {
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
+		   size_t addrinfo_array_len)
+{
+	return dns_cache_find_type(cache, query, 0, addrinfo, addrinfo_array_len, NULL);
+}
+
 /* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+static void dns_cache_clean(struct dns_cache *cache)
 {
-	for (size_t i = 0; i < cache->size; i++) {
+	for (size_t i = 0; i < cache->unused; i++) {
 		if (!cache->entries[i].in_use) {
 			continue;
 		}
 
 		if (sys_timepoint_expired(cache->entries[i].expiry)) {
 			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+			dns_cache_release(cache, &cache->entries[i]);
 		}
 	}
 }
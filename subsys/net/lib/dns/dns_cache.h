@@ -17,17 +17,42 @@
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
 
+/* Entries are linked by index + 1 so that a zeroed link means "none" and
+ * statically defined caches need no runtime initialization.
+ */
 struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Position in the least recently used list */
+	sys_dnode_t lru_node;
+	uint32_t hash;
+	/* Next entry in the same bucket, or in the free list */
+	uint16_t next;
+	/* Query type of the entry, 0 if unknown */
+	uint16_t type;
+	/* DNS_EAI_* status of a negative entry, 0 for an address entry */
+	int8_t status;
 	bool in_use;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* Heads of the hash chains, the count is a power of two */
+	uint16_t *buckets;
+	size_t bucket_count;
+	/* Most recently used entries first */
+	sys_dlist_t lru;
+	/* Head of the list of released entries */
+	uint16_t free;
+	/* Entries from this index on have never been used */
+	uint16_t unused;
+	/* Next entry checked by the incremental expiry */
+	uint16_t clean_pos;
 	struct k_mutex *lock;
 };
 
@@ -41,10 +66,17 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT((cache_size) > 0 && (cache_size) < UINT16_MAX);                               \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static uint16_t name##_buckets[NHPOT((cache_size) + 1)];                                   \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries,                                                         \
+		.size = cache_size,                                                                \
+		.buckets = name##_buckets,                                                         \
+		.bucket_count = ARRAY_SIZE(name##_buckets),                                        \
+		.lru = SYS_DLIST_STATIC_INIT(&name.lru),                                           \
+		.lock = &name##_mutex}
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -56,8 +88,8 @@ struct dns_cache {
 int dns_cache_flush(struct dns_cache *cache);
 
 /**
- * @brief Adds a new entry to the dns cache removing the one closest to expiry
- * if no free space is available.
+ * @brief Adds a new entry to the dns cache removing an expired entry, or the
+ * least recently used one, if no free space is available.
  *
  * @param cache Cache where the entry should be added.
  * @param query Query which should be persisted in the cache.
@@ -71,6 +103,24 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative entry to the dns cache, recording that the query
+ * returned no address of the given type.
+ *
+ * The entry is replaced by the first address added for the same query and
+ * type.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param type Query type (A or AAAA) that returned no address.
+ * @param status DNS_EAI_* status returned upon cache hit, like DNS_EAI_NODATA.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query,
+			   enum dns_query_type type, int status, uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -94,7 +144,28 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+/**
+ * @brief Tries to find the entries of a query of a given type within the cache.
+ *
+ * Same as dns_cache_find() but only returns addresses of the given type, and
+ * reports negative entries added with dns_cache_add_negative().
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param type Query type (A or AAAA).
+ * @param addrinfo dns_addrinfo array which will be written if the query was found.
+ * @param addrinfo_array_len Array size of the dns_addrinfo array
+ * @param status Set to the status of the negative entry on -ENODATA, may be NULL.
+ * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
+ * A cache miss will therefore return a 0.
+ * @retval -ENODATA if the query is cached as having no address of this type.
+ * @retval -ENOSR if there was not enough space in the addrinfo array.
+ * @retval On other errors a negative value is returned.
+ */
+int dns_cache_find_type(struct dns_cache *cache, const char *query, enum dns_query_type type,
+			struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, int *status);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -438,6 +438,36 @@ static inline void invoke_query_callback(int status,
 	}
 }
 
+/* Invoke the callbacks of the queries waiting for the answer of a query
+ * slot.
+ *
+ * Must be invoked with context lock held.
+ */
+static void invoke_followers_callback(int status,
+				      struct dns_addrinfo *info,
+				      struct dns_resolve_context *ctx,
+				      int slot)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].leader == slot + 1) {
+			invoke_query_callback(status, info, &ctx->queries[i]);
+		}
+	}
+}
+
+/* Callback of a query slot whose caller cancelled the query while other
+ * queries were waiting for its answer.
+ */
+static void detached_query_cb(enum dns_resolve_status status,
+			      struct dns_addrinfo *info, void *user_data)
+{
+	ARG_UNUSED(status);
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+}
+
 /* Release a query slot reserved by get_cb_slot().
  *
  * Must be invoked with context lock held.
@@ -448,6 +478,8 @@ static void release_query(struct dns_pending_query *pending_query)
 {
 	int busy = k_work_cancel_delayable(&pending_query->timer);
 
+	pending_query->leader = 0U;
+
 	/* If the work item is no longer pending we're done. */
 	if (busy == 0) {
 		/* All done. */
@@ -461,6 +493,21 @@ static void release_query(struct dns_pending_query *pending_query)
 	}
 }
 
+/* Release the query slots waiting for the answer of a query slot.
+ *
+ * Must be invoked with context lock held.
+ */
+static void release_followers(struct dns_resolve_context *ctx, int slot)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].leader == slot + 1) {
+			release_query(&ctx->queries[i]);
+		}
+	}
+}
+
 /* Must be invoked with context lock held */
 static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 				 uint16_t dns_id,
@@ -470,6 +517,7 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 
 	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
 		if (check_query_active(&ctx->queries[i], false) &&
+		    ctx->queries[i].leader == 0 &&
 		    ctx->queries[i].id == dns_id &&
 		    (query_hash == 0 ||
 		     ctx->queries[i].query_hash == query_hash)) {
@@ -480,6 +528,95 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+/* Must be invoked with context lock held */
+static inline int get_follower_by_id(struct dns_resolve_context *ctx,
+				     uint16_t dns_id,
+				     uint16_t query_hash)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (check_query_active(&ctx->queries[i], false) &&
+		    ctx->queries[i].leader != 0 &&
+		    ctx->queries[i].id == dns_id &&
+		    (query_hash == 0 ||
+		     ctx->queries[i].query_hash == query_hash)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Find a sent query for the same name and type, whose answer can be shared.
+ *
+ * Must be invoked with context lock held.
+ */
+static inline int get_slot_by_query(struct dns_resolve_context *ctx,
+				    const char *query,
+				    enum dns_query_type type)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].cb != NULL &&
+		    ctx->queries[i].query != NULL &&
+		    ctx->queries[i].leader == 0 &&
+		    ctx->queries[i].query_type == type &&
+		    strcmp(ctx->queries[i].query, query) == 0) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Must be invoked with context lock held */
+static inline int get_first_follower(struct dns_resolve_context *ctx, int slot)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].leader == slot + 1) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* A sent query whose caller cancelled it keeps running for the queries
+ * waiting for its answer. The name of the caller can be gone by then, so
+ * the query uses the name of the first waiting query instead. The query is
+ * released once no query waits for it anymore.
+ *
+ * Must be invoked with context lock held.
+ */
+static void update_detached_query(struct dns_resolve_context *ctx, int slot)
+{
+	int follower = get_first_follower(ctx, slot);
+
+	if (follower < 0) {
+		release_query(&ctx->queries[slot]);
+		return;
+	}
+
+	ctx->queries[slot].query = ctx->queries[follower].query;
+}
+
+/* A response without error nor answer tells that the name exists but has no
+ * record of the queried type (NODATA, RFC 2308).
+ */
+static bool is_nodata_response(struct dns_msg_t *dns_msg)
+{
+	return dns_msg->msg_size >= DNS_MSG_HEADER_SIZE &&
+	       dns_header_rcode(dns_msg->msg) == DNS_HEADER_NOERROR &&
+	       dns_header_opcode(dns_msg->msg) == DNS_QUERY &&
+	       dns_header_z(dns_msg->msg) == 0 &&
+	       dns_header_qdcount(dns_msg->msg) == 1 &&
+	       dns_header_ancount(dns_msg->msg) == 0;
+}
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -530,7 +667,7 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 	}
 
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
-	if (ret < 0) {
+	if (ret < 0 && !(ret == -EINVAL && is_nodata_response(dns_msg))) {
 		ret = DNS_EAI_FAIL;
 		goto quit;
 	}
@@ -655,6 +792,8 @@ query_known:
 
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
+			invoke_followers_callback(DNS_EAI_INPROGRESS, &info,
+						  ctx, *query_idx);
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 			dns_cache_add(&dns_cache,
 				ctx->queries[*query_idx].query, &info, ttl);
@@ -763,9 +902,19 @@ static int dns_read(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE) && CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0
+	if (ret == DNS_EAI_NODATA) {
+		dns_cache_add_negative(&dns_cache, ctx->queries[query_idx].query,
+				       ctx->queries[query_idx].query_type, ret,
+				       CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 	invoke_query_callback(ret, NULL, &ctx->queries[query_idx]);
+	invoke_followers_callback(ret, NULL, ctx, query_idx);
 
 	/* Marks the end of the results */
+	release_followers(ctx, query_idx);
 	release_query(&ctx->queries[query_idx]);
 
 	return 0;
@@ -884,8 +1033,10 @@ quit:
 	}
 
 	invoke_query_callback(ret, NULL, &ctx->queries[i]);
+	invoke_followers_callback(ret, NULL, ctx, i);
 
 	/* Marks the end of the results */
+	release_followers(ctx, i);
 	release_query(&ctx->queries[i]);
 
 free_buf:
@@ -1035,7 +1186,9 @@ static int dns_write(struct dns_resolve_context *ctx,
 static void dns_resolve_cancel_slot(struct dns_resolve_context *ctx, int slot)
 {
 	invoke_query_callback(DNS_EAI_CANCELED, NULL, &ctx->queries[slot]);
+	invoke_followers_callback(DNS_EAI_CANCELED, NULL, ctx, slot);
 
+	release_followers(ctx, slot);
 	release_query(&ctx->queries[slot]);
 }
 
@@ -1054,8 +1207,10 @@ static void dns_resolve_cancel_all(struct dns_resolve_context *ctx)
 static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 					uint16_t dns_id,
 					uint16_t query_hash,
-					const char *query_name)
+					const char *query_name,
+					bool timeout)
 {
+	uint16_t leader;
 	int ret = 0;
 	int i;
 
@@ -1071,16 +1226,36 @@ static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 
 	i = get_slot_by_id(ctx, dns_id, query_hash);
 	if (i < 0) {
-		ret = -ENOENT;
-		goto unlock;
+		i = get_follower_by_id(ctx, dns_id, query_hash);
+		if (i < 0) {
+			ret = -ENOENT;
+			goto unlock;
+		}
 	}
 
 	NET_DBG("Cancelling DNS req %u (name %s type %d hash %u)", dns_id,
 		query_name, ctx->queries[i].query_type,
 		query_hash);
 
+	if (!timeout && ctx->queries[i].leader == 0 &&
+	    get_first_follower(ctx, i) >= 0) {
+		/* Other queries wait for this answer, so only detach the
+		 * caller from the query.
+		 */
+		invoke_query_callback(DNS_EAI_CANCELED, NULL, &ctx->queries[i]);
+		ctx->queries[i].cb = detached_query_cb;
+		update_detached_query(ctx, i);
+		goto unlock;
+	}
+
+	leader = ctx->queries[i].leader;
+
 	dns_resolve_cancel_slot(ctx, i);
 
+	if (leader != 0 && ctx->queries[leader - 1].cb == detached_query_cb) {
+		update_detached_query(ctx, leader - 1);
+	}
+
 unlock:
 	k_mutex_unlock(&ctx->lock);
 
@@ -1133,7 +1308,7 @@ int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
 	}
 
 	return dns_resolve_cancel_with_hash(ctx, dns_id, query_hash,
-					    query_name);
+					    query_name, false);
 }
 
 int dns_resolve_cancel(struct dns_resolve_context *ctx, uint16_t dns_id)
@@ -1184,7 +1359,8 @@ static void query_timeout(struct k_work *work)
 	(void)dns_resolve_cancel_with_hash(pending_query->ctx,
 					   pending_query->id,
 					   pending_query->query_hash,
-					   pending_query->query);
+					   pending_query->query,
+					   true);
 
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
@@ -1201,12 +1377,13 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	struct net_buf *dns_data = NULL;
 	struct net_buf *dns_qname = NULL;
 	struct sockaddr addr;
-	int ret, i = -1, j = 0;
+	int ret, i = -1, j = 0, leader;
 	int failure = 0;
 	bool mdns_query = false;
 	uint8_t hop_limit;
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 	struct dns_addrinfo cached_info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES] = {0};
+	int cached_status;
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 	if (!ctx || !query || !cb) {
@@ -1270,7 +1447,8 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, sizeof(cached_info));
+	ret = dns_cache_find_type(&dns_cache, query, type, cached_info,
+				  ARRAY_SIZE(cached_info), &cached_status);
 	if (ret > 0) {
 		/* The query was cached, no
 		 * need to continue further.
@@ -1282,6 +1460,13 @@ try_resolve:
 
 		return 0;
 	}
+
+	if (ret == -ENODATA) {
+		/* The name is known to have no such address */
+		cb(cached_status, NULL, user_data);
+
+		return 0;
+	}
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 	k_mutex_lock(&ctx->lock, K_FOREVER);
@@ -1297,6 +1482,8 @@ try_resolve:
 		goto fail;
 	}
 
+	leader = get_slot_by_query(ctx, query, type);
+
 	ctx->queries[i].cb = cb;
 	ctx->queries[i].timeout = tout;
 	ctx->queries[i].query = query;
@@ -1304,9 +1491,44 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+	ctx->queries[i].leader = 0U;
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
+	/* If the same name and type is already being resolved, wait for that
+	 * answer instead of sending another query. The id of this query is
+	 * only used to cancel it.
+	 */
+	if (leader >= 0) {
+		ctx->queries[i].leader = leader + 1;
+		ctx->queries[i].query_hash = ctx->queries[leader].query_hash;
+
+		/* The id must not match the sent query, which has the same
+		 * hash.
+		 */
+		do {
+			ctx->queries[i].id = sys_rand16_get();
+		} while (ctx->queries[i].id == ctx->queries[leader].id);
+
+		/* The query gives up on its own timeout if the answer is
+		 * late.
+		 */
+		ret = k_work_reschedule(&ctx->queries[i].timer, tout);
+		if (ret < 0) {
+			goto quit;
+		}
+
+		if (dns_id) {
+			*dns_id = ctx->queries[i].id;
+		}
+
+		NET_DBG("[%u] waiting for the answer of query [%u] id %u",
+			i, leader, ctx->queries[leader].id);
+
+		ret = 0;
+		goto quit;
+	}
+
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
 	if (!dns_data) {
 		ret = -ENOMEM;
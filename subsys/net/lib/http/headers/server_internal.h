@@ -37,7 +37,12 @@ int enter_http_done_state(struct http_client_ctx *client);
 
 /* Others */
 struct http_resource_detail *get_resource_detail(const char *path, int *len, bool is_ws);
+bool http_server_claim_dynamic(struct http_resource_detail_dynamic *dynamic_detail,
+			       struct http_client_ctx *client);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+struct fs_file_t;
+int http_server_sendfile(struct http_client_ctx *client, struct fs_file_t *file, size_t len);
+int http_server_open_file(const char *path, struct fs_file_t *file, size_t *len);
 void http_client_timer_restart(struct http_client_ctx *client);
 
 /* TODO Could be static, but currently used in tests. */
@@ -101,6 +101,221 @@ const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
 	return &http_hpack_table_static[key];
 }
 
+#define HPACK_STATIC_TABLE_LEN HTTP_SERVER_HPACK_WWW_AUTHENTICATE
+
+/* Initial SETTINGS_HEADER_TABLE_SIZE of the peer (RFC 9113, ch. 6.5.2) */
+#define HPACK_DEFAULT_TABLE_SIZE 4096
+
+static void dynamic_table_init(struct http_hpack_dynamic_table *table,
+			       uint8_t *data,
+			       struct http_hpack_dynamic_entry *entries,
+			       uint16_t capacity, uint32_t max_size)
+{
+	table->data = data;
+	table->entries = entries;
+	table->capacity = capacity;
+	table->max_entries = capacity / HTTP_HPACK_ENTRY_OVERHEAD;
+	table->first = 0;
+	table->count = 0;
+	table->size = 0;
+	table->max_size = MIN(capacity, max_size);
+	table->size_update = false;
+	table->flush = false;
+	table->mark_evicted = false;
+	table->mark_first = 0;
+	table->mark_count = 0;
+	table->mark_size = 0;
+	table->mark_size_update = false;
+	table->mark_flush = false;
+}
+
+void http_hpack_init(struct http_hpack_header_buf *header)
+{
+#if HTTP_SERVER_HPACK_DECODER_TABLE_SIZE > 0
+	dynamic_table_init(&header->decoder, header->decoder_data,
+			   header->decoder_entries, sizeof(header->decoder_data),
+			   sizeof(header->decoder_data));
+#else
+	dynamic_table_init(&header->decoder, NULL, NULL, 0, 0);
+#endif
+
+#if HTTP_SERVER_HPACK_ENCODER_TABLE_SIZE > 0
+	dynamic_table_init(&header->encoder, header->encoder_data,
+			   header->encoder_entries, sizeof(header->encoder_data),
+			   HPACK_DEFAULT_TABLE_SIZE);
+#else
+	dynamic_table_init(&header->encoder, NULL, NULL, 0, 0);
+#endif
+}
+
+static inline uint32_t dynamic_entry_size(const struct http_hpack_dynamic_entry *entry)
+{
+	return entry->name_len + entry->value_len + HTTP_HPACK_ENTRY_OVERHEAD;
+}
+
+/* Index 1 is the most recently added entry. */
+static const struct http_hpack_dynamic_entry *
+dynamic_table_get(const struct http_hpack_dynamic_table *table, uint32_t index)
+{
+	if (index == 0 || index > table->count) {
+		return NULL;
+	}
+
+	return &table->entries[(table->first + table->count - index) %
+			       table->max_entries];
+}
+
+static void dynamic_table_evict(struct http_hpack_dynamic_table *table,
+				uint32_t size)
+{
+	while (table->size > size) {
+		table->size -= dynamic_entry_size(&table->entries[table->first]);
+		table->first = (table->first + 1) % table->max_entries;
+		table->count--;
+	}
+}
+
+static void dynamic_table_write(struct http_hpack_dynamic_table *table,
+				uint32_t offset, const char *src, size_t len)
+{
+	size_t part;
+
+	offset %= table->capacity;
+	part = MIN(len, table->capacity - offset);
+
+	memcpy(&table->data[offset], src, part);
+	memcpy(table->data, src + part, len - part);
+}
+
+static bool dynamic_table_equal(const struct http_hpack_dynamic_table *table,
+				uint32_t offset, const char *str, size_t len)
+{
+	size_t part;
+
+	offset %= table->capacity;
+	part = MIN(len, table->capacity - offset);
+
+	return memcmp(&table->data[offset], str, part) == 0 &&
+	       memcmp(table->data, str + part, len - part) == 0;
+}
+
+/* Return a string stored in the table. It is copied to the header buffer if
+ * it wraps around the end of the table, or if requested by the caller.
+ */
+static const char *dynamic_table_read(const struct http_hpack_dynamic_table *table,
+				      uint32_t offset, size_t len, bool copy,
+				      struct http_hpack_header_buf *header)
+{
+	uint8_t *buf = header->buf + header->datalen;
+	size_t part;
+
+	offset %= table->capacity;
+
+	if (!copy && offset + len <= table->capacity) {
+		return (const char *)&table->data[offset];
+	}
+
+	if (len > sizeof(header->buf) - header->datalen) {
+		return NULL;
+	}
+
+	part = MIN(len, table->capacity - offset);
+
+	memcpy(buf, &table->data[offset], part);
+	memcpy(buf + part, table->data, len - part);
+	header->datalen += len;
+
+	return (const char *)buf;
+}
+
+static void dynamic_table_add(struct http_hpack_dynamic_table *table,
+			      const char *name, size_t name_len,
+			      const char *value, size_t value_len)
+{
+	struct http_hpack_dynamic_entry *entry;
+	uint32_t size = name_len + value_len + HTTP_HPACK_ENTRY_OVERHEAD;
+	uint32_t offset = 0;
+
+	if (size > table->max_size) {
+		/* Not an error, the table is just emptied (RFC 7541, ch. 4.4). */
+		dynamic_table_evict(table, 0);
+		return;
+	}
+
+	dynamic_table_evict(table, table->max_size - size);
+
+	/* Data of the entries is stored back to back after the oldest one. */
+	if (table->count > 0) {
+		offset = table->entries[table->first].offset + table->size -
+			 table->count * HTTP_HPACK_ENTRY_OVERHEAD;
+	}
+
+	dynamic_table_write(table, offset, name, name_len);
+	dynamic_table_write(table, offset + name_len, value, value_len);
+
+	entry = &table->entries[(table->first + table->count) % table->max_entries];
+	entry->offset = offset % table->capacity;
+	entry->name_len = name_len;
+	entry->value_len = value_len;
+
+	table->count++;
+	table->size += size;
+}
+
+void http_hpack_set_encoder_max_size(struct http_hpack_header_buf *header,
+				     uint32_t max_size)
+{
+	struct http_hpack_dynamic_table *table = &header->encoder;
+
+	max_size = MIN(max_size, table->capacity);
+	if (max_size == table->max_size) {
+		return;
+	}
+
+	table->max_size = max_size;
+	table->size_update = true;
+
+	dynamic_table_evict(table, max_size);
+}
+
+/* Remember the encoder table state at the start of a header block. */
+void http_hpack_encoder_mark(struct http_hpack_header_buf *header)
+{
+	struct http_hpack_dynamic_table *table = &header->encoder;
+
+	table->mark_evicted = false;
+	table->mark_first = table->first;
+	table->mark_count = table->count;
+	table->mark_size = table->size;
+	table->mark_size_update = table->size_update;
+	table->mark_flush = table->flush;
+}
+
+/* Undo the changes to the encoder table since the mark, when a header block
+ * could not be sent and the peer never saw the fields added to its table.
+ */
+void http_hpack_encoder_rollback(struct http_hpack_header_buf *header)
+{
+	struct http_hpack_dynamic_table *table = &header->encoder;
+
+	if (!table->mark_evicted) {
+		/* Entries added since the mark are stored after the ones
+		 * present at the mark, which are still intact.
+		 */
+		table->first = table->mark_first;
+		table->count = table->mark_count;
+		table->size = table->mark_size;
+		table->size_update = table->mark_size_update;
+		table->flush = table->mark_flush;
+		return;
+	}
+
+	/* Evicted entries may have been overwritten, empty both tables. */
+	dynamic_table_evict(table, 0);
+	table->flush = true;
+	table->size_update = true;
+}
+
 static int http_hpack_find_index(struct http_hpack_header_buf *header,
 				 bool *name_only)
 {
@@ -128,6 +343,28 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 		}
 	}
 
+	for (int i = 1; i <= header->encoder.count; i++) {
+		const struct http_hpack_dynamic_entry *dyn_entry =
+			dynamic_table_get(&header->encoder, i);
+
+		if (dyn_entry->name_len == header->name_len &&
+		    dynamic_table_equal(&header->encoder, dyn_entry->offset,
+					header->name, header->name_len)) {
+			if (dyn_entry->value_len == header->value_len &&
+			    dynamic_table_equal(&header->encoder,
+						dyn_entry->offset + dyn_entry->name_len,
+						header->value, header->value_len)) {
+				/* Got exact match. */
+				*name_only = false;
+				return HPACK_STATIC_TABLE_LEN + i;
+			}
+
+			if (candidate < 0) {
+				candidate = HPACK_STATIC_TABLE_LEN + i;
+			}
+		}
+	}
+
 	if (candidate > 0) {
 		/* Matched name only. */
 		*name_only = true;
@@ -286,6 +523,41 @@ static int hpack_string_decode(const uint8_t *buf, size_t datalen,
 	return len;
 }
 
+/* Set the header name, and optionally the value, from a dynamic table entry. */
+static int hpack_dynamic_entry_get(uint32_t index, bool with_value, bool copy,
+				   struct http_hpack_header_buf *header)
+{
+	const struct http_hpack_dynamic_table *table = &header->decoder;
+	const struct http_hpack_dynamic_entry *entry;
+
+	entry = dynamic_table_get(table, index - HPACK_STATIC_TABLE_LEN);
+	if (entry == NULL) {
+		return -EBADMSG;
+	}
+
+	header->name = dynamic_table_read(table, entry->offset, entry->name_len,
+					  copy, header);
+	if (header->name == NULL) {
+		return -ENOBUFS;
+	}
+
+	header->name_len = entry->name_len;
+
+	if (!with_value) {
+		return 0;
+	}
+
+	header->value = dynamic_table_read(table, entry->offset + entry->name_len,
+					   entry->value_len, copy, header);
+	if (header->value == NULL) {
+		return -ENOBUFS;
+	}
+
+	header->value_len = entry->value_len;
+
+	return 0;
+}
+
 static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header)
 {
@@ -293,6 +565,8 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 	uint32_t index;
 	int ret;
 
+	header->datalen = 0;
+
 	ret = hpack_integer_decode(buf, datalen, HPACK_PREFIX_LEN_INDEXED,
 				   &index);
 	if (ret < 0) {
@@ -303,6 +577,12 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
+	if (http_hpack_key_is_dynamic(index)) {
+		int err = hpack_dynamic_entry_get(index, true, false, header);
+
+		return err < 0 ? err : ret;
+	}
+
 	entry = http_hpack_table_get(index);
 	if (entry == NULL) {
 		return -EBADMSG;
@@ -322,7 +602,7 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 
 static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header,
-				uint8_t prefix_len)
+				uint8_t prefix_len, bool indexing)
 {
 	uint32_t index;
 	int ret, len;
@@ -349,6 +629,14 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		len += ret;
 		buf += ret;
 		datalen -= ret;
+	} else if (http_hpack_key_is_dynamic(index)) {
+		/* Name indexed in the dynamic table. Copy it out of the table if
+		 * the new entry is to be added, as that may evict it.
+		 */
+		ret = hpack_dynamic_entry_get(index, false, indexing, header);
+		if (ret < 0) {
+			return ret;
+		}
 	} else {
 		/* Indexed name. */
 		const struct hpack_table_entry *entry;
@@ -373,27 +661,32 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 
 	len += ret;
 
+	if (indexing) {
+		dynamic_table_add(&header->decoder, header->name, header->name_len,
+				  header->value, header->value_len);
+	}
+
 	return len;
 }
 
 static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
 			       struct http_hpack_header_buf *header)
 {
-	/* TODO Add dynamic table support, if needed. */
-
 	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+				    HPACK_PREFIX_LEN_LITERAL_INDEXING, true);
 }
 
 static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
 				  struct http_hpack_header_buf *header)
 {
 	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
+				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING, false);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen,
+					    struct http_hpack_header_buf *header)
 {
+	struct http_hpack_dynamic_table *table = &header->decoder;
 	uint32_t max_size;
 	int ret;
 
@@ -403,7 +696,17 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+	/* The peer cannot exceed the size advertised in the settings. */
+	if (max_size > table->capacity) {
+		return -EBADMSG;
+	}
+
+	table->max_size = max_size;
+	dynamic_table_evict(table, max_size);
+
+	/* No header field decoded. */
+	header->name_len = 0;
+	header->value_len = 0;
 
 	return ret;
 }
@@ -434,7 +737,7 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 		ret = hpack_handle_literal_no_index(buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
 		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_dynamic_size_update(buf, datalen, header);
 	} else {
 		ret = -EINVAL;
 	}
@@ -468,7 +771,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -599,6 +902,62 @@ static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
 				    HPACK_PREFIX_LEN_INDEXED);
 }
 
+/* Literal with incremental indexing, the field is added to the peer table.
+ * Index 0 means a literal name.
+ */
+static int hpack_encode_literal_indexing(uint8_t *buf, size_t buflen, int index,
+					 struct http_hpack_header_buf *header)
+{
+	int ret, len = 0;
+
+	ret = hpack_integer_encode(buf, buflen, index,
+				   HPACK_PREFIX_LITERAL_INDEXING,
+				   HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	if (ret < 0) {
+		return ret;
+	}
+
+	buf += ret;
+	buflen -= ret;
+	len += ret;
+
+	if (index == 0) {
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	if (header->encoder.size + header->name_len + header->value_len +
+	    HTTP_HPACK_ENTRY_OVERHEAD > header->encoder.max_size) {
+		header->encoder.mark_evicted = true;
+	}
+
+	dynamic_table_add(&header->encoder, header->name, header->name_len,
+			  header->value, header->value_len);
+
+	return len;
+}
+
+static int hpack_encode_size_update(uint8_t *buf, size_t buflen,
+				    uint32_t max_size)
+{
+	return hpack_integer_encode(buf, buflen, max_size,
+				    HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+				    HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+}
+
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header)
 {
@@ -615,17 +974,48 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 		return -ENOBUFS;
 	}
 
+	if (header->encoder.size_update) {
+		/* Table size change must start the header block. */
+		if (header->encoder.flush) {
+			/* A zero size evicts all the entries of the peer. */
+			len = hpack_encode_size_update(buf, buflen, 0);
+			if (len < 0) {
+				return len;
+			}
+		}
+
+		ret = hpack_encode_size_update(buf + len, buflen - len,
+					       header->encoder.max_size);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+		buf += len;
+		buflen -= len;
+		header->encoder.size_update = false;
+		header->encoder.flush = false;
+	}
+
 	ret = http_hpack_find_index(header, &name_only);
-	if (ret < 0) {
+	if (ret >= 0 && !name_only) {
+		/* Indexed */
+		ret = hpack_encode_indexed(buf, buflen, ret);
+	} else if (header->encoder.max_size > 0) {
+		/* Literal, added to the dynamic table */
+		ret = hpack_encode_literal_indexing(buf, buflen, MAX(ret, 0),
+						    header);
+	} else if (ret < 0) {
 		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
-	} else if (name_only) {
-		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
+		ret = hpack_encode_literal(buf, buflen, header);
 	} else {
-		/* Indexed */
-		len = hpack_encode_indexed(buf, buflen, ret);
+		/* Literal value */
+		ret = hpack_encode_literal_value(buf, buflen, ret, header);
 	}
 
-	return len;
+	if (ret < 0) {
+		return ret;
+	}
+
+	return len + ret;
 }
@@ -12,6 +12,7 @@
 #include <string.h>
 #include <strings.h>
 
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
@@ -19,6 +20,7 @@
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
 #include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/fs/fs.h>
 
 LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -38,23 +40,49 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#define HTTP_SERVER_WORKERS CONFIG_HTTP_SERVER_WORKERS
 
 struct http_server_ctx {
-	int num_clients;
+	atomic_t num_clients;
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
-	/* First pollfd is eventfd that can be used to stop the server,
+	/* First pollfd is eventfd that can be used to stop the server
+	 * or to signal that a worker is done with a client,
 	 * then we have the server listen sockets,
 	 * and then the accepted sockets.
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+
+#if HTTP_SERVER_WORKERS > 0
+	/* Clients handed to a worker, removed from the poll set meanwhile */
+	bool busy[HTTP_SERVER_MAX_CLIENTS];
+	int busy_count;
+#endif
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
+/* Protects the holder of the dynamic resources */
+static struct k_spinlock holder_lock;
+
+#if HTTP_SERVER_WORKERS > 0
+/* Indexes of the clients to serve, and of the clients served by the
+ * workers. Both can hold all the clients, so they never fill up.
+ */
+K_MSGQ_DEFINE(work_queue, sizeof(int), HTTP_SERVER_MAX_CLIENTS, sizeof(int));
+K_MSGQ_DEFINE(done_queue, sizeof(int), HTTP_SERVER_MAX_CLIENTS, sizeof(int));
+
+/* Serializes the worker wake ups with the closing of the eventfd */
+static K_MUTEX_DEFINE(wakeup_lock);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_WORKERS,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread worker_threads[HTTP_SERVER_WORKERS];
+#endif
+
 int http_server_init(struct http_server_ctx *ctx)
 {
 	int proto;
@@ -212,7 +240,7 @@ int http_server_init(struct http_server_ctx *ctx)
 	}
 
 	ctx->listen_fds = count;
-	ctx->num_clients = 0;
+	atomic_set(&ctx->num_clients, 0);
 
 	return 0;
 }
@@ -242,8 +270,14 @@ static int accept_new_client(int server_fd)
 
 static int close_all_sockets(struct http_server_ctx *ctx)
 {
+#if HTTP_SERVER_WORKERS > 0
+	k_mutex_lock(&wakeup_lock, K_FOREVER);
+#endif
 	zsock_close(ctx->fds[0].fd); /* close eventfd */
 	ctx->fds[0].fd = -1;
+#if HTTP_SERVER_WORKERS > 0
+	k_mutex_unlock(&wakeup_lock);
+#endif
 
 	for (int i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
 		if (ctx->fds[i].fd < 0) {
@@ -257,6 +291,24 @@ static int close_all_sockets(struct http_server_ctx *ctx)
 	return 0;
 }
 
+bool http_server_claim_dynamic(struct http_resource_detail_dynamic *dynamic_detail,
+			       struct http_client_ctx *client)
+{
+	k_spinlock_key_t key;
+	bool claimed = false;
+
+	key = k_spin_lock(&holder_lock);
+
+	if (dynamic_detail->holder == NULL || dynamic_detail->holder == client) {
+		dynamic_detail->holder = client;
+		claimed = true;
+	}
+
+	k_spin_unlock(&holder_lock, key);
+
+	return claimed;
+}
+
 static void client_release_resources(struct http_client_ctx *client)
 {
 	struct http_resource_detail *detail;
@@ -302,7 +354,13 @@ void http_server_release_client(struct http_client_ctx *client)
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	server_ctx.num_clients--;
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	if (client->http2_fs.active) {
+		fs_close(&client->http2_fs.file);
+	}
+#endif
+
+	atomic_dec(&server_ctx.num_clients);
 
 	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
 		if (server_ctx.fds[i].fd == client->fd) {
@@ -353,6 +411,9 @@ static void init_client_ctx(struct http_client_ctx *client, int new_socket)
 	client->has_upgrade_header = false;
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
+	client->peer_window_size = HTTP_SERVER_DEFAULT_PEER_WINDOW_SIZE;
+	client->peer_initial_window_size = HTTP_SERVER_DEFAULT_PEER_WINDOW_SIZE;
+	http_hpack_init(&client->header_field);
 
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
@@ -461,6 +522,146 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+static void serve_client(struct http_client_ctx *client)
+{
+	int ret;
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d",
+				ARRAY_INDEX(server_ctx.clients, client));
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
+
+#if HTTP_SERVER_WORKERS > 0
+static bool client_is_busy(struct http_server_ctx *ctx, int idx)
+{
+	return ctx->busy[idx];
+}
+
+/* Hand a client with pending data to the workers. Its socket is left out
+ * of the poll set until the worker is done with it, so unread data stays
+ * in the socket and the TCP window throttles the peer.
+ */
+static void dispatch_client(struct http_server_ctx *ctx, int i)
+{
+	int idx = i - ctx->listen_fds;
+
+	ctx->busy[idx] = true;
+	ctx->busy_count++;
+	ctx->fds[i].fd = INVALID_SOCK;
+
+	(void)k_msgq_put(&work_queue, &idx, K_NO_WAIT);
+}
+
+static void complete_client(struct http_server_ctx *ctx, int idx)
+{
+	struct http_client_ctx *client = &ctx->clients[idx];
+
+	ctx->busy[idx] = false;
+	ctx->busy_count--;
+
+	/* The worker may have closed the connection. */
+	if (client->fd != INVALID_SOCK) {
+		ctx->fds[ctx->listen_fds + idx].fd = client->fd;
+		ctx->fds[ctx->listen_fds + idx].revents = 0;
+	}
+}
+
+static void complete_clients(struct http_server_ctx *ctx)
+{
+	int idx;
+
+	while (k_msgq_get(&done_queue, &idx, K_NO_WAIT) == 0) {
+		complete_client(ctx, idx);
+	}
+}
+
+static void wait_for_workers(struct http_server_ctx *ctx)
+{
+	int idx;
+
+	while (ctx->busy_count > 0) {
+		(void)k_msgq_get(&done_queue, &idx, K_FOREVER);
+		complete_client(ctx, idx);
+	}
+}
+
+static void http_server_worker(void *p1, void *p2, void *p3)
+{
+	int idx;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&work_queue, &idx, K_FOREVER);
+
+		serve_client(&server_ctx.clients[idx]);
+
+		/* The server closes the eventfd once it got all the clients
+		 * back, so it must not be closed before the wake up.
+		 */
+		k_mutex_lock(&wakeup_lock, K_FOREVER);
+		(void)k_msgq_put(&done_queue, &idx, K_NO_WAIT);
+		eventfd_write(server_ctx.fds[0].fd, 1);
+		k_mutex_unlock(&wakeup_lock);
+	}
+}
+
+static void start_workers(void)
+{
+	for (int i = 0; i < HTTP_SERVER_WORKERS; i++) {
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				http_server_worker, NULL, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&worker_threads[i], "http_worker");
+	}
+}
+#else
+static inline bool client_is_busy(struct http_server_ctx *ctx, int idx)
+{
+	return false;
+}
+
+static inline void dispatch_client(struct http_server_ctx *ctx, int i) {}
+static inline void complete_clients(struct http_server_ctx *ctx) {}
+static inline void wait_for_workers(struct http_server_ctx *ctx) {}
+static inline void start_workers(void) {}
+#endif /* HTTP_SERVER_WORKERS > 0 */
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
@@ -486,10 +687,15 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
+		if (ctx->fds[0].revents) {
 			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			goto closing;
+
+			if (!server_running) {
+				LOG_DBG("Received stop event. exiting ..");
+				goto closing;
+			}
+
+			complete_clients(ctx);
 		}
 
 		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
@@ -542,7 +748,8 @@ static int http_server_run(struct http_server_ctx *ctx)
 				found_slot = false;
 
 				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
+					if (ctx->fds[j].fd != INVALID_SOCK ||
+					    client_is_busy(ctx, j - ctx->listen_fds)) {
 						continue;
 					}
 
@@ -550,7 +757,7 @@ static int http_server_run(struct http_server_ctx *ctx)
 					ctx->fds[j].events = ZSOCK_POLLIN;
 					ctx->fds[j].revents = 0;
 
-					ctx->num_clients++;
+					atomic_inc(&ctx->num_clients);
 
 					LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
@@ -569,49 +776,20 @@ static int http_server_run(struct http_server_ctx *ctx)
 			}
 
 			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
-
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
-
-				close_client_connection(client);
+			if (HTTP_SERVER_WORKERS > 0) {
+				dispatch_client(ctx, i);
 				continue;
 			}
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
-			}
+			serve_client(&ctx->clients[i - ctx->listen_fds]);
 		}
 	}
 
 	return 0;
 
 closing:
+	wait_for_workers(ctx);
+
 	/* Close all client connections and the server socket */
 	return close_all_sockets(ctx);
 }
@@ -651,9 +829,89 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
-struct http_resource_detail *get_resource_detail(const char *path,
-						 int *path_len,
-						 bool is_websocket)
+#if CONFIG_HTTP_SERVER_RESOURCE_TABLE_SIZE > 0
+/* Open addressing hash table of the resources of all services. Resources
+ * sharing a path are stored in definition order along the probe sequence,
+ * so a lookup finds the same resource as the linear search.
+ */
+static struct http_resource_desc *resource_table[CONFIG_HTTP_SERVER_RESOURCE_TABLE_SIZE];
+static bool resource_table_valid;
+
+/* FNV-1a hash of the path, up to the query string */
+static uint32_t resource_hash(const char *path)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*path != '\0' && *path != '?') {
+		hash = (hash ^ (uint8_t)*path++) * 16777619U;
+	}
+
+	return hash % ARRAY_SIZE(resource_table);
+}
+
+static int resource_table_init(void)
+{
+	size_t count = 0;
+
+	HTTP_SERVICE_FOREACH(service) {
+		count += service->res_end - service->res_begin;
+	}
+
+	/* Keep a free slot to terminate the probe sequences. */
+	if (count >= ARRAY_SIZE(resource_table)) {
+		LOG_WRN("%zu resources do not fit in the lookup table", count);
+		return 0;
+	}
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			uint32_t slot = resource_hash(resource->resource);
+
+			while (resource_table[slot] != NULL) {
+				slot = (slot + 1) % ARRAY_SIZE(resource_table);
+			}
+
+			resource_table[slot] = resource;
+		}
+	}
+
+	resource_table_valid = true;
+
+	return 0;
+}
+
+SYS_INIT(resource_table_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static struct http_resource_desc *resource_table_lookup(const char *path,
+							 bool is_websocket)
+{
+	uint32_t slot = resource_hash(path);
+
+	while (resource_table[slot] != NULL) {
+		struct http_resource_desc *resource = resource_table[slot];
+
+		if (!skip_this(resource, is_websocket) &&
+		    compare_strings(path, resource->resource) == 0) {
+			return resource;
+		}
+
+		slot = (slot + 1) % ARRAY_SIZE(resource_table);
+	}
+
+	return NULL;
+}
+#else
+static const bool resource_table_valid;
+
+static inline struct http_resource_desc *resource_table_lookup(const char *path,
+								bool is_websocket)
+{
+	return NULL;
+}
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_TABLE_SIZE > 0 */
+
+static struct http_resource_desc *resource_search(const char *path,
+						  bool is_websocket)
 {
 	HTTP_SERVICE_FOREACH(service) {
 		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
@@ -662,19 +920,38 @@ struct http_resource_detail *get_resource_detail(const char *path,
 			}
 
 			if (compare_strings(path, resource->resource) == 0) {
-				NET_DBG("Got match for %s", resource->resource);
-
-				*path_len = strlen(resource->resource);
-				return resource->detail;
+				return resource;
 			}
 		}
 	}
 
-	NET_DBG("No match for %s", path);
-
 	return NULL;
 }
 
+struct http_resource_detail *get_resource_detail(const char *path,
+						 int *path_len,
+						 bool is_websocket)
+{
+	struct http_resource_desc *resource;
+
+	if (resource_table_valid) {
+		resource = resource_table_lookup(path, is_websocket);
+	} else {
+		resource = resource_search(path, is_websocket);
+	}
+
+	if (resource == NULL) {
+		NET_DBG("No match for %s", path);
+		return NULL;
+	}
+
+	NET_DBG("Got match for %s", resource->resource);
+
+	*path_len = strlen(resource->resource);
+
+	return resource->detail;
+}
+
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len)
 {
 	while (len) {
@@ -693,6 +970,56 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+int http_server_sendfile(struct http_client_ctx *client, struct fs_file_t *file, size_t len)
+{
+	while (len) {
+		ssize_t out_len = zsock_sendfile(client->fd, file, NULL, len);
+
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		if (out_len == 0) {
+			/* The file got shorter than announced */
+			return -EIO;
+		}
+
+		len -= out_len;
+
+		http_client_timer_restart(client);
+	}
+
+	return 0;
+}
+
+int http_server_open_file(const char *path, struct fs_file_t *file, size_t *len)
+{
+	struct fs_dirent entry;
+	int ret;
+
+	ret = fs_stat(path, &entry);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (entry.type != FS_DIR_ENTRY_FILE) {
+		return -ENOENT;
+	}
+
+	fs_file_t_init(file);
+
+	ret = fs_open(file, path, FS_O_READ);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*len = entry.size;
+
+	return 0;
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS */
+
 int http_server_start(void)
 {
 	if (server_running) {
@@ -732,6 +1059,8 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+	start_workers();
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
@@ -12,6 +12,7 @@
 #include <string.h>
 #include <strings.h>
 
+#include <zephyr/fs/fs.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
@@ -25,53 +26,58 @@ LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 static const char final_chunk[] = "0\r\n\r\n";
 static const char *crlf = &final_chunk[3];
 
-static int handle_http1_static_resource(
-	struct http_resource_detail_static *static_detail,
-	struct http_client_ctx *client)
-{
 #define RESPONSE_TEMPLATE			\
 	"HTTP/1.1 200 OK\r\n"			\
 	"%s%s\r\n"				\
-	"Content-Length: %d\r\n"
+	"Content-Length: %zu\r\n"
 
+static int send_http1_static_headers(struct http_client_ctx *client,
+				     struct http_resource_detail *common,
+				     size_t len)
+{
 	/* Add couple of bytes to total response */
 	char http_response[sizeof(RESPONSE_TEMPLATE) +
 			   sizeof("Content-Encoding: 01234567890123456789\r\n") +
 			   sizeof("Content-Type: \r\n") + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
-			   sizeof("xxxx") +
+			   sizeof("xxxxxxxxxx") +
 			   sizeof("\r\n")];
-	const char *data;
-	int len;
+
+	if (common->content_encoding != NULL &&
+	    common->content_encoding[0] != '\0') {
+		snprintk(http_response, sizeof(http_response),
+			 RESPONSE_TEMPLATE "Content-Encoding: %s\r\n\r\n",
+			 "Content-Type: ",
+			 common->content_type == NULL ?
+			 "text/html" : common->content_type,
+			 len, common->content_encoding);
+	} else {
+		snprintk(http_response, sizeof(http_response),
+			 RESPONSE_TEMPLATE "\r\n",
+			 "Content-Type: ",
+			 common->content_type == NULL ?
+			 "text/html" : common->content_type,
+			 len);
+	}
+
+	return http_server_sendall(client, http_response,
+				   strlen(http_response));
+}
+
+static int handle_http1_static_resource(
+	struct http_resource_detail_static *static_detail,
+	struct http_client_ctx *client)
+{
 	int ret;
 
 	if (static_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET)) {
-		data = static_detail->static_data;
-		len = static_detail->static_data_len;
-
-		if (static_detail->common.content_encoding != NULL &&
-		    static_detail->common.content_encoding[0] != '\0') {
-			snprintk(http_response, sizeof(http_response),
-				 RESPONSE_TEMPLATE "Content-Encoding: %s\r\n\r\n",
-				 "Content-Type: ",
-				 static_detail->common.content_type == NULL ?
-				 "text/html" : static_detail->common.content_type,
-				 len, static_detail->common.content_encoding);
-		} else {
-			snprintk(http_response, sizeof(http_response),
-				 RESPONSE_TEMPLATE "\r\n",
-				 "Content-Type: ",
-				 static_detail->common.content_type == NULL ?
-				 "text/html" : static_detail->common.content_type,
-				 len);
-		}
-
-		ret = http_server_sendall(client, http_response,
-					  strlen(http_response));
+		ret = send_http1_static_headers(client, &static_detail->common,
+						static_detail->static_data_len);
 		if (ret < 0) {
 			return ret;
 		}
 
-		ret = http_server_sendall(client, data, len);
+		ret = http_server_sendall(client, static_detail->static_data,
+					  static_detail->static_data_len);
 		if (ret < 0) {
 			return ret;
 		}
@@ -80,6 +86,39 @@ static int handle_http1_static_resource(
 	return 0;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+static int handle_http1_static_fs_resource(
+	struct http_resource_detail_static_fs *static_fs_detail,
+	struct http_client_ctx *client)
+{
+	struct fs_file_t file;
+	size_t len;
+	int ret;
+
+	if (!(static_fs_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET))) {
+		return 0;
+	}
+
+	ret = http_server_open_file(static_fs_detail->fs_path, &file, &len);
+	if (ret < 0) {
+		LOG_DBG("Cannot open %s (%d)", static_fs_detail->fs_path, ret);
+		return -ENOENT;
+	}
+
+	ret = send_http1_static_headers(client, &static_fs_detail->common, len);
+	if (ret < 0) {
+		goto out;
+	}
+
+	ret = http_server_sendfile(client, &file, len);
+
+out:
+	fs_close(&file);
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS */
+
 #define RESPONSE_TEMPLATE_CHUNKED			\
 	"HTTP/1.1 200 OK\r\n"				\
 	"%s%s\r\n"					\
@@ -271,7 +310,7 @@ static int handle_http1_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_dynamic(dynamic_detail, client)) {
 		static const char conflict_response[] =
 				"HTTP/1.1 409 Conflict\r\n\r\n";
 
@@ -285,8 +324,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -610,6 +647,19 @@ upgrade_not_found:
 			if (ret < 0) {
 				return ret;
 			}
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		} else if (detail->type == HTTP_RESOURCE_TYPE_STATIC_FS) {
+			ret = handle_http1_static_fs_resource(
+				(struct http_resource_detail_static_fs *)detail,
+				client);
+			if (ret == -ENOENT) {
+				goto not_found;
+			}
+
+			if (ret < 0) {
+				return ret;
+			}
+#endif
 		}
 	} else {
 not_found: ; /* Add extra semicolon to make clang to compile when using label */
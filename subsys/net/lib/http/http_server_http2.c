@@ -12,9 +12,11 @@
 #include <string.h>
 #include <strings.h>
 
+#include <zephyr/fs/fs.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
+#include <zephyr/sys/byteorder.h>
 
 LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -164,16 +166,19 @@ static int send_headers_frame(struct http_client_ctx *client,
 		return -EINVAL;
 	}
 
+	/* The peer table only changes if the frame gets out */
+	http_hpack_encoder_mark(&client->header_field);
+
 	ret = add_header_field(client, &buf, &buflen, ":status", status_str);
 	if (ret < 0) {
-		return ret;
+		goto rollback;
 	}
 
 	if (detail_common && detail_common->content_encoding != NULL) {
 		ret = add_header_field(client, &buf, &buflen, "content-encoding",
 				       "gzip");
 		if (ret < 0) {
-			return ret;
+			goto rollback;
 		}
 	}
 
@@ -181,7 +186,7 @@ static int send_headers_frame(struct http_client_ctx *client,
 		ret = add_header_field(client, &buf, &buflen, "content-type",
 				       detail_common->content_type);
 		if (ret < 0) {
-			return ret;
+			goto rollback;
 		}
 	}
 
@@ -195,10 +200,15 @@ static int send_headers_frame(struct http_client_ctx *client,
 				  payload_len + HTTP_SERVER_FRAME_HEADER_SIZE);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-		return ret;
+		goto rollback;
 	}
 
 	return 0;
+
+rollback:
+	http_hpack_encoder_rollback(&client->header_field);
+
+	return ret;
 }
 
 static int send_data_frame(struct http_client_ctx *client, const char *payload,
@@ -224,6 +234,11 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 		}
 	}
 
+	if (ret >= 0) {
+		/* DATA frames of all streams count against the connection window */
+		client->peer_window_size -= length;
+	}
+
 	return ret;
 }
 
@@ -249,7 +264,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP_SERVER_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(htons(HTTP_SETTINGS_HEADER_TABLE_SIZE),
 			      &setting->id);
-		UNALIGNED_PUT(0, &setting->value);
+		UNALIGNED_PUT(htonl(HTTP_SERVER_HPACK_DECODER_TABLE_SIZE),
+			      &setting->value);
 
 		setting++;
 		UNALIGNED_PUT(htons(HTTP_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -376,6 +392,122 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+/* Default SETTINGS_MAX_FRAME_SIZE, the server does not advertise another */
+#define HTTP2_MAX_DATA_FRAME_LEN 16384
+#define HTTP2_REFUSED_STREAM 0x7
+
+static int send_rst_stream_frame(struct http_client_ctx *client,
+				 uint32_t stream_id, uint32_t error_code)
+{
+	uint8_t rst_stream_frame[HTTP_SERVER_FRAME_HEADER_SIZE + sizeof(uint32_t)];
+
+	encode_frame_header(rst_stream_frame, sizeof(uint32_t),
+			    HTTP_SERVER_RST_STREAM_FRAME, 0, stream_id);
+	sys_put_be32(error_code, rst_stream_frame + HTTP_SERVER_FRAME_HEADER_SIZE);
+
+	return http_server_sendall(client, rst_stream_frame,
+				   sizeof(rst_stream_frame));
+}
+
+static void http2_static_fs_finish(struct http_client_ctx *client)
+{
+	fs_close(&client->http2_fs.file);
+	client->http2_fs.active = false;
+}
+
+/* Send as much of the pending file as the peer's stream and connection
+ * windows allow. The rest is sent once a WINDOW_UPDATE opens them again.
+ */
+static int http2_static_fs_send(struct http_client_ctx *client)
+{
+	uint8_t frame_header[HTTP_SERVER_FRAME_HEADER_SIZE];
+	size_t remaining = client->http2_fs.remaining;
+	int ret = 0;
+
+	while (remaining > 0) {
+		int window = MIN(client->http2_fs.window_size,
+				 client->peer_window_size);
+		size_t len;
+
+		if (window <= 0) {
+			break;
+		}
+
+		len = MIN(remaining, MIN((size_t)window, HTTP2_MAX_DATA_FRAME_LEN));
+		remaining -= len;
+
+		encode_frame_header(frame_header, len, HTTP_SERVER_DATA_FRAME,
+				    remaining == 0 ? HTTP_SERVER_FLAG_END_STREAM : 0,
+				    client->http2_fs.stream_id);
+
+		ret = http_server_sendall(client, frame_header, sizeof(frame_header));
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			break;
+		}
+
+		ret = http_server_sendfile(client, &client->http2_fs.file, len);
+		if (ret < 0) {
+			LOG_DBG("Cannot send file (%d)", ret);
+			break;
+		}
+
+		client->http2_fs.window_size -= len;
+		client->peer_window_size -= len;
+	}
+
+	client->http2_fs.remaining = remaining;
+
+	if (ret < 0 || remaining == 0) {
+		http2_static_fs_finish(client);
+	}
+
+	return ret;
+}
+
+static int handle_http2_static_fs_resource(
+	struct http_resource_detail_static_fs *static_fs_detail,
+	struct http_frame *frame, struct http_client_ctx *client)
+{
+	size_t remaining;
+	int ret;
+
+	if (!(static_fs_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET))) {
+		return -ENOTSUP;
+	}
+
+	if (client->http2_fs.active) {
+		/* Only one file transfer at a time, the peer may retry */
+		return send_rst_stream_frame(client, frame->stream_identifier,
+					     HTTP2_REFUSED_STREAM);
+	}
+
+	ret = http_server_open_file(static_fs_detail->fs_path,
+				    &client->http2_fs.file, &remaining);
+	if (ret < 0) {
+		LOG_DBG("Cannot open %s (%d)", static_fs_detail->fs_path, ret);
+		return send_http2_404(client, frame);
+	}
+
+	client->http2_fs.active = true;
+	client->http2_fs.remaining = remaining;
+	client->http2_fs.stream_id = frame->stream_identifier;
+	client->http2_fs.window_size = client->peer_initial_window_size;
+
+	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier,
+				 &static_fs_detail->common,
+				 remaining == 0 ? HTTP_SERVER_FLAG_END_STREAM : 0);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
+		http2_static_fs_finish(client);
+		return ret;
+	}
+
+	return http2_static_fs_send(client);
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS */
+
 static int dynamic_get_req_v2(struct http_resource_detail_dynamic *dynamic_detail,
 			      struct http_client_ctx *client)
 {
@@ -561,7 +693,7 @@ static int handle_http2_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_dynamic(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -570,8 +702,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 		if (user_method & BIT(HTTP_GET)) {
@@ -822,6 +952,15 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 			if (ret < 0) {
 				goto error;
 			}
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		} else if (detail->type == HTTP_RESOURCE_TYPE_STATIC_FS) {
+			ret = handle_http2_static_fs_resource(
+				(struct http_resource_detail_static_fs *)detail,
+				frame, client);
+			if (ret < 0) {
+				goto error;
+			}
+#endif
 		} else if (detail->type == HTTP_RESOURCE_TYPE_DYNAMIC) {
 			ret = handle_http2_dynamic_resource(
 				(struct http_resource_detail_dynamic *)detail,
@@ -1044,6 +1183,15 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 			if (ret < 0) {
 				return ret;
 			}
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		} else if (detail->type == HTTP_RESOURCE_TYPE_STATIC_FS) {
+			ret = handle_http2_static_fs_resource(
+				(struct http_resource_detail_static_fs *)detail,
+				frame, client);
+			if (ret < 0) {
+				return ret;
+			}
+#endif
 		}
 
 	} else {
@@ -1097,6 +1245,13 @@ int handle_http_frame_rst_frame(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	if (client->http2_fs.active &&
+	    client->http2_fs.stream_id == frame->stream_identifier) {
+		http2_static_fs_finish(client);
+	}
+#endif
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -1106,6 +1261,31 @@ int handle_http_frame_rst_frame(struct http_client_ctx *client)
 	return 0;
 }
 
+static void handle_settings_fields(struct http_client_ctx *client,
+				   uint32_t length)
+{
+	const uint8_t *field = client->cursor;
+
+	for (; length >= sizeof(struct http_settings_field);
+	     length -= sizeof(struct http_settings_field),
+	     field += sizeof(struct http_settings_field)) {
+		uint16_t id = sys_get_be16(field);
+		uint32_t value = sys_get_be32(field + sizeof(uint16_t));
+
+		if (id == HTTP_SETTINGS_HEADER_TABLE_SIZE) {
+			http_hpack_set_encoder_max_size(&client->header_field,
+							value);
+		} else if (id == HTTP_SETTINGS_INITIAL_WINDOW_SIZE) {
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+			/* The change applies to the windows of open streams too */
+			client->http2_fs.window_size +=
+				(int)value - client->peer_initial_window_size;
+#endif
+			client->peer_initial_window_size = value;
+		}
+	}
+}
+
 int handle_http_frame_settings(struct http_client_ctx *client)
 {
 	struct http_frame *frame = &client->current_frame;
@@ -1119,6 +1299,10 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (!settings_ack_flag(frame->flags)) {
+		handle_settings_fields(client, frame->length);
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -1135,6 +1319,12 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	if (client->http2_fs.active) {
+		return http2_static_fs_send(client);
+	}
+#endif
+
 	return 0;
 }
 
@@ -1169,18 +1359,36 @@ int handle_http_frame_window_update(struct http_client_ctx *client)
 
 	print_http_frames(client);
 
-	/* TODO Implement flow control, for now just ignore. */
-
 	if (client->data_len < frame->length) {
 		return -EAGAIN;
 	}
 
+	if (frame->length == sizeof(uint32_t)) {
+		uint32_t increment = sys_get_be32(client->cursor) & 0x7fffffff;
+
+		if (frame->stream_identifier == 0) {
+			client->peer_window_size += increment;
+		}
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		else if (client->http2_fs.active &&
+			 client->http2_fs.stream_id == frame->stream_identifier) {
+			client->http2_fs.window_size += increment;
+		}
+#endif
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	if (client->http2_fs.active) {
+		return http2_static_fs_send(client);
+	}
+#endif
+
 	return 0;
 }
 
@@ -198,22 +198,103 @@ int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id
 	return lwm2m_notify_observer_path(&path);
 }
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+/* Resolved observation path, valid for one registry generation */
+struct observe_path_cache {
+	struct lwm2m_obj_path path;
+	uint32_t generation;
+	struct lwm2m_engine_obj *obj;
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_engine_res *res;
+	struct lwm2m_engine_obj_field *obj_field;
+};
+
+static struct observe_path_cache observe_path_cache[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
+
+static struct observe_path_cache *observe_path_cache_entry(const struct lwm2m_obj_path *path)
+{
+	uint32_t hash = path->obj_id;
+
+	hash = hash * 31U + path->obj_inst_id;
+	hash = hash * 31U + path->res_id;
+
+	return &observe_path_cache[hash % ARRAY_SIZE(observe_path_cache)];
+}
+#endif /* CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP */
+
+/* Find object, object instance, resource and object field of a path, down to
+ * the path level. Missing parts are set to NULL.
+ */
+static void observe_path_lookup(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj **obj,
+				struct lwm2m_engine_obj_inst **obj_inst,
+				struct lwm2m_engine_res **res,
+				struct lwm2m_engine_obj_field **obj_field)
+{
+	int i;
+
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	struct observe_path_cache *entry = observe_path_cache_entry(path);
+	uint32_t generation = lwm2m_registry_generation();
+
+	if (entry->obj && entry->generation == generation &&
+	    lwm2m_obj_path_equal(&entry->path, path)) {
+		*obj = entry->obj;
+		*obj_inst = entry->obj_inst;
+		*res = entry->res;
+		*obj_field = entry->obj_field;
+		return;
+	}
+#endif
+
+	*obj_inst = NULL;
+	*res = NULL;
+	*obj_field = NULL;
+
+	*obj = get_engine_obj(path->obj_id);
+	if (*obj && path->level >= LWM2M_PATH_LEVEL_OBJECT_INST) {
+		*obj_inst = get_engine_obj_inst(path->obj_id, path->obj_inst_id);
+	}
+
+	if (*obj_inst && path->level >= LWM2M_PATH_LEVEL_RESOURCE) {
+		for (i = 0; i < (*obj_inst)->resource_count; i++) {
+			if ((*obj_inst)->resources[i].res_id == path->res_id) {
+				*res = &(*obj_inst)->resources[i];
+				*obj_field = lwm2m_get_engine_obj_field(*obj, path->res_id);
+				break;
+			}
+		}
+	}
+
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	entry->path = *path;
+	entry->generation = generation;
+	entry->obj = *obj;
+	entry->obj_inst = *obj_inst;
+	entry->res = *res;
+	entry->obj_field = *obj_field;
+#endif
+}
+
 static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 					 struct notification_attrs *attrs, uint16_t srv_obj_inst)
 {
 	struct lwm2m_engine_obj *obj;
-	struct lwm2m_engine_obj_field *obj_field = NULL;
-	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_obj_field *obj_field;
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_engine_res *res;
 	struct lwm2m_engine_res_inst *res_inst = NULL;
-	int ret, i;
+	int ret;
 
 	/* defaults from server object */
 	attrs->pmin = lwm2m_server_get_pmin(srv_obj_inst);
 	attrs->pmax = lwm2m_server_get_pmax(srv_obj_inst);
 	attrs->flags = BIT(LWM2M_ATTR_PMIN) | BIT(LWM2M_ATTR_PMAX);
 
+	lwm2m_registry_lock();
+	observe_path_lookup(path, &obj, &obj_inst, &res, &obj_field);
+	lwm2m_registry_unlock();
+
 	/* check if object exists */
-	obj = get_engine_obj(path->obj_id);
 	if (!obj) {
 		LOG_ERR("unable to find obj: %u", path->obj_id);
 		return -ENOENT;
@@ -226,7 +307,6 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 
 	/* check if object instance exists */
 	if (path->level >= LWM2M_PATH_LEVEL_OBJECT_INST) {
-		obj_inst = get_engine_obj_inst(path->obj_id, path->obj_inst_id);
 		if (!obj_inst) {
 			attrs->pmax = 0;
 			attrs->pmin = 0;
@@ -241,20 +321,13 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 
 	/* check if resource exists */
 	if (path->level >= LWM2M_PATH_LEVEL_RESOURCE) {
-		for (i = 0; i < obj_inst->resource_count; i++) {
-			if (obj_inst->resources[i].res_id == path->res_id) {
-				break;
-			}
-		}
-
-		if (i == obj_inst->resource_count) {
+		if (!res) {
 			LOG_ERR("unable to find res_id: %u/%u/%u", path->obj_id, path->obj_inst_id,
 				path->res_id);
 			return -ENOENT;
 		}
 
 		/* load object field data */
-		obj_field = lwm2m_get_engine_obj_field(obj, obj_inst->resources[i].res_id);
 		if (!obj_field) {
 			LOG_ERR("unable to find obj_field: %u/%u/%u", path->obj_id,
 				path->obj_inst_id, path->res_id);
@@ -266,7 +339,7 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 			return -EPERM;
 		}
 
-		ret = update_attrs(&obj_inst->resources[i], attrs);
+		ret = update_attrs(res, attrs);
 		if (ret < 0) {
 			return ret;
 		}
@@ -94,6 +94,101 @@ sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
 sys_slist_t *lwm2m_engine_obj_inst_list(void) { return &engine_obj_inst_list; }
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+/* Object instances sorted by object and instance ID, used while all fit */
+static struct lwm2m_engine_obj_inst *obj_inst_index[CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX_SIZE];
+static size_t obj_inst_index_count;
+static size_t obj_inst_count;
+static uint32_t registry_generation;
+
+uint32_t lwm2m_registry_generation(void) { return registry_generation; }
+
+static int obj_inst_cmp(const struct lwm2m_engine_obj_inst *obj_inst, int obj_id,
+			int obj_inst_id)
+{
+	if (obj_inst->obj->obj_id != obj_id) {
+		return obj_inst->obj->obj_id < obj_id ? -1 : 1;
+	}
+
+	if (obj_inst->obj_inst_id != obj_inst_id) {
+		return obj_inst->obj_inst_id < obj_inst_id ? -1 : 1;
+	}
+
+	return 0;
+}
+
+static bool obj_inst_index_valid(void)
+{
+	return obj_inst_count <= ARRAY_SIZE(obj_inst_index);
+}
+
+/* Position of the first object instance not lower than obj_id/obj_inst_id */
+static size_t obj_inst_index_find(int obj_id, int obj_inst_id)
+{
+	size_t low = 0;
+	size_t high = obj_inst_index_count;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		if (obj_inst_cmp(obj_inst_index[mid], obj_id, obj_inst_id) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+static void obj_inst_index_insert(struct lwm2m_engine_obj_inst *obj_inst)
+{
+	size_t pos = obj_inst_index_find(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
+
+	memmove(&obj_inst_index[pos + 1], &obj_inst_index[pos],
+		(obj_inst_index_count - pos) * sizeof(obj_inst_index[0]));
+	obj_inst_index[pos] = obj_inst;
+	obj_inst_index_count++;
+}
+
+static void obj_inst_index_add(struct lwm2m_engine_obj_inst *obj_inst)
+{
+	obj_inst_count++;
+	registry_generation++;
+
+	if (obj_inst_index_valid()) {
+		obj_inst_index_insert(obj_inst);
+	} else if (obj_inst_count == ARRAY_SIZE(obj_inst_index) + 1) {
+		LOG_WRN("Object instance index full, falling back to list lookups");
+	}
+}
+
+static void obj_inst_index_remove(struct lwm2m_engine_obj_inst *obj_inst)
+{
+	struct lwm2m_engine_obj_inst *oi;
+	bool was_valid = obj_inst_index_valid();
+	size_t pos;
+
+	obj_inst_count--;
+	registry_generation++;
+
+	if (was_valid) {
+		pos = obj_inst_index_find(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
+		if (pos < obj_inst_index_count && obj_inst_index[pos] == obj_inst) {
+			obj_inst_index_count--;
+			memmove(&obj_inst_index[pos], &obj_inst_index[pos + 1],
+				(obj_inst_index_count - pos) * sizeof(obj_inst_index[0]));
+		}
+	} else if (obj_inst_index_valid()) {
+		/* All object instances fit again, rebuild the index */
+		obj_inst_index_count = 0;
+		SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, oi, node) {
+			obj_inst_index_insert(oi);
+		}
+	}
+}
+#endif /* CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP */
+
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
 static void lwm2m_engine_cache_write(const struct lwm2m_engine_obj_field *obj_field,
 				     const struct lwm2m_obj_path *path, const void *value,
@@ -113,6 +208,9 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	registry_generation++;
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +222,9 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	registry_generation++;
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -145,6 +246,11 @@ struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_ob
 	int i;
 
 	if (obj && obj->fields && obj->field_count > 0) {
+		/* Fields are usually declared in resource ID order */
+		if (res_id >= 0 && res_id < obj->field_count && obj->fields[res_id].res_id == res_id) {
+			return &obj->fields[res_id];
+		}
+
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
@@ -176,6 +282,9 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	obj_inst_index_add(obj_inst);
+#endif
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,12 +294,28 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	obj_inst_index_remove(obj_inst);
+#endif
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	if (obj_inst_index_valid()) {
+		size_t pos = obj_inst_index_find(obj_id, obj_inst_id);
+
+		if (pos < obj_inst_index_count &&
+		    obj_inst_cmp(obj_inst_index[pos], obj_id, obj_inst_id) == 0) {
+			return obj_inst_index[pos];
+		}
+
+		return NULL;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -204,6 +329,18 @@ struct lwm2m_engine_obj_inst *next_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst, *next = NULL;
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP)
+	if (obj_inst_index_valid()) {
+		size_t pos = obj_inst_index_find(obj_id, obj_inst_id + 1);
+
+		if (pos < obj_inst_index_count && obj_inst_index[pos]->obj->obj_id == obj_id) {
+			return obj_inst_index[pos];
+		}
+
+		return NULL;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id > obj_inst_id &&
 		    (!next || next->obj_inst_id > obj_inst->obj_inst_id)) {
@@ -396,6 +533,45 @@ struct lwm2m_engine_obj_inst *lwm2m_engine_get_obj_inst(const struct lwm2m_obj_p
 	return get_engine_obj_inst(path->obj_id, path->obj_inst_id);
 }
 
+static struct lwm2m_engine_res *engine_get_res(struct lwm2m_engine_obj_inst *obj_inst,
+					       uint16_t res_id)
+{
+	int i;
+
+	/* Resources are usually created in resource ID order */
+	if (res_id < obj_inst->resource_count && obj_inst->resources[res_id].res_id == res_id) {
+		return &obj_inst->resources[res_id];
+	}
+
+	for (i = 0; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i].res_id == res_id) {
+			return &obj_inst->resources[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct lwm2m_engine_res_inst *engine_get_res_inst(struct lwm2m_engine_res *res,
+							 uint16_t res_inst_id)
+{
+	int i;
+
+	/* Resource instances are usually created in instance ID order */
+	if (res_inst_id < res->res_inst_count &&
+	    res->res_instances[res_inst_id].res_inst_id == res_inst_id) {
+		return &res->res_instances[res_inst_id];
+	}
+
+	for (i = 0; i < res->res_inst_count; i++) {
+		if (res->res_instances[i].res_inst_id == res_inst_id) {
+			return &res->res_instances[i];
+		}
+	}
+
+	return NULL;
+}
+
 int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst **obj_inst,
 		 struct lwm2m_engine_obj_field **obj_field, struct lwm2m_engine_res **res,
 		 struct lwm2m_engine_res_inst **res_inst)
@@ -404,7 +580,6 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 	struct lwm2m_engine_obj_field *of;
 	struct lwm2m_engine_res *r = NULL;
 	struct lwm2m_engine_res_inst *ri = NULL;
-	int i;
 
 	if (!path) {
 		return -EINVAL;
@@ -427,13 +602,7 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
-		}
-	}
-
+	r = engine_get_res(oi, path->res_id);
 	if (!r) {
 		if (LWM2M_HAS_PERM(of, BIT(LWM2M_FLAG_OPTIONAL))) {
 			LOG_DBG("resource %d not found", path->res_id);
@@ -444,12 +613,7 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < r->res_inst_count; i++) {
-		if (r->res_instances[i].res_inst_id == path->res_inst_id) {
-			ri = &r->res_instances[i];
-			break;
-		}
-	}
+	ri = engine_get_res_inst(r, path->res_inst_id);
 
 	/* specifically don't complain about missing resource instance */
 
@@ -159,6 +159,14 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		 struct lwm2m_engine_obj_field **obj_field, struct lwm2m_engine_res **res,
 		 struct lwm2m_engine_res_inst **res_inst);
 
+/**
+ * @brief Returns a counter that changes whenever objects or object instances are added to or
+ * removed from the registry. Only available with CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP.
+ *
+ * @return Registry generation.
+ */
+uint32_t lwm2m_registry_generation(void);
+
 /**
  * @brief Returns the object instance in the registry with object id = @p obj_id that has the
  * smalles object instance id strictly larger than @p obj_inst_id.
@@ -59,6 +59,14 @@ static void client_disconnect(struct mqtt_client *client, int result,
 	/* Reset internal state. */
 	client_reset(client);
 
+#if defined(CONFIG_MQTT_PUBLISH_ASYNC)
+	/* With a clean session, the broker drops unacknowledged messages. */
+	if (client->clean_session) {
+		memset(client->internal.inflight, 0,
+		       sizeof(client->internal.inflight));
+	}
+#endif
+
 	if (notify) {
 		struct mqtt_evt evt = {
 			.type = MQTT_EVT_DISCONNECT,
@@ -236,11 +244,38 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
+/** @brief Encode publish header in tx buffer, payload is sent in place. */
+static int publish_msg_encode(struct mqtt_client *client,
+			      const struct mqtt_publish_param *param,
+			      struct iovec io_vector[2], struct msghdr *msg)
+{
+	int err_code;
+	struct buf_ctx packet;
+
+	tx_buf_init(client, &packet);
+
+	err_code = publish_encode(param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	io_vector[0].iov_base = packet.cur;
+	io_vector[0].iov_len = packet.end - packet.cur;
+	io_vector[1].iov_base = param->message.payload.data;
+	io_vector[1].iov_len = param->message.payload.len;
+
+	memset(msg, 0, sizeof(*msg));
+
+	msg->msg_iov = io_vector;
+	msg->msg_iovlen = 2;
+
+	return 0;
+}
+
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
 	int err_code;
-	struct buf_ctx packet;
 	struct iovec io_vector[2];
 	struct msghdr msg;
 
@@ -254,38 +289,258 @@ int mqtt_publish(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
-
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = publish_encode(param, &packet);
+	err_code = publish_msg_encode(client, param, io_vector, &msg);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	io_vector[0].iov_base = packet.cur;
-	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
+	err_code = client_write_msg(client, &msg);
 
-	memset(&msg, 0, sizeof(msg));
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
+			 client, client->internal.state, err_code);
 
-	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	mqtt_mutex_unlock(client);
 
-	err_code = client_write_msg(client, &msg);
+	return err_code;
+}
+
+#if defined(CONFIG_MQTT_PUBLISH_ASYNC)
+static struct mqtt_inflight *publish_window_find(struct mqtt_client *client,
+						 uint16_t message_id)
+{
+	for (int i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		if (client->internal.inflight[i].param.message_id ==
+		    message_id) {
+			return &client->internal.inflight[i];
+		}
+	}
+
+	return NULL;
+}
+
+static uint16_t publish_window_next_id(struct mqtt_client *client)
+{
+	uint16_t message_id;
+
+	do {
+		message_id = ++client->internal.last_message_id;
+	} while ((message_id == 0U) ||
+		 (publish_window_find(client, message_id) != NULL));
+
+	return message_id;
+}
+
+/** @brief Send PUBLISH or PUBREL for an in-flight message. Unlike
+ *         client_write(), leaves the connection open on failure.
+ */
+static int publish_window_send(struct mqtt_client *client,
+			       struct mqtt_inflight *entry)
+{
+	int err_code;
+
+	if (entry->released) {
+		const struct mqtt_pubrel_param param = {
+			.message_id = entry->param.message_id,
+		};
+		struct buf_ctx packet;
+
+		tx_buf_init(client, &packet);
+
+		err_code = publish_release_encode(&param, &packet);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		err_code = mqtt_transport_write(client, packet.cur,
+						packet.end - packet.cur);
+	} else {
+		struct iovec io_vector[2];
+		struct msghdr msg;
+
+		err_code = publish_msg_encode(client, &entry->param, io_vector,
+					      &msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		err_code = mqtt_transport_write_msg(client, &msg);
+	}
+
+	if (err_code < 0) {
+		NET_ERR("[CID %p]: Message id 0x%04x write failed: %d", client,
+			entry->param.message_id, err_code);
+		return err_code;
+	}
+
+	/* Any further transmission of the PUBLISH is a duplicate. */
+	entry->param.dup_flag = 1U;
+	entry->sent = mqtt_sys_tick_in_ms_get();
+	client->internal.last_activity = entry->sent;
+
+	return 0;
+}
+
+int publish_window_ack(struct mqtt_client *client, uint8_t type,
+		       uint16_t message_id)
+{
+	struct mqtt_inflight *entry;
+	uint8_t qos;
+
+	if (message_id == 0U) {
+		return 0;
+	}
+
+	entry = publish_window_find(client, message_id);
+	if (entry == NULL) {
+		/* Not published through the window. */
+		return 0;
+	}
+
+	qos = entry->param.message.topic.qos;
+
+	switch (type) {
+	case MQTT_PKT_TYPE_PUBACK:
+		if (qos != MQTT_QOS_1_AT_LEAST_ONCE) {
+			return 0;
+		}
+
+		break;
+
+	case MQTT_PKT_TYPE_PUBREC:
+		if (qos != MQTT_QOS_2_EXACTLY_ONCE) {
+			return 0;
+		}
+
+		entry->released = 1U;
+
+		return publish_window_send(client, entry);
+
+	case MQTT_PKT_TYPE_PUBCOMP:
+		if (qos != MQTT_QOS_2_EXACTLY_ONCE) {
+			return 0;
+		}
+
+		break;
+
+	default:
+		return 0;
+	}
+
+	NET_DBG("[CID %p]: Message id 0x%04x acknowledged", client,
+		message_id);
+
+	memset(entry, 0, sizeof(*entry));
+
+	return 0;
+}
+
+int publish_window_resend(struct mqtt_client *client, bool all)
+{
+	int count = 0;
+	int err_code;
+
+	for (int i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		struct mqtt_inflight *entry = &client->internal.inflight[i];
+
+		if (entry->param.message_id == 0U) {
+			continue;
+		}
+
+		if (!all && ((CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT == 0) ||
+			     (mqtt_elapsed_time_in_ms_get(entry->sent) <
+			      CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT))) {
+			continue;
+		}
+
+		NET_DBG("[CID %p]: Retransmitting message id 0x%04x", client,
+			entry->param.message_id);
+
+		err_code = publish_window_send(client, entry);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		count++;
+	}
+
+	return count;
+}
+
+int mqtt_publish_async(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param)
+{
+	int err_code;
+	struct mqtt_inflight *entry;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return mqtt_publish(client, param);
+	}
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	if ((param->message_id != 0U) &&
+	    (publish_window_find(client, param->message_id) != NULL)) {
+		err_code = -EALREADY;
+		goto error;
+	}
+
+	entry = publish_window_find(client, 0U);
+	if (entry == NULL) {
+		err_code = -EAGAIN;
+		goto error;
+	}
+
+	entry->param = *param;
+	entry->param.dup_flag = 0U;
+	entry->released = 0U;
+
+	if (entry->param.message_id == 0U) {
+		entry->param.message_id = publish_window_next_id(client);
+	}
+
+	err_code = publish_window_send(client, entry);
+	if (err_code < 0) {
+		memset(entry, 0, sizeof(*entry));
+		client_disconnect(client, err_code, true);
+		goto error;
+	}
+
+	err_code = entry->param.message_id;
 
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
-			 client, client->internal.state, err_code);
+		 client, client->internal.state, err_code);
 
 	mqtt_mutex_unlock(client);
 
 	return err_code;
 }
+#else
+int publish_window_ack(struct mqtt_client *client, uint8_t type,
+		       uint16_t message_id)
+{
+	return 0;
+}
+
+int publish_window_resend(struct mqtt_client *client, bool all)
+{
+	return 0;
+}
+#endif /* CONFIG_MQTT_PUBLISH_ASYNC */
 
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
@@ -595,7 +850,7 @@ int mqtt_live(struct mqtt_client *client)
 {
 	int err_code = 0;
 	uint32_t elapsed_time;
-	bool ping_sent = false;
+	bool sent = false;
 
 	NULL_PARAM_CHECK(client);
 
@@ -606,12 +861,26 @@ int mqtt_live(struct mqtt_client *client)
 	if ((client->keepalive > 0) &&
 	    (elapsed_time >= (client->keepalive * 1000))) {
 		err_code = mqtt_ping(client);
-		ping_sent = true;
+		sent = true;
+	}
+
+	if (IS_ENABLED(CONFIG_MQTT_PUBLISH_ASYNC) && (err_code == 0) &&
+	    MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		int resent = publish_window_resend(client, false);
+
+		if (resent < 0) {
+			client_disconnect(client, resent, true);
+			err_code = resent;
+		}
+
+		if (resent != 0) {
+			sent = true;
+		}
 	}
 
 	mqtt_mutex_unlock(client);
 
-	if (ping_sent) {
+	if (sent) {
 		return err_code;
 	} else {
 		return -EAGAIN;
@@ -162,6 +162,27 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+/**@brief Updates the in-flight publish window on reception of a PUBACK,
+ *        PUBREC or PUBCOMP. Replies to PUBREC with PUBREL.
+ *
+ * @param[in] client Identifies the client for which the ack was received.
+ * @param[in] type MQTT Packet Type of the ack.
+ * @param[in] message_id Message id carried by the ack.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int publish_window_ack(struct mqtt_client *client, uint8_t type,
+		       uint16_t message_id);
+
+/**@brief Retransmits messages of the in-flight publish window.
+ *
+ * @param[in] client Identifies the client.
+ * @param[in] all Retransmit all pending messages, not only timed out ones.
+ *
+ * @return Number of messages retransmitted or a negative error code.
+ */
+int publish_window_resend(struct mqtt_client *client, bool all);
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
@@ -42,6 +42,16 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+
+				/* Resume messages left unacknowledged. */
+				if (IS_ENABLED(CONFIG_MQTT_PUBLISH_ASYNC)) {
+					int resent = publish_window_resend(
+								client, true);
+
+					if (resent < 0) {
+						err_code = resent;
+					}
+				}
 			} else {
 				err_code = -ECONNREFUSED;
 			}
@@ -77,6 +87,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+		if (IS_ENABLED(CONFIG_MQTT_PUBLISH_ASYNC) && (err_code == 0)) {
+			err_code = publish_window_ack(client,
+						      MQTT_PKT_TYPE_PUBACK,
+						      evt.param.puback.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -85,6 +101,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBREC;
 		err_code = publish_receive_decode(buf, &evt.param.pubrec);
 		evt.result = err_code;
+
+		if (IS_ENABLED(CONFIG_MQTT_PUBLISH_ASYNC) && (err_code == 0)) {
+			err_code = publish_window_ack(client,
+						      MQTT_PKT_TYPE_PUBREC,
+						      evt.param.pubrec.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -101,6 +123,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+		if (IS_ENABLED(CONFIG_MQTT_PUBLISH_ASYNC) && (err_code == 0)) {
+			err_code = publish_window_ack(client,
+						      MQTT_PKT_TYPE_PUBCOMP,
+						      evt.param.pubcomp.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
@@ -91,6 +91,19 @@ static void context_info(struct net_context *context, void *user_data)
 	info->pos++;
 #endif /* CONFIG_NET_CONTEXT_NET_PKT_POOL */
 }
+
+#if defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+static void multi_class_print(const struct shell *sh, struct net_buf_pool *pool,
+			      const char *name)
+{
+	struct net_buf_multi_class_stats stats;
+
+	for (size_t i = 0; net_buf_multi_class_stats_get(pool, i, &stats) == 0; i++) {
+		PR("%zu\t%u\t%u\t%u\t%u\t%u\t%s DATA\n", stats.size, stats.blocks,
+		   stats.used, stats.allocs, stats.fallbacks, stats.failures, name);
+	}
+}
+#endif /* CONFIG_NET_BUF_MULTI_DATA_SIZE */
 #endif /* CONFIG_NET_OFFLOAD || CONFIG_NET_NATIVE */
 
 static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
@@ -106,6 +119,8 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 	PR("Fragment length %d bytes\n", CONFIG_NET_BUF_DATA_SIZE);
+#elif defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+	PR("Fragment RX/TX data pool size %d bytes\n", NET_BUF_MULTI_DATA_POOL_SIZE);
 #else
 	PR("Fragment RX data pool size %d bytes\n", CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE);
 	PR("Fragment TX data pool size %d bytes\n", CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE);
@@ -138,6 +153,14 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 		"CONFIG_NET_BUF_POOL_USAGE", "net_buf allocation");
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_MULTI_DATA_SIZE)
+	PR("Data size classes:\n");
+	PR("Size\tBlocks\tUsed\tAllocs\tFallbk\tFailed\tName\n");
+
+	multi_class_print(sh, rx_data, "RX");
+	multi_class_print(sh, tx_data, "TX");
+#endif /* CONFIG_NET_BUF_MULTI_DATA_SIZE */
+
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_NET_PKT_POOL)) {
 		struct net_shell_user_data user_data;
 		struct ctx_info info;
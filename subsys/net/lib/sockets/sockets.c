@@ -20,6 +20,9 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/iterable_sections.h>
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+#include <zephyr/fs/fs.h>
+#endif
 
 #if defined(CONFIG_SOCKS)
 #include "socks.h"
@@ -815,7 +818,21 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	}
 
 	while (1) {
-		if (dest_addr) {
+		if ((flags & ZSOCK_MSG_MORE) &&
+		    net_context_get_proto(ctx) == IPPROTO_TCP) {
+			/* Only the sendmsg path carries the flags down to TCP */
+			struct iovec iov = {
+				.iov_base = (void *)buf,
+				.iov_len = len,
+			};
+			struct msghdr msg = {
+				.msg_iov = &iov,
+				.msg_iovlen = 1,
+			};
+
+			status = net_context_sendmsg(ctx, &msg, flags, NULL,
+						     timeout, ctx->user_data);
+		} else if (dest_addr) {
 			status = net_context_sendto(ctx, buf, len, dest_addr,
 						    addrlen, NULL, timeout,
 						    ctx->user_data);
@@ -1027,6 +1044,193 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+struct sendfile_state {
+	struct fs_file_t *file;
+	int error;
+};
+
+static int sendfile_fill(uint8_t *dst, size_t len, void *user_data)
+{
+	struct sendfile_state *state = user_data;
+	ssize_t ret;
+
+	ret = fs_read(state->file, dst, len);
+	if (ret < 0) {
+		state->error = ret;
+	}
+
+	return ret;
+}
+
+/* Native TCP: the file data is read straight into the send buffers */
+static ssize_t sendfile_tcp(struct net_context *ctx, struct fs_file_t *file,
+			    size_t count)
+{
+	struct sendfile_state state = { .file = file };
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timeout_t timeout = K_FOREVER;
+	k_timepoint_t buf_timeout, end;
+	size_t sent = 0;
+	int status;
+
+	if (sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	while (sent < count) {
+		status = net_tcp_queue_fill(ctx, count - sent, sendfile_fill,
+					    &state);
+		if (status == 0 || state.error < 0) {
+			/* End of file or read error */
+			if (status > 0) {
+				sent += status;
+			}
+
+			break;
+		}
+
+		if (status < 0) {
+			if (sent > 0 && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				break;
+			}
+
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return sent > 0 ? sent : -1;
+			}
+
+			timeout = sys_timepoint_timeout(end);
+			continue;
+		}
+
+		sent += status;
+		retry_timeout = WAIT_BUFS_INITIAL_MS;
+	}
+
+	if (sent == 0 && state.error < 0) {
+		errno = -state.error;
+		return -1;
+	}
+
+	return sent;
+}
+
+/* Other socket types go through a bounce buffer */
+static ssize_t sendfile_copy(void *obj, const struct socket_op_vtable *vtable,
+			     struct fs_file_t *file, size_t count)
+{
+	uint8_t buf[CONFIG_NET_SOCKETS_SENDFILE_BUF_SIZE];
+	size_t sent = 0;
+
+	while (sent < count) {
+		size_t chunk = MIN(count - sent, sizeof(buf));
+		ssize_t len, ret;
+		size_t off = 0;
+
+		len = fs_read(file, buf, chunk);
+		if (len < 0) {
+			if (sent > 0) {
+				break;
+			}
+
+			errno = -len;
+			return -1;
+		}
+
+		if (len == 0) {
+			break;
+		}
+
+		while (off < len) {
+			ret = vtable->sendto(obj, buf + off, len - off, 0, NULL, 0);
+			if (ret < 0) {
+				/* Rewind past the data that was not sent */
+				(void)fs_seek(file, (off_t)off - len, FS_SEEK_CUR);
+
+				return sent > 0 ? sent : -1;
+			}
+
+			off += ret;
+			sent += ret;
+		}
+	}
+
+	return sent;
+}
+
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	off_t saved_pos = 0;
+	void *obj;
+	ssize_t ret;
+
+	if (file == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendto == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (offset != NULL) {
+		saved_pos = fs_tell(file);
+		if (saved_pos < 0) {
+			errno = -saved_pos;
+			return -1;
+		}
+
+		ret = fs_seek(file, *offset, FS_SEEK_SET);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) && vtable == &sock_fd_op_vtable &&
+	    net_context_get_type(obj) == SOCK_STREAM &&
+	    !net_if_is_ip_offloaded(net_context_get_iface(obj))) {
+		ret = sendfile_tcp(obj, file, count);
+	} else {
+		ret = sendfile_copy(obj, vtable, file, count);
+	}
+
+	k_mutex_unlock(lock);
+
+	if (offset != NULL) {
+		if (ret > 0) {
+			*offset += ret;
+		}
+
+		/* The file position is left untouched when offset is given */
+		(void)fs_seek(file, saved_pos, FS_SEEK_SET);
+	}
+
+	sock_obj_core_update_send_stats(sock, ret);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -2020,6 +2224,259 @@ fail:
 #include <syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+/* Stream data lent out by zsock_recv_zc(). The receive window is opened
+ * only once the buffers are released, so that a slow consumer holding on
+ * to them does not let the peer fill up the RX buffer pool.
+ */
+struct recv_zc_loan {
+	struct net_buf *frags;
+	struct net_context *ctx;
+	size_t len;
+};
+
+static struct recv_zc_loan recv_zc_loans[CONFIG_NET_SOCKETS_RECV_ZEROCOPY_MAX_LOANS];
+static struct k_spinlock recv_zc_lock;
+
+/* Marks a loan taken by a zsock_recv_zc() call that is still running */
+#define ZSOCK_RECV_ZC_LOAN_RESERVED ((struct net_buf *)recv_zc_loans)
+
+static struct recv_zc_loan *recv_zc_loan_find(struct net_buf *frags)
+{
+	ARRAY_FOR_EACH_PTR(recv_zc_loans, loan) {
+		if (loan->frags == frags) {
+			return loan;
+		}
+	}
+
+	return NULL;
+}
+
+/* Fill in a reserved loan, or give it back if no buffers were lent */
+static void recv_zc_loan_commit(struct recv_zc_loan *loan, struct net_buf *frags,
+				struct net_context *ctx, size_t len)
+{
+	k_spinlock_key_t key;
+
+	if (loan == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&recv_zc_lock);
+
+	loan->frags = frags;
+	loan->ctx = frags != NULL ? ctx : NULL;
+	loan->len = len;
+
+	k_spin_unlock(&recv_zc_lock, key);
+}
+
+/* Take the unread data of the packet out of it, the headers and any data
+ * already consumed through the cursor are dropped from the front.
+ */
+static struct net_buf *zsock_pkt_detach_data(struct net_pkt *pkt, size_t *len)
+{
+	size_t remaining = net_pkt_remaining_data(pkt);
+	size_t skip = net_pkt_get_len(pkt) - remaining;
+	struct net_buf *frags = pkt->buffer;
+
+	pkt->buffer = NULL;
+	net_pkt_cursor_init(pkt);
+	net_pkt_unref(pkt);
+
+	while (frags != NULL && skip >= frags->len) {
+		struct net_buf *next = frags->frags;
+
+		skip -= frags->len;
+		frags->frags = NULL;
+		net_buf_unref(frags);
+		frags = next;
+	}
+
+	if (frags != NULL && skip > 0) {
+		net_buf_pull(frags, skip);
+	}
+
+	*len = remaining;
+
+	return frags;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx, struct net_buf **frags,
+				 int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	struct recv_zc_loan *loan = NULL;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
+
+	*frags = NULL;
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (!net_context_is_used(ctx)) {
+			errno = EBADF;
+			return -1;
+		}
+
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		k_spinlock_key_t key = k_spin_lock(&recv_zc_lock);
+
+		/* Reserve the loan before taking the data off the queue */
+		loan = recv_zc_loan_find(NULL);
+		if (loan != NULL) {
+			loan->frags = ZSOCK_RECV_ZC_LOAN_RESERVED;
+		}
+
+		k_spin_unlock(&recv_zc_lock, key);
+
+		if (loan == NULL) {
+			errno = ENOBUFS;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (pkt == NULL) {
+		recv_zc_loan_commit(loan, NULL, NULL, 0);
+
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	*frags = zsock_pkt_detach_data(pkt, &len);
+
+	if (loan != NULL && *frags != NULL) {
+		/* Keep the context around until the window is updated */
+		net_context_ref(ctx);
+	}
+
+	recv_zc_loan_commit(loan, *frags, ctx, len);
+
+	return len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *ctx;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only native sockets queue net_pkts that can be lent out */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_zc_ctx(ctx, frags, flags);
+
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+void zsock_recv_zc_release(struct net_buf *frags)
+{
+	struct recv_zc_loan *loan;
+	struct net_context *ctx = NULL;
+	k_spinlock_key_t key;
+	size_t len = 0;
+
+	if (frags == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&recv_zc_lock);
+
+	loan = recv_zc_loan_find(frags);
+	if (loan != NULL) {
+		ctx = loan->ctx;
+		len = loan->len;
+		loan->ctx = NULL;
+		loan->frags = NULL;
+	}
+
+	k_spin_unlock(&recv_zc_lock, key);
+
+	net_buf_unref(frags);
+
+	if (ctx != NULL) {
+#if defined(CONFIG_NET_TCP)
+		/* The connection may have been closed meanwhile */
+		if (ctx->tcp != NULL) {
+			net_context_update_recv_wnd(ctx, len);
+		}
+#endif
+
+		net_context_unref(ctx);
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2611,6 +3068,15 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CORK:
+			ret = net_tcp_get_option(ctx, TCP_OPT_CORK, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -3164,6 +3630,16 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CORK:
+			ret = net_tcp_set_option(ctx,
+						 TCP_OPT_CORK, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
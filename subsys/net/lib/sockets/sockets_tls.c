@@ -47,6 +47,8 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
+#include <mbedtls/platform_util.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -107,6 +109,9 @@ struct tls_session_cache {
 	/** Peer address. */
 	struct sockaddr peer_addr;
 
+	/** Peer hostname, NULL if the session is stored per address. */
+	char *hostname;
+
 	/** Session buffer. */
 	uint8_t *session;
 
@@ -254,6 +259,15 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Set up once and never freed, as the configs of open sockets refer to it.
+ * The lock serializes ticket use with key rotation.
+ */
+static mbedtls_ssl_ticket_context server_ticket;
+static bool server_ticket_ready;
+static struct k_mutex server_ticket_lock;
+#endif
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -268,6 +282,10 @@ static void tls_session_cache_reset(void)
 		if (client_cache[i].session != NULL) {
 			mbedtls_free(client_cache[i].session);
 		}
+
+		if (client_cache[i].hostname != NULL) {
+			mbedtls_free(client_cache[i].hostname);
+		}
 	}
 
 	(void)memset(client_cache, 0, sizeof(client_cache));
@@ -373,6 +391,10 @@ static int tls_init(void)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	k_mutex_init(&server_ticket_lock);
+#endif
+
 	return 0;
 }
 
@@ -571,7 +593,40 @@ static bool peer_addr_cmp(const struct sockaddr *addr,
 	return false;
 }
 
+static uint16_t peer_port_get(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return net_sin6(addr)->sin6_port;
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && addr->sa_family == AF_INET) {
+		return net_sin(addr)->sin_port;
+	}
+
+	return 0;
+}
+
+static bool tls_session_match(const struct tls_session_cache *entry,
+			      const struct sockaddr *peer_addr,
+			      const char *hostname)
+{
+	if (entry->session == NULL) {
+		return false;
+	}
+
+	/* A session belongs to the server identity, which may be reachable
+	 * at several addresses.
+	 */
+	if (hostname != NULL) {
+		return entry->hostname != NULL &&
+		       strcmp(entry->hostname, hostname) == 0 &&
+		       peer_port_get(&entry->peer_addr) == peer_port_get(peer_addr);
+	}
+
+	return entry->hostname == NULL &&
+	       peer_addr_cmp(&entry->peer_addr, peer_addr);
+}
+
 static int tls_session_save(const struct sockaddr *peer_addr,
+			    const char *hostname,
 			    mbedtls_ssl_session *session)
 {
 	struct tls_session_cache *entry = NULL;
@@ -585,8 +640,8 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 				entry = &client_cache[i];
 			}
 		} else {
-			if (peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
-				/* Reuse old entry for given address. */
+			if (tls_session_match(&client_cache[i], peer_addr, hostname)) {
+				/* Reuse old entry for given peer. */
 				entry = &client_cache[i];
 				break;
 			}
@@ -607,6 +662,21 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 		entry->session = NULL;
 	}
 
+	if (entry->hostname != NULL) {
+		mbedtls_free(entry->hostname);
+		entry->hostname = NULL;
+	}
+
+	if (hostname != NULL) {
+		entry->hostname = mbedtls_calloc(1, strlen(hostname) + 1);
+		if (entry->hostname == NULL) {
+			NET_ERR("Failed to allocate session hostname.");
+			return -ENOMEM;
+		}
+
+		strcpy(entry->hostname, hostname);
+	}
+
 	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
 
 	entry->session = mbedtls_calloc(1, session_len);
@@ -632,14 +702,14 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 }
 
 static int tls_session_get(const struct sockaddr *peer_addr,
+			   const char *hostname,
 			   mbedtls_ssl_session *session)
 {
 	struct tls_session_cache *entry = NULL;
 	int ret;
 
 	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
-		if (client_cache[i].session != NULL &&
-		    peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
+		if (tls_session_match(&client_cache[i], peer_addr, hostname)) {
 			entry = &client_cache[i];
 			break;
 		}
@@ -662,6 +732,19 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 	return 0;
 }
 
+/* Hostname the client sessions of a context are stored under, if any. */
+static const char *tls_session_hostname(struct tls_context *context)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (context->options.is_hostname_set && context->ssl.hostname != NULL &&
+	    context->ssl.hostname[0] != '\0') {
+		return context->ssl.hostname;
+	}
+#endif
+
+	return NULL;
+}
+
 static void tls_session_store(struct tls_context *context,
 			      const struct sockaddr *addr,
 			      socklen_t addrlen)
@@ -683,7 +766,7 @@ static void tls_session_store(struct tls_context *context,
 		goto exit;
 	}
 
-	ret = tls_session_save(&peer_addr, &session);
+	ret = tls_session_save(&peer_addr, tls_session_hostname(context), &session);
 	if (ret < 0) {
 		NET_ERR("Failed to save session for %p", context);
 	}
@@ -707,7 +790,7 @@ static void tls_session_restore(struct tls_context *context,
 	memcpy(&peer_addr, addr, addrlen);
 	mbedtls_ssl_session_init(&session);
 
-	ret = tls_session_get(&peer_addr, &session);
+	ret = tls_session_get(&peer_addr, tls_session_hostname(context), &session);
 	if (ret < 0) {
 		NET_DBG("Session not found for %p", context);
 		goto exit;
@@ -722,6 +805,95 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Set up the session ticket key on first use, as the RNG may not be
+ * usable yet when TLS is initialized.
+ */
+static bool tls_session_ticket_ready(void)
+{
+	int ret;
+
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+
+	if (!server_ticket_ready) {
+		mbedtls_ssl_ticket_init(&server_ticket);
+
+		ret = mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random, NULL,
+					       MBEDTLS_CIPHER_AES_256_GCM,
+					       CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+		if (ret != 0) {
+			NET_ERR("Failed to set up session tickets, err: -0x%x.", -ret);
+			mbedtls_ssl_ticket_free(&server_ticket);
+		} else {
+			server_ticket_ready = true;
+		}
+	}
+
+	k_mutex_unlock(&server_ticket_lock);
+
+	return server_ticket_ready;
+}
+
+static int tls_session_ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+				    unsigned char *start, const unsigned char *end,
+				    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen, lifetime);
+	k_mutex_unlock(&server_ticket_lock);
+
+	return ret;
+}
+
+static int tls_session_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+				    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&server_ticket_lock);
+
+	return ret;
+}
+
+/* Invalidate the issued tickets by replacing the ticket keys. mbedTLS
+ * keeps the previous key to parse the tickets issued with it, so both key
+ * slots are replaced.
+ */
+static void tls_session_ticket_rotate(void)
+{
+	unsigned char name[MBEDTLS_SSL_TICKET_KEY_NAME_BYTES];
+	unsigned char key[MBEDTLS_SSL_TICKET_MAX_KEY_BYTES];
+	int ret = 0;
+
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+
+	for (int i = 0; server_ticket_ready && ret == 0 && i < 2; i++) {
+		ret = tls_ctr_drbg_random(NULL, name, sizeof(name));
+		if (ret == 0) {
+			ret = tls_ctr_drbg_random(NULL, key, sizeof(key));
+		}
+
+		if (ret == 0) {
+			ret = mbedtls_ssl_ticket_rotate(&server_ticket, name, sizeof(name),
+							key, sizeof(key),
+							CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+		}
+	}
+
+	k_mutex_unlock(&server_ticket_lock);
+
+	mbedtls_platform_zeroize(key, sizeof(key));
+
+	if (ret != 0) {
+		NET_ERR("Failed to rotate session ticket keys, err: -0x%x.", -ret);
+	}
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static void tls_session_purge(void)
 {
 	tls_session_cache_reset();
@@ -730,6 +902,10 @@ static void tls_session_purge(void)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	tls_session_ticket_rotate();
+#endif
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -1421,6 +1597,25 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+	if (!is_server) {
+		/* Tickets are only useful if the session is cached. */
+		mbedtls_ssl_conf_session_tickets(&context->config,
+						 context->options.cache_enabled ?
+						 MBEDTLS_SSL_SESSION_TICKETS_ENABLED :
+						 MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+	}
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.cache_enabled && tls_session_ticket_ready()) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    tls_session_ticket_write,
+						    tls_session_ticket_parse,
+						    &server_ticket);
+	}
+#endif
+
 	ret = mbedtls_ssl_setup(&context->ssl,
 				&context->config);
 	if (ret != 0) {
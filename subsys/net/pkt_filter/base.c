@@ -11,6 +11,8 @@ LOG_MODULE_REGISTER(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 #include <zephyr/net/net_pkt_filter.h>
 #include <zephyr/spinlock.h>
 
+#include "compile.h"
+
 /*
  * Our actual rule lists for supported test points
  */
@@ -121,8 +123,15 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 
 static enum net_verdict lock_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
+	enum net_verdict result;
+
+	if (npf_program_evaluate(rules, pkt, &result)) {
+		return result;
+	}
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	enum net_verdict result = evaluate(&rules->rule_head, pkt);
+
+	result = evaluate(&rules->rule_head, pkt);
 
 	k_spin_unlock(&rules->lock, key);
 	return result;
@@ -171,14 +180,42 @@ bool net_pkt_filter_ip_recv_ok(struct net_pkt *pkt)
  * Rule management
  */
 
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+/* Serializes the rule list updates and their compilation */
+static K_MUTEX_DEFINE(update_lock);
+
+static void update_begin(void)
+{
+	k_mutex_lock(&update_lock, K_FOREVER);
+}
+
+static void update_end(struct npf_rule_list *rules)
+{
+	npf_compile(rules);
+	k_mutex_unlock(&update_lock);
+}
+#else
+static inline void update_begin(void)
+{
+}
+
+static inline void update_end(struct npf_rule_list *rules)
+{
+	ARG_UNUSED(rules);
+}
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
 void npf_insert_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 {
+	update_begin();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 
 	NET_DBG("inserting rule %p into %p", rule, rules);
 	sys_slist_prepend(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+	update_end(rules);
 }
 
 void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
@@ -186,26 +223,34 @@ void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	__ASSERT(sys_slist_peek_tail(&rules->rule_head) != &npf_default_ok.node, "");
 	__ASSERT(sys_slist_peek_tail(&rules->rule_head) != &npf_default_drop.node, "");
 
+	update_begin();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 
 	NET_DBG("appending rule %p into %p", rule, rules);
 	sys_slist_append(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+	update_end(rules);
 }
 
 bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 {
+	update_begin();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	bool result = sys_slist_find_and_remove(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+	update_end(rules);
 	NET_DBG("removing rule %p from %p: %d", rule, rules, result);
 	return result;
 }
 
 bool npf_remove_all_rules(struct npf_rule_list *rules)
 {
+	update_begin();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	bool result = !sys_slist_is_empty(&rules->rule_head);
 
@@ -215,9 +260,17 @@ bool npf_remove_all_rules(struct npf_rule_list *rules)
 	}
 
 	k_spin_unlock(&rules->lock, key);
+	update_end(rules);
 	return result;
 }
 
+void npf_update_rules(struct npf_rule_list *rules)
+{
+	update_begin();
+	NET_DBG("updating rules %p", rules);
+	update_end(rules);
+}
+
 /*
  * Default rule list terminations.
  */
@@ -0,0 +1,663 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(npf_compile, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+#include "compile.h"
+
+/*
+ * A rule list is compiled into a program: an array of instructions, one
+ * per rule condition followed by one giving the verdict of the rule.
+ * When a condition is false, evaluation jumps to the first instruction of
+ * the next rule.
+ *
+ * Conditions testing a packet field against a set of values (interface,
+ * source IP address, ethernet address and type) are compiled into hash
+ * sets. Consecutive rules made of a single such condition on the same
+ * field are merged into one hash lookup giving the verdict of the first
+ * of these rules matching the packet.
+ *
+ * The packet path evaluates the current program without taking a lock.
+ * Each rule list has two program slots: a new program is published in the
+ * unused slot, then the old one is freed once all the evaluations started
+ * on it are done.
+ */
+
+enum npf_op {
+	NPF_OP_CALL,		/* call the test function */
+	NPF_OP_SIZE,		/* packet size within bounds */
+	NPF_OP_MATCH,		/* packet field in set */
+	NPF_OP_LOOKUP,		/* verdict of the packet field from set */
+	NPF_OP_VERDICT,		/* all the rule conditions are true */
+};
+
+enum npf_key {
+	NPF_KEY_IFACE,
+	NPF_KEY_ORIG_IFACE,
+	NPF_KEY_IP_SRC,
+	NPF_KEY_ETH_SRC,
+	NPF_KEY_ETH_DST,
+	NPF_KEY_ETH_TYPE,
+};
+
+struct npf_set {
+	uint8_t key;		/* enum npf_key */
+	uint8_t key_len;
+	uint16_t mask;		/* number of slots - 1 */
+	uint16_t nb_keys;
+	uint16_t *slots;	/* 1 + index in keys, 0 if empty */
+	uint8_t *keys;		/* key_len bytes per key */
+	uint8_t *verdicts;	/* verdict of each key, for NPF_OP_LOOKUP */
+};
+
+struct npf_insn {
+	uint8_t op;		/* enum npf_op */
+	bool negate;
+	uint16_t fail;		/* next instruction if the condition is false */
+	union {
+		struct npf_test *test;
+		struct npf_test_size_bounds *bounds;
+		struct npf_set *set;
+		enum net_verdict result;
+	};
+};
+
+struct npf_program {
+	uint16_t nb_insns;
+	struct npf_insn insns[];
+};
+
+/* Program of an empty rule list, accepting all the packets */
+static struct npf_program empty_program;
+
+K_HEAP_DEFINE(npf_program_heap, CONFIG_NET_PKT_FILTER_PROGRAM_HEAP_SIZE);
+
+/*
+ * Key extraction
+ */
+
+struct npf_key_desc {
+	enum npf_key key;
+	bool negate;
+	uint8_t key_len;
+	uint16_t nb_keys;
+	size_t stride;
+	const uint8_t *keys;
+};
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+static bool eth_mask_is_full(const struct net_eth_addr *mask)
+{
+	for (int i = 0; i < sizeof(mask->addr); i++) {
+		if (mask->addr[i] != 0xff) {
+			return false;
+		}
+	}
+
+	return true;
+}
+#endif
+
+/* Describe the values a test compares a packet field against, if it is
+ * one that can be turned into a set lookup.
+ */
+static bool test_to_key(struct npf_test *test, struct npf_key_desc *desc)
+{
+	desc->negate = false;
+	desc->nb_keys = 1;
+
+	if (test->fn == npf_iface_match || test->fn == npf_iface_unmatch ||
+	    test->fn == npf_orig_iface_match || test->fn == npf_orig_iface_unmatch) {
+		struct npf_test_iface *test_iface =
+			CONTAINER_OF(test, struct npf_test_iface, test);
+
+		desc->key = (test->fn == npf_iface_match || test->fn == npf_iface_unmatch) ?
+			NPF_KEY_IFACE : NPF_KEY_ORIG_IFACE;
+		desc->negate = test->fn == npf_iface_unmatch ||
+			       test->fn == npf_orig_iface_unmatch;
+		desc->key_len = sizeof(test_iface->iface);
+		desc->stride = sizeof(test_iface->iface);
+		desc->keys = (const uint8_t *)&test_iface->iface;
+
+		return true;
+	}
+
+	if (test->fn == npf_ip_src_addr_match || test->fn == npf_ip_src_addr_unmatch) {
+		struct npf_test_ip *test_ip = CONTAINER_OF(test, struct npf_test_ip, test);
+
+		if (test_ip->addr_family == AF_INET) {
+			desc->key_len = sizeof(struct in_addr);
+		} else if (test_ip->addr_family == AF_INET6) {
+			desc->key_len = sizeof(struct in6_addr);
+		} else {
+			return false;
+		}
+
+		if (test_ip->ipaddr_num > UINT16_MAX) {
+			return false;
+		}
+
+		desc->key = NPF_KEY_IP_SRC;
+		desc->negate = test->fn == npf_ip_src_addr_unmatch;
+		desc->nb_keys = test_ip->ipaddr_num;
+		desc->stride = desc->key_len;
+		desc->keys = test_ip->ipaddr;
+
+		return true;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (test->fn == npf_eth_src_addr_match || test->fn == npf_eth_src_addr_unmatch ||
+	    test->fn == npf_eth_dst_addr_match || test->fn == npf_eth_dst_addr_unmatch) {
+		struct npf_test_eth_addr *test_eth =
+			CONTAINER_OF(test, struct npf_test_eth_addr, test);
+
+		/* Masked addresses are left to the test function */
+		if (!eth_mask_is_full(&test_eth->mask) || test_eth->nb_addresses > UINT16_MAX) {
+			return false;
+		}
+
+		desc->key = (test->fn == npf_eth_src_addr_match ||
+			     test->fn == npf_eth_src_addr_unmatch) ?
+			NPF_KEY_ETH_SRC : NPF_KEY_ETH_DST;
+		desc->negate = test->fn == npf_eth_src_addr_unmatch ||
+			       test->fn == npf_eth_dst_addr_unmatch;
+		desc->nb_keys = test_eth->nb_addresses;
+		desc->key_len = sizeof(struct net_eth_addr);
+		desc->stride = sizeof(struct net_eth_addr);
+		desc->keys = (const uint8_t *)test_eth->addresses;
+
+		return true;
+	}
+
+	if (test->fn == npf_eth_type_match || test->fn == npf_eth_type_unmatch) {
+		struct npf_test_eth_type *test_type =
+			CONTAINER_OF(test, struct npf_test_eth_type, test);
+
+		desc->key = NPF_KEY_ETH_TYPE;
+		desc->negate = test->fn == npf_eth_type_unmatch;
+		desc->key_len = sizeof(test_type->type);
+		desc->stride = sizeof(test_type->type);
+		desc->keys = (const uint8_t *)&test_type->type;
+
+		return true;
+	}
+#endif /* CONFIG_NET_L2_ETHERNET */
+
+	return false;
+}
+
+/* Get the packet field tested by a set, storage is used for the fields
+ * that are not in the packet data.
+ */
+static const uint8_t *pkt_key(enum npf_key key, struct net_pkt *pkt, size_t *len,
+			      struct net_if **storage)
+{
+	switch (key) {
+	case NPF_KEY_IFACE:
+		*storage = net_pkt_iface(pkt);
+		*len = sizeof(*storage);
+		return (const uint8_t *)storage;
+	case NPF_KEY_ORIG_IFACE:
+		*storage = net_pkt_orig_iface(pkt);
+		*len = sizeof(*storage);
+		return (const uint8_t *)storage;
+	case NPF_KEY_IP_SRC:
+		if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+			*len = sizeof(struct in_addr);
+			return NET_IPV4_HDR(pkt)->src;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+			*len = sizeof(struct in6_addr);
+			return NET_IPV6_HDR(pkt)->src;
+		}
+
+		return NULL;
+	case NPF_KEY_ETH_SRC:
+		*len = sizeof(struct net_eth_addr);
+		return NET_ETH_HDR(pkt)->src.addr;
+	case NPF_KEY_ETH_DST:
+		*len = sizeof(struct net_eth_addr);
+		return NET_ETH_HDR(pkt)->dst.addr;
+	case NPF_KEY_ETH_TYPE:
+		*len = sizeof(NET_ETH_HDR(pkt)->type);
+		return (const uint8_t *)&NET_ETH_HDR(pkt)->type;
+	}
+
+	return NULL;
+}
+
+/*
+ * Hash sets
+ */
+
+static uint32_t key_hash(const uint8_t *key, size_t len)
+{
+	uint32_t hash = 2166136261U;
+
+	while (len-- > 0) {
+		hash = (hash ^ *key++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static int set_find(const struct npf_set *set, const uint8_t *key, size_t len)
+{
+	uint32_t i;
+
+	if (len != set->key_len) {
+		return -1;
+	}
+
+	/* No need to hash for a single key */
+	if (set->nb_keys == 1) {
+		return memcmp(set->keys, key, len) == 0 ? 0 : -1;
+	}
+
+	for (i = key_hash(key, len) & set->mask; set->slots[i] != 0;
+	     i = (i + 1) & set->mask) {
+		int idx = set->slots[i] - 1;
+
+		if (memcmp(&set->keys[idx * len], key, len) == 0) {
+			return idx;
+		}
+	}
+
+	return -1;
+}
+
+/* Keep the first verdict of a key found in several rules */
+static void set_add(struct npf_set *set, const uint8_t *key, enum net_verdict verdict)
+{
+	uint32_t i;
+
+	if (set_find(set, key, set->key_len) >= 0) {
+		return;
+	}
+
+	for (i = key_hash(key, set->key_len) & set->mask; set->slots[i] != 0;
+	     i = (i + 1) & set->mask) {
+	}
+
+	memcpy(&set->keys[set->nb_keys * set->key_len], key, set->key_len);
+	set->verdicts[set->nb_keys] = verdict;
+	set->slots[i] = ++set->nb_keys;
+}
+
+/*
+ * Compilation
+ */
+
+struct npf_builder {
+	struct npf_program *prog;	/* NULL when sizing the program */
+	uint8_t *data;			/* set storage, after the instructions */
+	size_t data_len;
+	size_t nb_insns;
+};
+
+static void *builder_alloc(struct npf_builder *b, size_t size, size_t align)
+{
+	void *ptr;
+
+	b->data_len = ROUND_UP(b->data_len, align);
+	ptr = b->prog != NULL ? &b->data[b->data_len] : NULL;
+	b->data_len += size;
+
+	return ptr;
+}
+
+static struct npf_insn *builder_insn(struct npf_builder *b, enum npf_op op)
+{
+	struct npf_insn *insn = NULL;
+
+	if (b->prog != NULL) {
+		insn = &b->prog->insns[b->nb_insns];
+		insn->op = op;
+		insn->negate = false;
+	}
+
+	b->nb_insns++;
+
+	return insn;
+}
+
+static struct npf_set *builder_set(struct npf_builder *b, const struct npf_key_desc *desc,
+				   size_t nb_keys)
+{
+	size_t nb_slots = 1;
+	struct npf_set *set;
+	uint16_t *slots;
+	uint8_t *keys, *verdicts;
+
+	/* At most half full, so that lookups always find an empty slot */
+	while (nb_slots < 2 * nb_keys) {
+		nb_slots <<= 1;
+	}
+
+	set = builder_alloc(b, sizeof(*set), __alignof__(struct npf_set));
+	slots = builder_alloc(b, nb_slots * sizeof(uint16_t), __alignof__(uint16_t));
+	keys = builder_alloc(b, nb_keys * desc->key_len, 1);
+	verdicts = builder_alloc(b, nb_keys, 1);
+
+	if (set != NULL) {
+		set->key = desc->key;
+		set->key_len = desc->key_len;
+		set->mask = nb_slots - 1;
+		set->nb_keys = 0;
+		set->slots = slots;
+		set->keys = keys;
+		set->verdicts = verdicts;
+		memset(slots, 0, nb_slots * sizeof(uint16_t));
+	}
+
+	return set;
+}
+
+static void set_add_keys(struct npf_set *set, const struct npf_key_desc *desc,
+			 enum net_verdict verdict)
+{
+	for (int i = 0; i < desc->nb_keys; i++) {
+		set_add(set, &desc->keys[i * desc->stride], verdict);
+	}
+}
+
+/* A rule with a single, non negated, set condition can be merged with the
+ * following ones testing the same packet field.
+ */
+static bool rule_to_key(struct npf_rule *rule, struct npf_key_desc *desc)
+{
+	return rule->nb_tests == 1 && test_to_key(rule->tests[0], desc) && !desc->negate;
+}
+
+static struct npf_rule *next_rule(struct npf_rule *rule)
+{
+	return SYS_SLIST_PEEK_NEXT_CONTAINER(rule, node);
+}
+
+static bool same_key(const struct npf_key_desc *a, const struct npf_key_desc *b)
+{
+	return a->key == b->key && a->key_len == b->key_len;
+}
+
+/* Merge first and the following rules testing the same packet field into
+ * a lookup, returns the rule after the merged ones.
+ */
+static struct npf_rule *compile_lookup(struct npf_builder *b, struct npf_rule *first,
+				       const struct npf_key_desc *first_desc)
+{
+	struct npf_key_desc desc;
+	struct npf_rule *rule, *end;
+	struct npf_insn *insn;
+	struct npf_set *set;
+	size_t nb_keys = 0;
+
+	for (end = first; end != NULL; end = next_rule(end)) {
+		if (!rule_to_key(end, &desc) || !same_key(&desc, first_desc) ||
+		    nb_keys + desc.nb_keys > UINT16_MAX) {
+			break;
+		}
+
+		nb_keys += desc.nb_keys;
+	}
+
+	insn = builder_insn(b, NPF_OP_LOOKUP);
+	set = builder_set(b, first_desc, nb_keys);
+
+	if (insn != NULL) {
+		for (rule = first; rule != end; rule = next_rule(rule)) {
+			rule_to_key(rule, &desc);
+			set_add_keys(set, &desc, rule->result);
+		}
+
+		insn->set = set;
+		insn->fail = b->nb_insns;
+	}
+
+	return end;
+}
+
+static void compile_rule(struct npf_builder *b, struct npf_rule *rule)
+{
+	size_t first = b->nb_insns;
+	struct npf_key_desc desc;
+	struct npf_insn *insn;
+
+	for (int i = 0; i < rule->nb_tests; i++) {
+		struct npf_test *test = rule->tests[i];
+
+		if (test_to_key(test, &desc)) {
+			struct npf_set *set;
+
+			insn = builder_insn(b, NPF_OP_MATCH);
+			set = builder_set(b, &desc, desc.nb_keys);
+
+			if (set != NULL) {
+				set_add_keys(set, &desc, rule->result);
+				insn->set = set;
+				insn->negate = desc.negate;
+			}
+		} else if (test->fn == npf_size_inbounds) {
+			insn = builder_insn(b, NPF_OP_SIZE);
+			if (insn != NULL) {
+				insn->bounds = CONTAINER_OF(test, struct npf_test_size_bounds,
+							    test);
+			}
+		} else {
+			insn = builder_insn(b, NPF_OP_CALL);
+			if (insn != NULL) {
+				insn->test = test;
+			}
+		}
+	}
+
+	insn = builder_insn(b, NPF_OP_VERDICT);
+	if (insn != NULL) {
+		insn->result = rule->result;
+	}
+
+	/* Conditions jump to the next rule when they are false */
+	if (b->prog != NULL) {
+		for (size_t i = first; i < b->nb_insns; i++) {
+			b->prog->insns[i].fail = b->nb_insns;
+		}
+	}
+}
+
+static void compile_rules(struct npf_builder *b, sys_slist_t *rule_head)
+{
+	struct npf_rule *rule = SYS_SLIST_PEEK_HEAD_CONTAINER(rule_head, rule, node);
+	struct npf_key_desc desc, next_desc;
+
+	while (rule != NULL) {
+		struct npf_rule *next = next_rule(rule);
+
+		if (next != NULL && rule_to_key(rule, &desc) &&
+		    rule_to_key(next, &next_desc) && same_key(&desc, &next_desc)) {
+			rule = compile_lookup(b, rule, &desc);
+		} else if (rule->nb_tests == 0) {
+			/* The rules after an unconditional one are never reached */
+			compile_rule(b, rule);
+			break;
+		} else {
+			compile_rule(b, rule);
+			rule = next_rule(rule);
+		}
+	}
+}
+
+static struct npf_program *compile(sys_slist_t *rule_head)
+{
+	struct npf_builder b = { 0 };
+	struct npf_program *prog;
+	size_t insns_len;
+
+	if (sys_slist_is_empty(rule_head)) {
+		return &empty_program;
+	}
+
+	/* First pass to size the program, second one to build it */
+	compile_rules(&b, rule_head);
+
+	if (b.nb_insns > UINT16_MAX) {
+		return NULL;
+	}
+
+	insns_len = ROUND_UP(sizeof(struct npf_program) + b.nb_insns * sizeof(struct npf_insn),
+			     sizeof(void *));
+
+	prog = k_heap_alloc(&npf_program_heap, insns_len + b.data_len, K_NO_WAIT);
+	if (prog == NULL) {
+		return NULL;
+	}
+
+	b.prog = prog;
+	b.data = (uint8_t *)prog + insns_len;
+	b.data_len = 0;
+	b.nb_insns = 0;
+
+	compile_rules(&b, rule_head);
+	prog->nb_insns = b.nb_insns;
+
+	return prog;
+}
+
+static void program_free(struct npf_program *prog)
+{
+	if (prog != NULL && prog != &empty_program) {
+		k_heap_free(&npf_program_heap, prog);
+	}
+}
+
+void npf_compile(struct npf_rule_list *rules)
+{
+	struct npf_program *prog;
+	atomic_val_t old;
+
+	prog = compile(&rules->rule_head);
+	if (prog == NULL) {
+		NET_WARN("Cannot compile rules %p, evaluating them uncompiled", rules);
+	} else {
+		NET_DBG("rules %p compiled into %u instructions", rules, prog->nb_insns);
+	}
+
+	old = atomic_get(&rules->active);
+	rules->programs[old ^ 1] = prog;
+	atomic_set(&rules->active, old ^ 1);
+
+	/* Wait for the evaluations still using the old program */
+	while (atomic_get(&rules->readers[old]) != 0) {
+		k_sleep(K_TICKS(1));
+	}
+
+	program_free(rules->programs[old]);
+	rules->programs[old] = NULL;
+}
+
+/*
+ * Evaluation
+ */
+
+static bool run_match(const struct npf_set *set, struct net_pkt *pkt)
+{
+	struct net_if *storage;
+	const uint8_t *key;
+	size_t len;
+
+	key = pkt_key(set->key, pkt, &len, &storage);
+
+	return key != NULL && set_find(set, key, len) >= 0;
+}
+
+static enum net_verdict run(const struct npf_program *prog, struct net_pkt *pkt)
+{
+	uint16_t pc = 0;
+
+	if (prog->nb_insns == 0) {
+		return NET_OK;
+	}
+
+	while (pc < prog->nb_insns) {
+		const struct npf_insn *insn = &prog->insns[pc];
+		bool result;
+
+		switch (insn->op) {
+		case NPF_OP_CALL:
+			result = insn->test->fn(insn->test, pkt);
+			break;
+		case NPF_OP_SIZE: {
+			size_t size = net_pkt_get_len(pkt);
+
+			result = size >= insn->bounds->min && size <= insn->bounds->max;
+			break;
+		}
+		case NPF_OP_MATCH:
+			result = run_match(insn->set, pkt);
+			break;
+		case NPF_OP_LOOKUP: {
+			struct net_if *storage;
+			const uint8_t *key;
+			size_t len;
+			int idx;
+
+			key = pkt_key(insn->set->key, pkt, &len, &storage);
+			idx = key != NULL ? set_find(insn->set, key, len) : -1;
+			if (idx >= 0) {
+				return insn->set->verdicts[idx];
+			}
+
+			pc = insn->fail;
+			continue;
+		}
+		case NPF_OP_VERDICT:
+			return insn->result;
+		default:
+			return NET_DROP;
+		}
+
+		pc = (result != insn->negate) ? pc + 1 : insn->fail;
+	}
+
+	NET_DBG("no matching rules in program %p", prog);
+	return NET_DROP;
+}
+
+bool npf_program_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt,
+			  enum net_verdict *result)
+{
+	const struct npf_program *prog;
+	atomic_val_t idx;
+
+	/* Pin the program in use, retrying if it was replaced meanwhile */
+	while (true) {
+		idx = atomic_get(&rules->active);
+		atomic_inc(&rules->readers[idx]);
+
+		if (atomic_get(&rules->active) == idx) {
+			break;
+		}
+
+		atomic_dec(&rules->readers[idx]);
+	}
+
+	prog = rules->programs[idx];
+	if (prog != NULL) {
+		*result = run(prog, pkt);
+	}
+
+	atomic_dec(&rules->readers[idx]);
+
+	return prog != NULL;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NPF_COMPILE_H
+#define __NPF_COMPILE_H
+
+#include <zephyr/net/net_pkt_filter.h>
+
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+/* Compile the rule list and make the packet path use the new program.
+ * Must be called from a thread, with the rule list update lock held.
+ */
+void npf_compile(struct npf_rule_list *rules);
+
+/* Evaluate the compiled rule list, returns false if there is none. */
+bool npf_program_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt,
+			  enum net_verdict *result);
+#else
+static inline void npf_compile(struct npf_rule_list *rules)
+{
+	ARG_UNUSED(rules);
+}
+
+static inline bool npf_program_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt,
+					enum net_verdict *result)
+{
+	ARG_UNUSED(rules);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(result);
+
+	return false;
+}
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
+#endif /* __NPF_COMPILE_H */
@@ -0,0 +1,285 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief CoAP observers benchmark
+ *
+ * Registers hundreds of observers of one resource of a CoAP service over
+ * the loopback interface, then measures the time taken to notify all of
+ * them, building each notification from the resource notify callback or
+ * building it once with coap_resource_notify_observers(). Run with or
+ * without CONFIG_COAP_SERVER_WORKERS.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_service.h>
+
+#define SERVER_PORT 5683
+#define OBSERVERS CONFIG_COAP_SERVICE_OBSERVERS
+#define ROUNDS 10
+#define RECV_TIMEOUT_MS 1000
+
+static const uint16_t bench_service_port = SERVER_PORT;
+COAP_SERVICE_DEFINE(bench_service, "127.0.0.1", &bench_service_port, COAP_SERVICE_AUTOSTART);
+
+static const char payload[] = "22.5 C";
+
+static int build_notification(struct coap_packet *cpkt, uint8_t *buf, size_t len,
+			      uint8_t type, const uint8_t *token, uint8_t tkl,
+			      uint16_t id, int age)
+{
+	int ret;
+
+	ret = coap_packet_init(cpkt, buf, len, COAP_VERSION_1, type, tkl, token,
+			       COAP_RESPONSE_CODE_CONTENT, id);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, age);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_append_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT,
+				     COAP_CONTENT_FORMAT_TEXT_PLAIN);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_packet_append_payload_marker(cpkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_packet_append_payload(cpkt, payload, sizeof(payload) - 1);
+}
+
+static int obs_get(struct coap_resource *resource, struct coap_packet *request,
+		   struct sockaddr *addr, socklen_t addr_len)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	struct coap_packet response;
+	uint8_t tkl;
+	int ret;
+
+	ret = coap_resource_parse_observe(resource, request, addr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	tkl = coap_header_get_token(request, token);
+
+	ret = build_notification(&response, buf, sizeof(buf), COAP_TYPE_NON_CON, token, tkl,
+				 coap_next_id(), resource->age);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
+
+/* Builds and sends the notification of each observer */
+static void obs_notify(struct coap_resource *resource, struct coap_observer *observer)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet notification;
+	int ret;
+
+	ret = build_notification(&notification, buf, sizeof(buf), COAP_TYPE_NON_CON,
+				 observer->token, observer->tkl, coap_next_id(), resource->age);
+	if (ret < 0) {
+		return;
+	}
+
+	(void)coap_resource_send(resource, &notification, &observer->addr,
+				 sizeof(struct sockaddr_in), NULL);
+}
+
+static const char * const obs_path[] = { "obs", NULL };
+COAP_RESOURCE_DEFINE(obs_resource, bench_service, {
+	.get = obs_get,
+	.notify = obs_notify,
+	.path = obs_path,
+});
+
+SYS_BITARRAY_DEFINE_STATIC(received, OBSERVERS);
+
+static int client_fd = -1;
+
+/* Observers use tokens of different lengths, starting with their index */
+static uint8_t observer_token(int i, uint8_t *token)
+{
+	uint8_t tkl = 2 + i % (COAP_TOKEN_MAX_LEN - 1);
+
+	memset(token, 0xa5, tkl);
+	sys_put_be16(i, token);
+
+	return tkl;
+}
+
+/* Read one message for each observer and check that each got its own */
+static int receive_all(void)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t expected[COAP_TOKEN_MAX_LEN];
+	struct coap_packet cpkt;
+	int prev, ret, i;
+	uint8_t tkl;
+
+	sys_bitarray_clear_region(&received, OBSERVERS, 0);
+
+	for (int count = 0; count < OBSERVERS; count++) {
+		ret = zsock_recv(client_fd, buf, sizeof(buf), 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		ret = coap_packet_parse(&cpkt, buf, ret, NULL, 0);
+		if (ret < 0) {
+			return ret;
+		}
+
+		tkl = coap_header_get_token(&cpkt, token);
+		if (tkl < sizeof(uint16_t)) {
+			return -EBADMSG;
+		}
+
+		i = sys_get_be16(token);
+		if (i >= OBSERVERS || observer_token(i, expected) != tkl ||
+		    memcmp(token, expected, tkl) != 0) {
+			return -EBADMSG;
+		}
+
+		if (coap_header_get_code(&cpkt) != COAP_RESPONSE_CODE_CONTENT ||
+		    coap_get_option_int(&cpkt, COAP_OPTION_OBSERVE) < 0) {
+			return -EBADMSG;
+		}
+
+		sys_bitarray_test_and_set_bit(&received, i, &prev);
+		if (prev != 0) {
+			return -EALREADY;
+		}
+	}
+
+	return 0;
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct zsock_timeval tv = {
+		.tv_sec = RECV_TIMEOUT_MS / 1000,
+	};
+
+	/* Let the server thread start the service. */
+	k_msleep(100);
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	client_fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(client_fd >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)));
+	zassert_ok(zsock_connect(client_fd, (struct sockaddr *)&addr, sizeof(addr)));
+
+	return NULL;
+}
+
+/* Must run first, registers the observers used by the other tests */
+ZTEST(coap_observers, test_0_register)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	struct coap_packet request;
+	uint32_t start, cyc;
+	uint8_t tkl;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < OBSERVERS; i++) {
+		tkl = observer_token(i, token);
+
+		zassert_ok(coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1,
+					    COAP_TYPE_NON_CON, tkl, token, COAP_METHOD_GET,
+					    coap_next_id()));
+		zassert_ok(coap_append_option_int(&request, COAP_OPTION_OBSERVE, 0));
+		zassert_ok(coap_packet_append_option(&request, COAP_OPTION_URI_PATH,
+						     obs_path[0], strlen(obs_path[0])));
+
+		zassert_equal(zsock_send(client_fd, request.data, request.offset, 0),
+			      request.offset, "Cannot send request %d", i);
+	}
+
+	zassert_ok(receive_all(), "Bad responses");
+
+	cyc = k_cycle_get_32() - start;
+
+	zassert_equal(sys_slist_len(&obs_resource.observers), OBSERVERS,
+		      "Not all observers registered");
+
+	TC_PRINT("%d workers, %d observers registered in %llu us\n",
+		 CONFIG_COAP_SERVER_WORKERS, OBSERVERS, k_cyc_to_us_floor64(cyc));
+}
+
+ZTEST(coap_observers, test_1_notify_each)
+{
+	uint32_t start, cyc;
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		zassert_ok(coap_resource_notify(&obs_resource));
+		zassert_ok(receive_all(), "Bad notifications");
+	}
+
+	cyc = k_cycle_get_32() - start;
+
+	TC_PRINT("notify callback: %llu us/notification round\n",
+		 k_cyc_to_us_floor64(cyc) / ROUNDS);
+}
+
+ZTEST(coap_observers, test_2_notify_batched)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet notification;
+	uint32_t start, cyc;
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		obs_resource.age++;
+
+		zassert_ok(build_notification(&notification, buf, sizeof(buf),
+					      COAP_TYPE_NON_CON, NULL, 0, 0, obs_resource.age));
+		zassert_equal(coap_resource_notify_observers(&obs_resource, &notification, NULL),
+			      OBSERVERS, "Not all observers notified");
+		zassert_ok(receive_all(), "Bad notifications");
+	}
+
+	cyc = k_cycle_get_32() - start;
+
+	TC_PRINT("batched: %llu us/notification round\n", k_cyc_to_us_floor64(cyc) / ROUNDS);
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zsock_close(client_fd);
+}
+
+ZTEST_SUITE(coap_observers, NULL, setup, NULL, NULL, teardown);
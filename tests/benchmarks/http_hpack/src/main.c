@@ -0,0 +1,496 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief HPACK benchmark
+ *
+ * Runs the Huffman coder and the header field decoder over the request
+ * and response examples of RFC 7541, Appendix C, checking the results
+ * against the RFC and reporting the time spent per byte. With the dynamic
+ * tables enabled, the header block sequences of the RFC are decoded too,
+ * and the size of repeated responses is compared.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/http/hpack.h>
+
+#define ROUNDS 2000
+
+struct huffman_vector {
+	const char *str;
+	const uint8_t *encoded;
+	size_t encoded_len;
+};
+
+#define VECTOR(_str, ...)						\
+	{								\
+		.str = _str,						\
+		.encoded = (const uint8_t []){ __VA_ARGS__ },		\
+		.encoded_len = sizeof((const uint8_t []){ __VA_ARGS__ }), \
+	}
+
+/* Huffman encoded strings of RFC 7541, C.4 and C.6 */
+static const struct huffman_vector vectors[] = {
+	VECTOR("www.example.com",
+	       0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a, 0x6b, 0xa0, 0xab, 0x90,
+	       0xf4, 0xff),
+	VECTOR("no-cache",
+	       0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf),
+	VECTOR("custom-key",
+	       0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xa9, 0x7d, 0x7f),
+	VECTOR("custom-value",
+	       0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf),
+	VECTOR("302",
+	       0x64, 0x02),
+	VECTOR("private",
+	       0xae, 0xc3, 0x77, 0x1a, 0x4b),
+	VECTOR("Mon, 21 Oct 2013 20:13:21 GMT",
+	       0xd0, 0x7a, 0xbe, 0x94, 0x10, 0x54, 0xd4, 0x44, 0xa8, 0x20,
+	       0x05, 0x95, 0x04, 0x0b, 0x81, 0x66, 0xe0, 0x82, 0xa6, 0x2d,
+	       0x1b, 0xff),
+	VECTOR("https://www.example.com",
+	       0x9d, 0x29, 0xad, 0x17, 0x18, 0x63, 0xc7, 0x8f, 0x0b, 0x97,
+	       0xc8, 0xe9, 0xae, 0x82, 0xae, 0x43, 0xd3),
+	VECTOR("307",
+	       0x64, 0x0e, 0xff),
+	VECTOR("Mon, 21 Oct 2013 20:13:22 GMT",
+	       0xd0, 0x7a, 0xbe, 0x94, 0x10, 0x54, 0xd4, 0x44, 0xa8, 0x20,
+	       0x05, 0x95, 0x04, 0x0b, 0x81, 0x66, 0xe0, 0x84, 0xa6, 0x2d,
+	       0x1b, 0xff),
+	VECTOR("gzip",
+	       0x9b, 0xd9, 0xab),
+	VECTOR("foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1",
+	       0x94, 0xe7, 0x82, 0x1d, 0xd7, 0xf2, 0xe6, 0xc7, 0xb3, 0x35,
+	       0xdf, 0xdf, 0xcd, 0x5b, 0x39, 0x60, 0xd5, 0xaf, 0x27, 0x08,
+	       0x7f, 0x36, 0x72, 0xc1, 0xab, 0x27, 0x0f, 0xb5, 0x29, 0x1f,
+	       0x95, 0x87, 0x31, 0x60, 0x65, 0xc0, 0x03, 0xed, 0x4e, 0xe5,
+	       0xb1, 0x06, 0x3d, 0x50, 0x07),
+};
+
+/* Header blocks of RFC 7541, C.4.1 and C.6.1. These only refer to the
+ * static table, so each field can be decoded on its own.
+ */
+static const uint8_t request_block[] = {
+	0x82, 0x86, 0x84, 0x41, 0x8c, 0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a,
+	0x6b, 0xa0, 0xab, 0x90, 0xf4, 0xff,
+};
+
+static const uint8_t response_block[] = {
+	0x48, 0x82, 0x64, 0x02, 0x58, 0x85, 0xae, 0xc3, 0x77, 0x1a, 0x4b,
+	0x61, 0x96, 0xd0, 0x7a, 0xbe, 0x94, 0x10, 0x54, 0xd4, 0x44, 0xa8,
+	0x20, 0x05, 0x95, 0x04, 0x0b, 0x81, 0x66, 0xe0, 0x82, 0xa6, 0x2d,
+	0x1b, 0xff, 0x6e, 0x91, 0x9d, 0x29, 0xad, 0x17, 0x18, 0x63, 0xc7,
+	0x8f, 0x0b, 0x97, 0xc8, 0xe9, 0xae, 0x82, 0xae, 0x43, 0xd3,
+};
+
+static const char *const request_fields[][2] = {
+	{ ":method", "GET" },
+	{ ":scheme", "http" },
+	{ ":path", "/" },
+	{ ":authority", "www.example.com" },
+};
+
+static const char *const response_fields[][2] = {
+	{ ":status", "302" },
+	{ "cache-control", "private" },
+	{ "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+	{ "location", "https://www.example.com" },
+};
+
+/* Request sequence of RFC 7541, C.4.2 and C.4.3, following C.4.1 */
+static const uint8_t request_block_2[] = {
+	0x82, 0x86, 0x84, 0xbe, 0x58, 0x86, 0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf,
+};
+
+static const uint8_t request_block_3[] = {
+	0x82, 0x87, 0x85, 0xbf, 0x40, 0x88, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xa9,
+	0x7d, 0x7f, 0x89, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf,
+};
+
+static const char *const request_fields_2[][2] = {
+	{ ":method", "GET" },
+	{ ":scheme", "http" },
+	{ ":path", "/" },
+	{ ":authority", "www.example.com" },
+	{ "cache-control", "no-cache" },
+};
+
+static const char *const request_fields_3[][2] = {
+	{ ":method", "GET" },
+	{ ":scheme", "https" },
+	{ ":path", "/index.html" },
+	{ ":authority", "www.example.com" },
+	{ "custom-key", "custom-value" },
+};
+
+/* Dynamic table size update to 256 bytes, used by RFC 7541, C.6 */
+static const uint8_t size_update_256[] = { 0x3f, 0xe1, 0x01 };
+
+/* Response of RFC 7541, C.6.2, following C.6.1 */
+static const uint8_t response_block_2[] = {
+	0x48, 0x83, 0x64, 0x0e, 0xff, 0xc1, 0xc0, 0xbf,
+};
+
+static const char *const response_fields_2[][2] = {
+	{ ":status", "307" },
+	{ "cache-control", "private" },
+	{ "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+	{ "location", "https://www.example.com" },
+};
+
+static uint8_t buf[128];
+static struct http_hpack_header_buf header;
+static struct http_hpack_header_buf peer;
+
+static uint64_t ns_per_byte(uint32_t cycles, size_t bytes)
+{
+	return k_cyc_to_ns_floor64(cycles) / MAX(bytes, 1);
+}
+
+ZTEST(http_hpack_bench, test_huffman)
+{
+	uint32_t start, decode_cyc, encode_cyc;
+	size_t total = 0;
+	int ret;
+
+	ARRAY_FOR_EACH_PTR(vectors, v) {
+		size_t len = strlen(v->str);
+
+		ret = http_hpack_huffman_encode(v->str, len, buf, sizeof(buf));
+		zassert_equal(ret, v->encoded_len, "Bad encoded length for \"%s\"",
+			      v->str);
+		zassert_mem_equal(buf, v->encoded, ret, "Bad encoding for \"%s\"",
+				  v->str);
+
+		ret = http_hpack_huffman_decode(v->encoded, v->encoded_len, buf,
+						sizeof(buf));
+		zassert_equal(ret, len, "Bad decoded length for \"%s\"", v->str);
+		zassert_mem_equal(buf, v->str, len, "Bad decoding for \"%s\"",
+				  v->str);
+
+		total += len;
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		ARRAY_FOR_EACH_PTR(vectors, v) {
+			(void)http_hpack_huffman_decode(v->encoded, v->encoded_len,
+							buf, sizeof(buf));
+		}
+	}
+
+	decode_cyc = k_cycle_get_32() - start;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		ARRAY_FOR_EACH_PTR(vectors, v) {
+			(void)http_hpack_huffman_encode(v->str, strlen(v->str),
+							buf, sizeof(buf));
+		}
+	}
+
+	encode_cyc = k_cycle_get_32() - start;
+
+	TC_PRINT("Huffman, %zu strings, %zu bytes, %d rounds\n",
+		 ARRAY_SIZE(vectors), total, ROUNDS);
+	TC_PRINT("decode %llu ns/byte, encode %llu ns/byte\n",
+		 ns_per_byte(decode_cyc, total * ROUNDS),
+		 ns_per_byte(encode_cyc, total * ROUNDS));
+}
+
+ZTEST(http_hpack_bench, test_huffman_all_symbols)
+{
+	uint8_t str[256];
+	uint8_t encoded[1024];
+	int ret;
+
+	for (int i = 0; i < sizeof(str); i++) {
+		str[i] = i;
+	}
+
+	ret = http_hpack_huffman_encode(str, sizeof(str), encoded,
+					sizeof(encoded));
+	zassert_true(ret > 0, "Encoding failed (%d)", ret);
+
+	ret = http_hpack_huffman_decode(encoded, ret, buf, sizeof(buf));
+	zassert_equal(ret, -ENOBUFS, "Decoding to a short buffer did not fail");
+
+	ret = http_hpack_huffman_encode(str, sizeof(str), encoded,
+					sizeof(encoded));
+	ret = http_hpack_huffman_decode(encoded, ret, str, sizeof(str));
+	zassert_equal(ret, sizeof(str), "Bad decoded length (%d)", ret);
+
+	for (int i = 0; i < sizeof(str); i++) {
+		zassert_equal(str[i], i, "Bad symbol %d", i);
+	}
+
+	/* EOS (30 bits of ones) must not appear in a string */
+	memset(encoded, 0xff, 4);
+	ret = http_hpack_huffman_decode(encoded, 4, buf, sizeof(buf));
+	zassert_equal(ret, -EBADMSG, "EOS accepted in a string");
+}
+
+static size_t decode_block(const uint8_t *block, size_t len,
+			   const char *const fields[][2], size_t count)
+{
+	size_t fields_decoded = 0;
+
+	while (len > 0) {
+		int ret = http_hpack_decode_header(block, len, &header);
+
+		zassert_true(ret > 0, "Header decode failed (%d)", ret);
+
+		if (fields != NULL) {
+			const char *name = fields[fields_decoded][0];
+			const char *value = fields[fields_decoded][1];
+
+			zassert_true(fields_decoded < count, "Too many fields");
+			zassert_equal(header.name_len, strlen(name), "Bad name");
+			zassert_mem_equal(header.name, name, header.name_len,
+					  "Bad name");
+			zassert_equal(header.value_len, strlen(value), "Bad value");
+			zassert_mem_equal(header.value, value, header.value_len,
+					  "Bad value");
+		}
+
+		block += ret;
+		len -= ret;
+		fields_decoded++;
+	}
+
+	return fields_decoded;
+}
+
+ZTEST(http_hpack_bench, test_header_blocks)
+{
+	uint32_t start, cycles;
+	size_t bytes = sizeof(request_block) + sizeof(response_block);
+
+	zassert_equal(decode_block(request_block, sizeof(request_block),
+				   request_fields, ARRAY_SIZE(request_fields)),
+		      ARRAY_SIZE(request_fields));
+	zassert_equal(decode_block(response_block, sizeof(response_block),
+				   response_fields, ARRAY_SIZE(response_fields)),
+		      ARRAY_SIZE(response_fields));
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		decode_block(request_block, sizeof(request_block), NULL, 0);
+		decode_block(response_block, sizeof(response_block), NULL, 0);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("Header blocks, %zu bytes, %d rounds: %llu ns/byte\n", bytes,
+		 ROUNDS, ns_per_byte(cycles, bytes * ROUNDS));
+}
+
+ZTEST(http_hpack_bench, test_dynamic_table_decode)
+{
+	uint32_t start, cycles;
+	size_t bytes = sizeof(request_block) + sizeof(request_block_2) +
+		       sizeof(request_block_3);
+
+	if (header.decoder.capacity == 0) {
+		ztest_test_skip();
+	}
+
+	/* Table sizes after each block are given by the RFC. */
+	decode_block(request_block, sizeof(request_block), request_fields,
+		     ARRAY_SIZE(request_fields));
+	zassert_equal(header.decoder.size, 57, "Bad table size");
+	decode_block(request_block_2, sizeof(request_block_2), request_fields_2,
+		     ARRAY_SIZE(request_fields_2));
+	zassert_equal(header.decoder.size, 110, "Bad table size");
+	decode_block(request_block_3, sizeof(request_block_3), request_fields_3,
+		     ARRAY_SIZE(request_fields_3));
+	zassert_equal(header.decoder.size, 164, "Bad table size");
+	zassert_equal(header.decoder.count, 3, "Bad table entry count");
+
+	http_hpack_init(&header);
+
+	zassert_equal(http_hpack_decode_header(size_update_256,
+					       sizeof(size_update_256), &header),
+		      sizeof(size_update_256), "Size update failed");
+	zassert_equal(header.decoder.max_size, 256, "Bad table max size");
+	decode_block(response_block, sizeof(response_block), response_fields,
+		     ARRAY_SIZE(response_fields));
+	zassert_equal(header.decoder.size, 222, "Bad table size");
+	decode_block(response_block_2, sizeof(response_block_2),
+		     response_fields_2, ARRAY_SIZE(response_fields_2));
+	zassert_equal(header.decoder.size, 222, "Bad table size");
+	zassert_equal(header.decoder.count, 4, "Bad table entry count");
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		http_hpack_init(&header);
+		decode_block(request_block, sizeof(request_block), NULL, 0);
+		decode_block(request_block_2, sizeof(request_block_2), NULL, 0);
+		decode_block(request_block_3, sizeof(request_block_3), NULL, 0);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("Request sequence, %zu bytes, %d rounds: %llu ns/byte\n",
+		 bytes, ROUNDS, ns_per_byte(cycles, bytes * ROUNDS));
+}
+
+static size_t encode_block(const char *const fields[][2], size_t count)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		int ret;
+
+		header.name = fields[i][0];
+		header.name_len = strlen(fields[i][0]);
+		header.value = fields[i][1];
+		header.value_len = strlen(fields[i][1]);
+
+		ret = http_hpack_encode_header(buf + len, sizeof(buf) - len,
+					       &header);
+		zassert_true(ret > 0, "Header encode failed (%d)", ret);
+
+		len += ret;
+	}
+
+	/* The peer decoder must keep up with the encoder table. */
+	for (size_t i = 0, offset = 0; offset < len; i++) {
+		int ret = http_hpack_decode_header(buf + offset, len - offset,
+						   &peer);
+
+		zassert_true(ret > 0, "Header decode failed (%d)", ret);
+
+		offset += ret;
+
+		if (peer.name_len == 0) {
+			/* Table size update */
+			i--;
+			continue;
+		}
+
+		zassert_equal(peer.name_len, strlen(fields[i][0]), "Bad name");
+		zassert_mem_equal(peer.name, fields[i][0], peer.name_len,
+				  "Bad name");
+		zassert_equal(peer.value_len, strlen(fields[i][1]), "Bad value");
+		zassert_mem_equal(peer.value, fields[i][1], peer.value_len,
+				  "Bad value");
+	}
+
+	return len;
+}
+
+ZTEST(http_hpack_bench, test_dynamic_table_encode)
+{
+	size_t first, repeated, total = 0;
+
+	first = encode_block(response_fields, ARRAY_SIZE(response_fields));
+	repeated = encode_block(response_fields, ARRAY_SIZE(response_fields));
+
+	for (int i = 0; i < ROUNDS; i++) {
+		total += encode_block(response_fields, ARRAY_SIZE(response_fields));
+	}
+
+	TC_PRINT("Response, first %zu bytes, repeated %zu bytes\n", first,
+		 repeated);
+	TC_PRINT("%d repeated responses, %zu bytes on the wire\n", ROUNDS,
+		 total);
+
+	if (header.encoder.capacity == 0) {
+		zassert_equal(repeated, first, "Bad response size");
+		return;
+	}
+
+	zassert_true(repeated < first, "Repeated response not smaller");
+
+	/* Shrinking the table is signalled at the start of the next block. */
+	http_hpack_set_encoder_max_size(&header, 0);
+	(void)encode_block(response_fields, ARRAY_SIZE(response_fields));
+	zassert_equal(buf[0], 0x20, "No table size update");
+	zassert_equal(peer.decoder.max_size, 0, "Bad peer table max size");
+	zassert_equal(peer.decoder.count, 0, "Peer table not emptied");
+}
+
+/* Encode a header block which is then dropped, failing on its last field. */
+static void encode_dropped_block(const char *const fields[][2], size_t count)
+{
+	size_t len = 0;
+	int ret;
+
+	http_hpack_encoder_mark(&header);
+
+	for (size_t i = 0; i < count; i++) {
+		header.name = fields[i][0];
+		header.name_len = strlen(fields[i][0]);
+		header.value = fields[i][1];
+		header.value_len = strlen(fields[i][1]);
+
+		ret = http_hpack_encode_header(buf + len,
+					       i < count - 1 ? sizeof(buf) - len : 1,
+					       &header);
+		if (i < count - 1) {
+			zassert_true(ret > 0, "Header encode failed (%d)", ret);
+			len += ret;
+		} else {
+			zassert_equal(ret, -ENOBUFS, "Header encode not failed");
+		}
+	}
+
+	http_hpack_encoder_rollback(&header);
+}
+
+ZTEST(http_hpack_bench, test_dynamic_table_rollback)
+{
+	/* Fits in the table along with the response fields */
+	static const char *const small_fields[][2] = {
+		{ "x", "y" },
+		{ "x-failed", "1" },
+	};
+	/* Evicts response fields from the table */
+	static const char *const large_fields[][2] = {
+		{ "x-dropped", "1" },
+		{ "x-failed", "1" },
+	};
+	size_t len;
+
+	if (header.encoder.capacity < 256) {
+		ztest_test_skip();
+	}
+
+	http_hpack_set_encoder_max_size(&header, 256);
+	(void)encode_block(response_fields, ARRAY_SIZE(response_fields));
+	zassert_equal(header.encoder.size, 222, "Bad table size");
+
+	/* The table is restored, the fields are still indexed */
+	encode_dropped_block(small_fields, ARRAY_SIZE(small_fields));
+	zassert_equal(header.encoder.size, 222, "Table not restored");
+	len = encode_block(response_fields, ARRAY_SIZE(response_fields));
+	zassert_equal(len, ARRAY_SIZE(response_fields), "Fields not indexed");
+
+	/* Evicted entries are lost, the peer table is emptied too */
+	encode_dropped_block(large_fields, ARRAY_SIZE(large_fields));
+	zassert_equal(header.encoder.count, 0, "Table not emptied");
+	(void)encode_block(response_fields, ARRAY_SIZE(response_fields));
+	zassert_equal(buf[0], 0x20, "No table flush");
+	zassert_equal(peer.decoder.count, header.encoder.count,
+		      "Peer table out of sync");
+	zassert_equal(peer.decoder.size, header.encoder.size,
+		      "Peer table out of sync");
+}
+
+static void hpack_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	http_hpack_init(&header);
+	http_hpack_init(&peer);
+}
+
+ZTEST_SUITE(http_hpack_bench, NULL, NULL, hpack_before, NULL, NULL);
@@ -0,0 +1,127 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief HTTP resource dispatch benchmark
+ *
+ * Defines a service with a large number of resources and measures the
+ * time the server takes to find the resource of a request URL, with and
+ * without CONFIG_HTTP_SERVER_RESOURCE_TABLE_SIZE.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/http/service.h>
+
+#include "server_internal.h"
+
+#define RESOURCE_COUNT 128
+#define ROUNDS 2000
+
+#define RESOURCE_PATH(i) "/api/v1/endpoint/" STRINGIFY(i)
+
+static uint16_t bench_service_port = 8080;
+HTTP_SERVICE_DEFINE(bench_service, "127.0.0.1", &bench_service_port, 1, 1, NULL);
+
+#define RESOURCE_DEFINE(i, _)							\
+	static struct http_resource_detail_static detail_##i = {		\
+		.common = {							\
+			.type = HTTP_RESOURCE_TYPE_STATIC,			\
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),	\
+		},								\
+	};									\
+	HTTP_RESOURCE_DEFINE(resource_##i, bench_service, RESOURCE_PATH(i),	\
+			     &detail_##i)
+
+LISTIFY(RESOURCE_COUNT, RESOURCE_DEFINE, (;));
+
+#define RESOURCE_INFO(i, _) { RESOURCE_PATH(i), &detail_##i.common }
+
+static const struct {
+	const char *path;
+	struct http_resource_detail *detail;
+} resources[] = {
+	LISTIFY(RESOURCE_COUNT, RESOURCE_INFO, (,))
+};
+
+/* Websocket resource sharing its path with a static one */
+static struct http_resource_detail_websocket ws_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_WEBSOCKET,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+	},
+};
+
+HTTP_RESOURCE_DEFINE(ws_resource, bench_service, RESOURCE_PATH(0), &ws_detail);
+
+static const char *const missing[] = {
+	"/",
+	"/api",
+	"/api/v1/endpoint/",
+	"/api/v1/endpoint/1280",
+	"/api/v1/endpoint/12/",
+	"/api/v2/endpoint/1",
+};
+
+ZTEST(http_resource_bench, test_lookup)
+{
+	struct http_resource_detail *detail;
+	char url[64];
+	int len;
+
+	ARRAY_FOR_EACH_PTR(resources, r) {
+		detail = get_resource_detail(r->path, &len, false);
+		zassert_equal_ptr(detail, r->detail, "Bad resource for %s", r->path);
+		zassert_equal(len, strlen(r->path), "Bad path length");
+
+		snprintk(url, sizeof(url), "%s?key=value", r->path);
+		detail = get_resource_detail(url, &len, false);
+		zassert_equal_ptr(detail, r->detail, "Bad resource for %s", url);
+	}
+
+	detail = get_resource_detail(RESOURCE_PATH(0), &len, true);
+	zassert_equal_ptr(detail, &ws_detail.common, "Bad websocket resource");
+	detail = get_resource_detail(RESOURCE_PATH(1), &len, true);
+	zassert_is_null(detail, "Found a static resource as websocket");
+
+	ARRAY_FOR_EACH(missing, i) {
+		detail = get_resource_detail(missing[i], &len, false);
+		zassert_is_null(detail, "Found a resource for %s", missing[i]);
+	}
+}
+
+ZTEST(http_resource_bench, test_dispatch)
+{
+	uint32_t start, hit_cyc, miss_cyc;
+	int len;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		ARRAY_FOR_EACH_PTR(resources, r) {
+			(void)get_resource_detail(r->path, &len, false);
+		}
+	}
+
+	hit_cyc = k_cycle_get_32() - start;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		ARRAY_FOR_EACH(missing, j) {
+			(void)get_resource_detail(missing[j], &len, false);
+		}
+	}
+
+	miss_cyc = k_cycle_get_32() - start;
+
+	TC_PRINT("%d resources, table size %d, %d rounds\n", RESOURCE_COUNT + 1,
+		 CONFIG_HTTP_SERVER_RESOURCE_TABLE_SIZE, ROUNDS);
+	TC_PRINT("match %llu ns/request, no match %llu ns/request\n",
+		 k_cyc_to_ns_floor64(hit_cyc) / (ROUNDS * ARRAY_SIZE(resources)),
+		 k_cyc_to_ns_floor64(miss_cyc) / (ROUNDS * ARRAY_SIZE(missing)));
+}
+
+ZTEST_SUITE(http_resource_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,238 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief HTTP server load benchmark
+ *
+ * Concurrent HTTP/1.1 clients request slow dynamic resources from the
+ * server over the loopback interface, while another client requests a
+ * static resource. Reports the request rate of the slow clients and the
+ * latency seen by the static resource client, with or without
+ * CONFIG_HTTP_SERVER_WORKERS.
+ */
+
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+
+#define SERVER_PORT 8080
+#define SLOW_CLIENTS 6
+#define SLOW_REQUESTS 5
+#define STATIC_REQUESTS 20
+#define HANDLER_DELAY_MS 20
+#define CLIENT_STACK_SIZE 2048
+
+static uint16_t load_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(load_service, "127.0.0.1", &load_service_port, 1, 8, NULL);
+
+static const uint8_t index_html[] = "<html><body>Hello</body></html>";
+
+static struct http_resource_detail_static index_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+	},
+	.static_data = index_html,
+	.static_data_len = sizeof(index_html) - 1,
+};
+
+HTTP_RESOURCE_DEFINE(index_resource, load_service, "/", &index_detail);
+
+/* Simulates a handler doing some processing before answering. Called
+ * again once the answer is sent, to end the response.
+ */
+static int slow_handler(struct http_client_ctx *client, enum http_data_status status,
+			uint8_t *buffer, size_t len, void *user_data)
+{
+	bool *answered = user_data;
+
+	if (*answered) {
+		*answered = false;
+		return 0;
+	}
+
+	k_msleep(HANDLER_DELAY_MS);
+
+	memcpy(buffer, "ok", 2);
+	*answered = true;
+
+	return 2;
+}
+
+/* One resource per client, as a dynamic resource serves a single client
+ * at a time.
+ */
+#define SLOW_RESOURCE_DEFINE(i, _)						\
+	static uint8_t slow_buffer_##i[16];					\
+	static bool slow_answered_##i;						\
+	static struct http_resource_detail_dynamic slow_detail_##i = {		\
+		.common = {							\
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,			\
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),	\
+		},								\
+		.cb = slow_handler,						\
+		.data_buffer = slow_buffer_##i,					\
+		.data_buffer_len = sizeof(slow_buffer_##i),			\
+		.user_data = &slow_answered_##i,				\
+	};									\
+	HTTP_RESOURCE_DEFINE(slow_resource_##i, load_service,			\
+			     "/slow/" STRINGIFY(i), &slow_detail_##i)
+
+LISTIFY(SLOW_CLIENTS, SLOW_RESOURCE_DEFINE, (;));
+
+static K_THREAD_STACK_ARRAY_DEFINE(client_stacks, SLOW_CLIENTS + 1, CLIENT_STACK_SIZE);
+static struct k_thread client_threads[SLOW_CLIENTS + 1];
+static atomic_t slow_ok;
+static atomic_t static_ok;
+static int64_t static_latency_ms;
+
+/* Send a request and read the response until the server closes the
+ * connection, as it does after each HTTP/1.1 request.
+ */
+static int http_get(const char *path, const char *expected)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	char request[64];
+	char response[256];
+	size_t len = 0;
+	int fd, ret;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	ret = zsock_connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	ret = snprintf(request, sizeof(request),
+		       "GET %s HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n", path);
+
+	ret = zsock_send(fd, request, ret, 0);
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	while (len < sizeof(response) - 1) {
+		ret = zsock_recv(fd, response + len, sizeof(response) - 1 - len, 0);
+		if (ret < 0) {
+			ret = -errno;
+			goto out;
+		}
+
+		if (ret == 0) {
+			break;
+		}
+
+		len += ret;
+	}
+
+	response[len] = '\0';
+	ret = (strstr(response, "200 OK") != NULL &&
+	       strstr(response, expected) != NULL) ? 0 : -EBADMSG;
+
+out:
+	zsock_close(fd);
+
+	return ret;
+}
+
+static void slow_client(void *p1, void *p2, void *p3)
+{
+	char path[16];
+
+	snprintf(path, sizeof(path), "/slow/%d", (int)POINTER_TO_INT(p1));
+
+	for (int i = 0; i < SLOW_REQUESTS; i++) {
+		if (http_get(path, "ok") == 0) {
+			atomic_inc(&slow_ok);
+		}
+	}
+}
+
+static void static_client(void *p1, void *p2, void *p3)
+{
+	int64_t start = k_uptime_get();
+
+	for (int i = 0; i < STATIC_REQUESTS; i++) {
+		if (http_get("/", "Hello") == 0) {
+			atomic_inc(&static_ok);
+		}
+	}
+
+	static_latency_ms = (k_uptime_get() - start) / STATIC_REQUESTS;
+}
+
+ZTEST(http_server_load, test_concurrent_clients)
+{
+	int64_t start, elapsed;
+
+	start = k_uptime_get();
+
+	for (int i = 0; i < SLOW_CLIENTS; i++) {
+		k_thread_create(&client_threads[i], client_stacks[i],
+				K_THREAD_STACK_SIZEOF(client_stacks[i]),
+				slow_client, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+	}
+
+	k_thread_create(&client_threads[SLOW_CLIENTS], client_stacks[SLOW_CLIENTS],
+			K_THREAD_STACK_SIZEOF(client_stacks[SLOW_CLIENTS]),
+			static_client, NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0,
+			K_NO_WAIT);
+
+	ARRAY_FOR_EACH(client_threads, i) {
+		k_thread_join(&client_threads[i], K_FOREVER);
+	}
+
+	elapsed = k_uptime_get() - start;
+
+	TC_PRINT("%d workers, %d slow clients x %d requests, %d ms handler\n",
+		 CONFIG_HTTP_SERVER_WORKERS, SLOW_CLIENTS, SLOW_REQUESTS,
+		 HANDLER_DELAY_MS);
+	TC_PRINT("slow requests: %ld ok in %lld ms, %lld requests/s\n",
+		 atomic_get(&slow_ok), elapsed,
+		 atomic_get(&slow_ok) * 1000LL / MAX(elapsed, 1));
+	TC_PRINT("static requests: %ld ok, %lld ms average latency\n",
+		 atomic_get(&static_ok), static_latency_ms);
+
+	zassert_equal(atomic_get(&slow_ok), SLOW_CLIENTS * SLOW_REQUESTS,
+		      "Slow requests failed");
+	zassert_equal(atomic_get(&static_ok), STATIC_REQUESTS,
+		      "Static requests failed");
+}
+
+static void *setup(void)
+{
+	zassert_ok(http_server_start(), "Cannot start the server");
+
+	/* Let the server thread open the listening socket. */
+	k_msleep(100);
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)http_server_stop();
+}
+
+ZTEST_SUITE(http_server_load, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,366 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief File system log backend benchmark
+ *
+ * Logs batches of messages to the file system backend on a littlefs
+ * partition of the simulated flash and measures how long the logging
+ * thread takes to process them, then how long until all data is in the
+ * log files. Run with and without CONFIG_LOG_BACKEND_FS_BUFFERED, in text
+ * or dictionary format.
+ *
+ * The other tests read the log files back and check that each logged
+ * message made it there once and in order, that a partially filled buffer
+ * is written after the flush timeout and that a full buffer is written to
+ * the file at once.
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define BATCH 64
+#define ROUNDS 8
+#define SETTLE_MS 50
+
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+#define FLUSH_WAIT_MS (CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS + SETTLE_MS)
+#define BUFFER_SIZE CONFIG_LOG_BACKEND_FS_BUFFER_SIZE
+#else
+#define FLUSH_WAIT_MS SETTLE_MS
+#define BUFFER_SIZE 0
+#endif
+
+#define LOG_PREFIX_LEN (sizeof(CONFIG_LOG_BACKEND_FS_FILE_PREFIX) - 1)
+
+/* Enough messages to fill a few buffers */
+#define READBACK_MSGS 192
+
+/* All log files the backend keeps */
+static char log_data[CONFIG_LOG_BACKEND_FS_FILES_LIMIT * CONFIG_LOG_BACKEND_FS_FILE_SIZE + 1];
+
+/* Number of the log file, or -1 if the entry is not one */
+static int log_file_id(const struct fs_dirent *ent)
+{
+	if (ent->type != FS_DIR_ENTRY_FILE ||
+	    strlen(ent->name) != LOG_PREFIX_LEN + 4 ||
+	    memcmp(ent->name, CONFIG_LOG_BACKEND_FS_FILE_PREFIX, LOG_PREFIX_LEN) != 0) {
+		return -1;
+	}
+
+	return atoi(ent->name + LOG_PREFIX_LEN);
+}
+
+/* Total size of the log files */
+static size_t log_files_size(void)
+{
+	struct fs_dirent ent;
+	struct fs_dir_t dir;
+	size_t size = 0;
+
+	fs_dir_t_init(&dir);
+
+	if (fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR) < 0) {
+		return 0;
+	}
+
+	while (fs_readdir(&dir, &ent) == 0 && ent.name[0] != 0) {
+		if (ent.type == FS_DIR_ENTRY_FILE) {
+			size += ent.size;
+		}
+	}
+
+	(void)fs_closedir(&dir);
+
+	return size;
+}
+
+/* Size of the newest log file, its number goes to @p id */
+static size_t newest_log_size(int *id)
+{
+	struct fs_dirent ent;
+	struct fs_dir_t dir;
+	size_t size = 0;
+
+	*id = -1;
+	fs_dir_t_init(&dir);
+
+	if (fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR) < 0) {
+		return 0;
+	}
+
+	while (fs_readdir(&dir, &ent) == 0 && ent.name[0] != 0) {
+		int num = log_file_id(&ent);
+
+		if (num > *id) {
+			*id = num;
+			size = ent.size;
+		}
+	}
+
+	(void)fs_closedir(&dir);
+
+	return size;
+}
+
+/* Concatenate the log files from the oldest to the newest into log_data */
+static size_t read_log_files(void)
+{
+	struct fs_dirent ent;
+	struct fs_dir_t dir;
+	int first = INT_MAX, last = -1;
+	size_t len = 0;
+
+	fs_dir_t_init(&dir);
+	zassert_ok(fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR));
+
+	while (fs_readdir(&dir, &ent) == 0 && ent.name[0] != 0) {
+		int num = log_file_id(&ent);
+
+		if (num >= 0) {
+			first = MIN(first, num);
+			last = MAX(last, num);
+		}
+	}
+
+	(void)fs_closedir(&dir);
+
+	for (int num = first; num <= last; num++) {
+		char path[64];
+		struct fs_file_t file;
+		ssize_t rc;
+
+		snprintf(path, sizeof(path), "%s/%s%04d", CONFIG_LOG_BACKEND_FS_DIR,
+			 CONFIG_LOG_BACKEND_FS_FILE_PREFIX, num);
+
+		fs_file_t_init(&file);
+		zassert_ok(fs_open(&file, path, FS_O_READ), "Cannot open %s", path);
+		rc = fs_read(&file, &log_data[len], sizeof(log_data) - 1 - len);
+		(void)fs_close(&file);
+
+		zassert_true(rc >= 0, "Cannot read %s", path);
+		len += rc;
+	}
+
+	log_data[len] = '\0';
+
+	return len;
+}
+
+/* Check that the log files hold messages 0 to cnt - 1 with the tag, in order */
+static void check_log_messages(const char *tag, int cnt)
+{
+	const char *pos = log_data;
+	char msg[64];
+	int found = 0;
+
+	(void)read_log_files();
+
+	for (int i = 0; i < cnt; i++) {
+		const char *p;
+
+		snprintf(msg, sizeof(msg), " %s %04d value %08x", tag, i, i * i);
+		p = strstr(pos, msg);
+		zassert_not_null(p, "Message %d missing or out of order", i);
+		pos = p + strlen(msg);
+		/* Followed by the end of the line or of the color */
+		zassert_true(*pos == '\r' || *pos == '\n' || *pos == '\x1b', "Message %d cut", i);
+	}
+
+	snprintf(msg, sizeof(msg), " %s ", tag);
+	for (const char *p = strstr(log_data, msg); p != NULL; p = strstr(p + 1, msg)) {
+		found++;
+	}
+
+	zassert_equal(found, cnt, "%d messages logged, %d in the files", cnt, found);
+}
+
+/* Log messages first to last - 1 with the tag, all of the same length */
+static void log_messages(const char *tag, int first, int last)
+{
+	for (int i = first; i < last; i++) {
+		LOG_INF("%s %04d value %08x", tag, i, i * i);
+	}
+}
+
+static void wait_log_processed(void)
+{
+	/* Do not wait for the logging thread to wake up on its own */
+	log_thread_trigger();
+
+	while (log_data_pending()) {
+		k_msleep(1);
+	}
+}
+
+/* Wait until the files stop growing */
+static size_t wait_log_written(void)
+{
+	size_t size, prev_size;
+
+	wait_log_processed();
+
+	size = log_files_size();
+	do {
+		prev_size = size;
+		k_msleep(FLUSH_WAIT_MS);
+		size = log_files_size();
+	} while (size != prev_size);
+
+	return size;
+}
+
+/* Bytes written since the newest log file had prev_id and prev_size */
+static size_t log_growth(int prev_id, size_t prev_size)
+{
+	int id;
+	size_t size = newest_log_size(&id);
+
+	/* A new file is started when the data does not fit into the current one */
+	return (id == prev_id) ? size - prev_size : size;
+}
+
+/* Log the first message with the tag and return its size once the writer
+ * thread flushed it, right after which the next flush timeout is a whole
+ * CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS away.
+ */
+static size_t sync_to_flush(const char *tag)
+{
+	size_t prev_size, len;
+	int64_t end;
+	int prev_id;
+
+	(void)wait_log_written();
+	prev_size = newest_log_size(&prev_id);
+
+	log_messages(tag, 0, 1);
+	wait_log_processed();
+
+	end = k_uptime_get() + FLUSH_WAIT_MS;
+	while ((len = log_growth(prev_id, prev_size)) == 0) {
+		zassert_true(k_uptime_get() < end, "Not written after the flush timeout");
+		k_msleep(1);
+	}
+
+	return len;
+}
+
+ZTEST(log_backend_fs, test_log_batches)
+{
+	uint32_t start, cyc, proc_cyc = 0;
+	size_t size;
+
+	/* The first message creates the log file */
+	LOG_INF("start");
+	wait_log_processed();
+	k_msleep(SETTLE_MS);
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		uint32_t batch_start = k_cycle_get_32();
+
+		for (int i = 0; i < BATCH; i++) {
+			LOG_INF("round %d message %d value %08x", round, i, round * i);
+		}
+
+		wait_log_processed();
+		proc_cyc += k_cycle_get_32() - batch_start;
+	}
+
+	size = wait_log_written();
+	cyc = k_cycle_get_32() - start;
+
+	zassert_true(size > 0, "Nothing written");
+
+	TC_PRINT("%s%s: %d messages processed in %llu us, %llu us per batch of %d\n",
+		 IS_ENABLED(CONFIG_LOG_BACKEND_FS_BUFFERED) ? "buffered" : "unbuffered",
+		 IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY) ? " dictionary" : "",
+		 ROUNDS * BATCH, k_cyc_to_us_floor64(proc_cyc),
+		 k_cyc_to_us_floor64(proc_cyc) / ROUNDS, BATCH);
+	TC_PRINT("%zu bytes in log files, written in %llu us\n", size,
+		 k_cyc_to_us_floor64(cyc));
+}
+
+ZTEST(log_backend_fs, test_read_back)
+{
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
+		ztest_test_skip();
+	}
+
+	/* More than a few buffers, so that they get swapped in the buffered mode */
+	for (int i = 0; i < READBACK_MSGS; i += BATCH) {
+		log_messages("readback", i, MIN(i + BATCH, READBACK_MSGS));
+		wait_log_processed();
+	}
+
+	(void)wait_log_written();
+
+	check_log_messages("readback", READBACK_MSGS);
+}
+
+ZTEST(log_backend_fs, test_timeout_flush)
+{
+	size_t prev_size;
+	int prev_id;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_LOG_BACKEND_FS_BUFFERED);
+
+	(void)sync_to_flush("timeout");
+	prev_size = newest_log_size(&prev_id);
+
+	log_messages("timeout", 1, 4);
+	wait_log_processed();
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(log_growth(prev_id, prev_size), 0, "Written before the flush timeout");
+
+	k_msleep(FLUSH_WAIT_MS);
+
+	zassert_true(log_growth(prev_id, prev_size) > 0, "Not written after the flush timeout");
+
+	if (!IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
+		check_log_messages("timeout", 4);
+	}
+}
+
+ZTEST(log_backend_fs, test_full_buffer_write)
+{
+	size_t msg_len, size, prev_size;
+	int cnt, prev_id;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_LOG_BACKEND_FS_BUFFERED);
+
+	/* The flush timeout is far enough for the buffer to fill up first */
+	msg_len = sync_to_flush("full");
+	prev_size = newest_log_size(&prev_id);
+
+	/* Just over a buffer */
+	cnt = BUFFER_SIZE / msg_len + 1;
+	log_messages("full", 1, cnt + 1);
+	wait_log_processed();
+	k_msleep(SETTLE_MS);
+
+	size = log_growth(prev_id, prev_size);
+	zassert_equal(size, BUFFER_SIZE, "%zu bytes written instead of a full buffer", size);
+
+	(void)wait_log_written();
+
+	if (!IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
+		check_log_messages("full", cnt + 1);
+	}
+}
+
+ZTEST_SUITE(log_backend_fs, NULL, NULL, NULL, NULL, NULL);
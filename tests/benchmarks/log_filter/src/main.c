@@ -0,0 +1,112 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Log runtime filtering benchmark
+ *
+ * Logs debug messages from a module compiled at the debug level while its
+ * runtime level filters them out for all backends, for one of two
+ * backends, or for none, and measures the time taken by the LOG_DBG() call
+ * and by the processing of each message. Run with and without
+ * CONFIG_LOG_RUNTIME_FILTER_BITMAP.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#define MODULE_NAME log_filter_bench
+
+LOG_MODULE_REGISTER(MODULE_NAME, LOG_LEVEL_DBG);
+
+#define BATCH 64
+#define ROUNDS 64
+
+static uint32_t processed[2];
+
+static void process(struct log_backend const *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(msg);
+
+	processed[POINTER_TO_UINT(backend->cb->ctx)]++;
+}
+
+static void init(struct log_backend const *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+	.init = init,
+};
+
+LOG_BACKEND_DEFINE(bench_backend0, backend_api, false);
+LOG_BACKEND_DEFINE(bench_backend1, backend_api, false);
+
+static void run(const char *name, uint32_t level0, uint32_t level1)
+{
+	int source_id = log_source_id_get(STRINGIFY(MODULE_NAME));
+	uint32_t start, log_cyc = 0, proc_cyc = 0;
+
+	zassert_true(source_id >= 0, "No log source");
+
+	log_filter_set(&bench_backend0, Z_LOG_LOCAL_DOMAIN_ID, source_id, level0);
+	log_filter_set(&bench_backend1, Z_LOG_LOCAL_DOMAIN_ID, source_id, level1);
+	processed[0] = processed[1] = 0;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		start = k_cycle_get_32();
+
+		for (int i = 0; i < BATCH; i++) {
+			LOG_DBG("round %d message %d", round, i);
+		}
+
+		log_cyc += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+
+		while (log_process()) {
+		}
+
+		proc_cyc += k_cycle_get_32() - start;
+	}
+
+	zassert_equal(processed[0], level0 >= LOG_LEVEL_DBG ? ROUNDS * BATCH : 0);
+	zassert_equal(processed[1], level1 >= LOG_LEVEL_DBG ? ROUNDS * BATCH : 0);
+
+	TC_PRINT("%s%s: LOG_DBG() %llu ns, processing %llu ns per message\n", name,
+		 IS_ENABLED(CONFIG_LOG_RUNTIME_FILTER_BITMAP) ? " (bitmap)" : "",
+		 k_cyc_to_ns_floor64(log_cyc) / (ROUNDS * BATCH),
+		 k_cyc_to_ns_floor64(proc_cyc) / (ROUNDS * BATCH));
+}
+
+ZTEST(log_filter, test_filtered)
+{
+	run("filtered", LOG_LEVEL_INF, LOG_LEVEL_ERR);
+}
+
+ZTEST(log_filter, test_one_backend)
+{
+	run("one backend", LOG_LEVEL_DBG, LOG_LEVEL_ERR);
+}
+
+ZTEST(log_filter, test_unfiltered)
+{
+	run("unfiltered", LOG_LEVEL_DBG, LOG_LEVEL_DBG);
+}
+
+static void *setup(void)
+{
+	log_backend_enable(&bench_backend0, UINT_TO_POINTER(0), LOG_LEVEL_DBG);
+	log_backend_enable(&bench_backend1, UINT_TO_POINTER(1), LOG_LEVEL_DBG);
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_filter, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,113 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Logging throughput benchmark
+ *
+ * Runs one thread per CPU, each logging with LOG_INF() as fast as it can
+ * in deferred mode, and measures the time taken by a LOG_INF() call and
+ * the number of messages processed per second. Run on SMP with and
+ * without CONFIG_LOG_PER_CPU_BUFFERS to see the effect of CPUs sharing
+ * the log buffer.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define THREADS CONFIG_MP_MAX_NUM_CPUS
+#define MSGS_PER_THREAD 2000
+#define STACK_SIZE 2048
+#define PRIORITY K_PRIO_PREEMPT(5)
+
+static atomic_t processed;
+
+static void process(struct log_backend const *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+
+	atomic_inc(&processed);
+}
+
+static void dropped(struct log_backend const *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(cnt);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, backend_api, true);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, THREADS, STACK_SIZE);
+static struct k_thread threads[THREADS];
+static uint32_t log_cyc[THREADS];
+static uint32_t log_max_cyc[THREADS];
+
+static void logger(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint32_t start, cyc;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < MSGS_PER_THREAD; i++) {
+		start = k_cycle_get_32();
+		LOG_INF("thread %d message %d", id, i);
+		cyc = k_cycle_get_32() - start;
+
+		log_cyc[id] += cyc;
+		log_max_cyc[id] = MAX(log_max_cyc[id], cyc);
+	}
+}
+
+ZTEST(log_throughput, test_log_inf)
+{
+	uint32_t start, cyc, total_cyc = 0, max_cyc = 0;
+	uint64_t us;
+
+	atomic_clear(&processed);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, logger, INT_TO_POINTER(i),
+				NULL, NULL, PRIORITY, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < THREADS; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_FOREVER));
+		total_cyc += log_cyc[i];
+		max_cyc = MAX(max_cyc, log_max_cyc[i]);
+	}
+
+	while (log_data_pending()) {
+		k_msleep(1);
+	}
+
+	cyc = k_cycle_get_32() - start;
+	us = MAX(k_cyc_to_us_floor64(cyc), 1);
+
+	zassert_true(atomic_get(&processed) > 0, "No message processed");
+
+	TC_PRINT("%d threads%s: LOG_INF() %u cycles avg, %u cycles max\n", THREADS,
+		 IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ? " (per-CPU buffers)" : "",
+		 total_cyc / (THREADS * MSGS_PER_THREAD), max_cyc);
+	TC_PRINT("%ld of %d messages processed in %llu us, %llu messages/s\n",
+		 atomic_get(&processed), THREADS * MSGS_PER_THREAD, us,
+		 (uint64_t)atomic_get(&processed) * USEC_PER_SEC / us);
+}
+
+ZTEST_SUITE(log_throughput, NULL, NULL, NULL, NULL, NULL);
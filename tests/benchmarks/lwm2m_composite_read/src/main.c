@@ -0,0 +1,159 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief LwM2M SenML-CBOR composite read benchmark
+ *
+ * Registers an object with many instances, like a gateway exposing its
+ * devices, and measures a SenML-CBOR composite read of resources spread over
+ * the most recently created instances. Run with and without
+ * CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_message_handling.h"
+#include "lwm2m_observation.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_util.h"
+
+#define BENCH_OBJ_ID 32769
+#define INSTANCES 256
+#define RES_COUNT 4
+#define READ_PATHS CONFIG_LWM2M_RW_SENML_CBOR_RECORDS
+#define ROUNDS 200
+
+static struct lwm2m_engine_obj bench_obj;
+
+static struct lwm2m_engine_obj_field bench_fields[RES_COUNT] = {
+	OBJ_FIELD_DATA(0, R, U32),
+	OBJ_FIELD_DATA(1, R, U32),
+	OBJ_FIELD_DATA(2, R, U32),
+	OBJ_FIELD_DATA(3, R, U32),
+};
+
+static struct lwm2m_engine_obj_inst bench_inst[INSTANCES];
+static struct lwm2m_engine_res bench_res[INSTANCES][RES_COUNT];
+static struct lwm2m_engine_res_inst bench_res_inst[INSTANCES][RES_COUNT];
+static uint32_t bench_value[INSTANCES][RES_COUNT];
+
+static struct lwm2m_obj_path_list path_buf[READ_PATHS];
+static sys_slist_t path_list;
+
+static struct lwm2m_ctx bench_ctx;
+static struct lwm2m_message bench_msg;
+
+static struct lwm2m_engine_obj_inst *bench_obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	if (obj_inst_id >= INSTANCES) {
+		return NULL;
+	}
+
+	init_res_instance(bench_res_inst[obj_inst_id], RES_COUNT);
+
+	for (int res_id = 0; res_id < RES_COUNT; res_id++) {
+		bench_value[obj_inst_id][res_id] = obj_inst_id * RES_COUNT + res_id;
+		INIT_OBJ_RES_DATA(res_id, bench_res[obj_inst_id], i, bench_res_inst[obj_inst_id],
+				  j, &bench_value[obj_inst_id][res_id], sizeof(uint32_t));
+	}
+
+	bench_inst[obj_inst_id].resources = bench_res[obj_inst_id];
+	bench_inst[obj_inst_id].resource_count = i;
+
+	return &bench_inst[obj_inst_id];
+}
+
+static void msg_reset(void)
+{
+	memset(&bench_msg, 0, sizeof(bench_msg));
+
+	bench_msg.ctx = &bench_ctx;
+	bench_msg.out.writer = &senml_cbor_writer;
+	bench_msg.out.out_cpkt = &bench_msg.cpkt;
+	bench_msg.cpkt.data = bench_msg.msg_data;
+	bench_msg.cpkt.max_len = sizeof(bench_msg.msg_data);
+}
+
+static void *bench_setup(void)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	int first;
+
+	bench_obj.obj_id = BENCH_OBJ_ID;
+	bench_obj.version_major = 1;
+	bench_obj.version_minor = 0;
+	bench_obj.fields = bench_fields;
+	bench_obj.field_count = ARRAY_SIZE(bench_fields);
+	bench_obj.max_instance_count = INSTANCES;
+	bench_obj.create_cb = bench_obj_create;
+
+	lwm2m_register_obj(&bench_obj);
+
+	for (int i = 0; i < INSTANCES; i++) {
+		zassert_ok(lwm2m_create_obj_inst(BENCH_OBJ_ID, i, &obj_inst));
+	}
+
+	/* Read all resources of the last instances */
+	sys_slist_init(&path_list);
+	first = INSTANCES - READ_PATHS / RES_COUNT;
+
+	for (int i = 0; i < READ_PATHS; i++) {
+		path_buf[i].path = LWM2M_OBJ(BENCH_OBJ_ID, first + i / RES_COUNT, i % RES_COUNT);
+		sys_slist_append(&path_list, &path_buf[i].node);
+	}
+
+	return NULL;
+}
+
+ZTEST(lwm2m_composite_read_bench, test_composite_read)
+{
+	uint32_t start, cyc = 0;
+	int ret;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		msg_reset();
+
+		start = k_cycle_get_32();
+		ret = do_composite_read_op_for_parsed_list(&bench_msg, LWM2M_FORMAT_APP_SENML_CBOR,
+							   &path_list);
+		cyc += k_cycle_get_32() - start;
+
+		zassert_ok(ret, "Composite read failed (%d)", ret);
+	}
+
+	TC_PRINT("composite read of %d resources out of %d instances%s: %llu ns, "
+		 "%u bytes\n", READ_PATHS, INSTANCES,
+		 IS_ENABLED(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP) ? " (indexed)" : "",
+		 k_cyc_to_ns_floor64(cyc) / ROUNDS, bench_msg.cpkt.offset);
+}
+
+ZTEST(lwm2m_composite_read_bench, test_path_lookup)
+{
+	struct lwm2m_engine_res *res;
+	uint32_t start, cyc = 0;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		for (int j = 0; j < READ_PATHS; j++) {
+			res = NULL;
+			zassert_ok(path_to_objs(&path_buf[j].path, NULL, NULL, &res, NULL));
+			zassert_not_null(res);
+		}
+	}
+
+	cyc = k_cycle_get_32() - start;
+
+	TC_PRINT("path lookup%s: %llu ns\n",
+		 IS_ENABLED(CONFIG_LWM2M_ENGINE_INDEXED_LOOKUP) ? " (indexed)" : "",
+		 k_cyc_to_ns_floor64(cyc) / (ROUNDS * READ_PATHS));
+}
+
+ZTEST_SUITE(lwm2m_composite_read_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,255 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief MQTT publish rate benchmark
+ *
+ * Publishes QoS 1 messages to a broker stand-in, implemented as a custom
+ * transport, which acknowledges every PUBLISH after a simulated round trip
+ * time. Compares waiting for each PUBACK after mqtt_publish() with keeping
+ * the in-flight window of mqtt_publish_async() full, and reports the CPU
+ * cost of encoding and writing a message.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/mqtt.h>
+
+#define MESSAGES 256
+#define RTT_MS 4
+#define PAYLOAD_SIZE 64
+#define ACK_QUEUE_SIZE 64
+
+static uint8_t rx_buffer[128];
+static uint8_t tx_buffer[128];
+static uint8_t payload[PAYLOAD_SIZE];
+static struct mqtt_client client;
+
+/* Reply becomes readable once the simulated round trip time elapsed. */
+struct pending_ack {
+	int64_t due;
+	uint8_t data[4];
+};
+
+static struct {
+	struct pending_ack acks[ACK_QUEUE_SIZE];
+	unsigned int head;
+	unsigned int tail;
+	unsigned int pos;
+	int rtt_ms;
+} broker;
+
+static int acked;
+
+static void broker_reply(int delay_ms, uint8_t type, uint8_t b2, uint8_t b3)
+{
+	struct pending_ack *ack;
+
+	zassert_true(broker.tail - broker.head < ACK_QUEUE_SIZE,
+		     "Ack queue full");
+
+	ack = &broker.acks[broker.tail++ % ACK_QUEUE_SIZE];
+	ack->due = k_uptime_get() + delay_ms;
+	ack->data[0] = type;
+	ack->data[1] = 0x02;
+	ack->data[2] = b2;
+	ack->data[3] = b3;
+}
+
+static void broker_receive(const uint8_t *data)
+{
+	uint16_t topic_len;
+
+	if ((data[0] & 0xF6) != 0x32) {
+		/* Only QoS 1 PUBLISH is acknowledged. */
+		return;
+	}
+
+	/* Reply with the message id. */
+	topic_len = (data[2] << 8) | data[3];
+	broker_reply(broker.rtt_ms, 0x40, data[4 + topic_len],
+		     data[5 + topic_len]);
+}
+
+int mqtt_client_custom_transport_connect(struct mqtt_client *c)
+{
+	broker_reply(0, 0x20, 0x00, 0x00);
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_write(struct mqtt_client *c,
+				       const uint8_t *data, uint32_t datalen)
+{
+	broker_receive(data);
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_write_msg(struct mqtt_client *c,
+					   const struct msghdr *message)
+{
+	broker_receive(message->msg_iov[0].iov_base);
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_read(struct mqtt_client *c, uint8_t *data,
+				      uint32_t buflen, bool shall_block)
+{
+	struct pending_ack *ack;
+	uint32_t len;
+
+	ack = &broker.acks[broker.head % ACK_QUEUE_SIZE];
+	if (broker.head == broker.tail || ack->due > k_uptime_get()) {
+		return -EAGAIN;
+	}
+
+	len = MIN(buflen, sizeof(ack->data) - broker.pos);
+	memcpy(data, &ack->data[broker.pos], len);
+
+	broker.pos += len;
+	if (broker.pos == sizeof(ack->data)) {
+		broker.pos = 0;
+		broker.head++;
+	}
+
+	return len;
+}
+
+int mqtt_client_custom_transport_disconnect(struct mqtt_client *c)
+{
+	broker.head = broker.tail = broker.pos = 0;
+
+	return 0;
+}
+
+static void evt_handler(struct mqtt_client *const c,
+			const struct mqtt_evt *evt)
+{
+	if (evt->type == MQTT_EVT_PUBACK) {
+		acked++;
+	}
+}
+
+/* Process acks that are due, sleep when there are none. */
+static void poll_acks(void)
+{
+	int before = acked;
+
+	zassert_ok(mqtt_input(&client));
+
+	if (acked == before && broker.pos == 0) {
+		k_msleep(1);
+	}
+}
+
+static void publish_param_init(struct mqtt_publish_param *param)
+{
+	memset(param, 0, sizeof(*param));
+
+	param->message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param->message.topic.topic = (struct mqtt_utf8)MQTT_UTF8_LITERAL("bench");
+	param->message.payload.data = payload;
+	param->message.payload.len = sizeof(payload);
+}
+
+static void report(const char *name, int64_t elapsed_ms, uint32_t cyc)
+{
+	TC_PRINT("%s: %d messages in %lld ms (%lld msg/s, RTT %d ms), "
+		 "%llu ns per publish call\n", name, MESSAGES, elapsed_ms,
+		 elapsed_ms > 0 ? MESSAGES * 1000LL / elapsed_ms : 0LL,
+		 broker.rtt_ms, k_cyc_to_ns_floor64(cyc) / MESSAGES);
+}
+
+ZTEST(mqtt_publish_bench, test_stop_and_wait)
+{
+	struct mqtt_publish_param param;
+	uint32_t start, cyc = 0;
+	int64_t begin;
+
+	publish_param_init(&param);
+	acked = 0;
+	begin = k_uptime_get();
+
+	for (int i = 0; i < MESSAGES; i++) {
+		param.message_id = i + 1;
+
+		start = k_cycle_get_32();
+		zassert_ok(mqtt_publish(&client, &param));
+		cyc += k_cycle_get_32() - start;
+
+		while (acked <= i) {
+			poll_acks();
+		}
+	}
+
+	report("stop-and-wait", k_uptime_get() - begin, cyc);
+}
+
+ZTEST(mqtt_publish_bench, test_window)
+{
+	struct mqtt_publish_param param;
+	uint32_t start, cyc = 0;
+	int64_t begin;
+	int sent = 0;
+	int ret;
+
+	publish_param_init(&param);
+	acked = 0;
+	begin = k_uptime_get();
+
+	while (acked < MESSAGES) {
+		while (sent < MESSAGES) {
+			start = k_cycle_get_32();
+			ret = mqtt_publish_async(&client, &param);
+			cyc += k_cycle_get_32() - start;
+
+			if (ret == -EAGAIN) {
+				break;
+			}
+
+			zassert_true(ret > 0, "Publish failed (%d)", ret);
+			sent++;
+		}
+
+		poll_acks();
+	}
+
+	TC_PRINT("window of %d messages\n", CONFIG_MQTT_PUBLISH_WINDOW);
+	report("window", k_uptime_get() - begin, cyc);
+}
+
+static void *mqtt_publish_bench_setup(void)
+{
+	mqtt_client_init(&client);
+
+	client.client_id = (struct mqtt_utf8)MQTT_UTF8_LITERAL("zephyr");
+	client.evt_cb = evt_handler;
+	client.transport.type = MQTT_TRANSPORT_CUSTOM;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+	client.keepalive = 0;
+
+	broker.rtt_ms = RTT_MS;
+
+	zassert_ok(mqtt_connect(&client));
+	zassert_ok(mqtt_input(&client));
+
+	return NULL;
+}
+
+static void mqtt_publish_bench_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)mqtt_abort(&client);
+}
+
+ZTEST_SUITE(mqtt_publish_bench, NULL, mqtt_publish_bench_setup, NULL, NULL,
+	    mqtt_publish_bench_teardown);
@@ -0,0 +1,104 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Network buffer allocation benchmark
+ *
+ * Measures net_buf_alloc() and net_buf_unref() on a fixed size pool, one
+ * buffer at a time, in bursts that empty the pool, and as fragment chains
+ * freed with a single net_buf_unref(). Run with and without
+ * CONFIG_NET_BUF_LOCKLESS_FREE_LIST.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/buf.h>
+
+#define BUF_COUNT 32
+#define BUF_SIZE 128
+#define ROUNDS 1024
+
+NET_BUF_POOL_FIXED_DEFINE(bench_pool, BUF_COUNT, BUF_SIZE, 4, NULL);
+
+static struct net_buf *bufs[BUF_COUNT];
+
+static void report(const char *name, uint32_t alloc_cyc, uint32_t free_cyc,
+		   uint32_t count)
+{
+	TC_PRINT("%s%s: alloc %llu ns, free %llu ns per buffer\n", name,
+		 IS_ENABLED(CONFIG_NET_BUF_LOCKLESS_FREE_LIST) ? " (lockless)" : "",
+		 k_cyc_to_ns_floor64(alloc_cyc) / count,
+		 k_cyc_to_ns_floor64(free_cyc) / count);
+}
+
+ZTEST(net_buf_bench, test_single)
+{
+	uint32_t start, alloc_cyc = 0, free_cyc = 0;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		start = k_cycle_get_32();
+		bufs[0] = net_buf_alloc(&bench_pool, K_NO_WAIT);
+		alloc_cyc += k_cycle_get_32() - start;
+
+		zassert_not_null(bufs[0], "Failed to get buffer");
+
+		start = k_cycle_get_32();
+		net_buf_unref(bufs[0]);
+		free_cyc += k_cycle_get_32() - start;
+	}
+
+	report("single", alloc_cyc, free_cyc, ROUNDS);
+}
+
+ZTEST(net_buf_bench, test_burst)
+{
+	uint32_t start, alloc_cyc = 0, free_cyc = 0;
+
+	for (int i = 0; i < ROUNDS / BUF_COUNT; i++) {
+		start = k_cycle_get_32();
+		for (int j = 0; j < BUF_COUNT; j++) {
+			bufs[j] = net_buf_alloc(&bench_pool, K_NO_WAIT);
+		}
+		alloc_cyc += k_cycle_get_32() - start;
+
+		for (int j = 0; j < BUF_COUNT; j++) {
+			zassert_not_null(bufs[j], "Failed to get buffer");
+		}
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < BUF_COUNT; j++) {
+			net_buf_unref(bufs[j]);
+		}
+		free_cyc += k_cycle_get_32() - start;
+	}
+
+	report("burst", alloc_cyc, free_cyc, ROUNDS);
+}
+
+ZTEST(net_buf_bench, test_chain)
+{
+	uint32_t start, alloc_cyc = 0, free_cyc = 0;
+	struct net_buf *head;
+
+	for (int i = 0; i < ROUNDS / BUF_COUNT; i++) {
+		start = k_cycle_get_32();
+		head = net_buf_alloc(&bench_pool, K_NO_WAIT);
+		for (int j = 1; j < BUF_COUNT; j++) {
+			net_buf_frag_add(head, net_buf_alloc(&bench_pool, K_NO_WAIT));
+		}
+		alloc_cyc += k_cycle_get_32() - start;
+
+		zassert_equal(net_buf_frags_len(head), 0, "Invalid chain");
+
+		start = k_cycle_get_32();
+		net_buf_unref(head);
+		free_cyc += k_cycle_get_32() - start;
+	}
+
+	report("chain", alloc_cyc, free_cyc, ROUNDS);
+}
+
+ZTEST_SUITE(net_buf_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,123 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Internet checksum benchmark
+ *
+ * Measures calc_chksum() and calc_chksum_copy() against a byte-pair
+ * reference loop for buffer sizes from 64 bytes to 64 KiB, both with an
+ * aligned and an odd start address.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_checksum_bench, LOG_LEVEL_INF);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+#include "net_private.h"
+
+#define MAX_LEN (64 * 1024)
+#define BYTES_PER_SIZE (1024 * 1024)
+
+static uint8_t src_buf[MAX_LEN + 8] __aligned(8);
+static uint8_t dst_buf[MAX_LEN + 8] __aligned(8);
+
+static const size_t sizes[] = {
+	64, 128, 256, 512, 1024, 1500, 4096, 9000, 16384, 32768, 65536,
+};
+
+static uint16_t chksum_ref(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint32_t acc = sum;
+
+	while (len > 1) {
+		acc += (data[0] << 8) | data[1];
+		data += 2;
+		len -= 2;
+	}
+
+	if (len) {
+		acc += data[0] << 8;
+	}
+
+	while (acc >> 16) {
+		acc = (acc & 0xffff) + (acc >> 16);
+	}
+
+	return acc;
+}
+
+static uint64_t cycles_to_ns(uint32_t cycles)
+{
+	return k_cyc_to_ns_floor64(cycles);
+}
+
+static void *setup(void)
+{
+	sys_rand_get(src_buf, sizeof(src_buf));
+
+	return NULL;
+}
+
+static void run(const char *name, size_t offset)
+{
+	TC_PRINT("%s, start offset %zu\n", name, offset);
+	TC_PRINT("%8s %8s %12s %12s %12s\n", "size", "rounds", "ref ns",
+		 "chksum ns", "copy ns");
+
+	ARRAY_FOR_EACH(sizes, i) {
+		const uint8_t *data = src_buf + offset;
+		size_t len = sizes[i];
+		size_t rounds = MAX(BYTES_PER_SIZE / len, 4);
+		uint32_t start, ref_cyc, sum_cyc, copy_cyc;
+		volatile uint16_t sink = 0;
+		uint16_t expected;
+
+		expected = chksum_ref(0, data, len);
+
+		zassert_equal(calc_chksum(0, data, len), expected,
+			      "Checksum mismatch at %zu bytes", len);
+		zassert_equal(calc_chksum_copy(0, dst_buf + offset, data, len),
+			      expected, "Copy checksum mismatch at %zu bytes", len);
+
+		start = k_cycle_get_32();
+		for (size_t r = 0; r < rounds; r++) {
+			sink += chksum_ref(0, data, len);
+		}
+		ref_cyc = k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (size_t r = 0; r < rounds; r++) {
+			sink += calc_chksum(0, data, len);
+		}
+		sum_cyc = k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (size_t r = 0; r < rounds; r++) {
+			sink += calc_chksum_copy(0, dst_buf + offset, data, len);
+		}
+		copy_cyc = k_cycle_get_32() - start;
+
+		TC_PRINT("%8zu %8zu %12llu %12llu %12llu\n", len, rounds,
+			 cycles_to_ns(ref_cyc) / rounds,
+			 cycles_to_ns(sum_cyc) / rounds,
+			 cycles_to_ns(copy_cyc) / rounds);
+	}
+}
+
+ZTEST(net_checksum, test_aligned)
+{
+	run("Aligned buffers", 0);
+}
+
+ZTEST(net_checksum, test_unaligned)
+{
+	run("Unaligned buffers", 1);
+}
+
+ZTEST_SUITE(net_checksum, NULL, setup, NULL, NULL, NULL);
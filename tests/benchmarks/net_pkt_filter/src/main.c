@@ -0,0 +1,176 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Packet filter benchmark
+ *
+ * Installs an IPv4 rule list of more than 100 rules, a block list of
+ * source addresses with one rule per address followed by rules testing
+ * the interface and the packet size, and measures the time taken to
+ * filter packets matching early, late or no rule, with or without
+ * CONFIG_NET_PKT_FILTER_COMPILED.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(npf_bench, LOG_LEVEL_INF);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+
+#define BLOCKED_COUNT 100
+#define SIZE_RULE_COUNT 24
+#define ROUNDS 200000
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(npf_bench, "npf_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+/* Block list of 192.0.2.0/24 addresses, one rule per address */
+#define BLOCKED_RULE_DEFINE(i, _)						\
+	static struct in_addr blocked_addr_##i[] = { { { { 192, 0, 2, i } } } };\
+	static NPF_IP_SRC_ADDR_ALLOWLIST(blocked_##i, blocked_addr_##i, 1, AF_INET);\
+	static NPF_RULE(blocked_rule_##i, NET_DROP, blocked_##i)
+
+LISTIFY(BLOCKED_COUNT, BLOCKED_RULE_DEFINE, (;));
+
+/* Drop packets of given sizes from the interface, none of the ones sent */
+#define SIZE_RULE_DEFINE(i, _)							\
+	static NPF_IFACE_MATCH(size_iface_##i, NULL);				\
+	static NPF_SIZE_BOUNDS(size_##i, 1000 + (i) * 10, 1009 + (i) * 10);	\
+	static NPF_RULE(size_rule_##i, NET_DROP, size_iface_##i, size_##i)
+
+LISTIFY(SIZE_RULE_COUNT, SIZE_RULE_DEFINE, (;));
+
+/* Accepted networks */
+static struct in_addr allowed_addrs[] = {
+	{ { { 198, 51, 100, 1 } } },
+	{ { { 198, 51, 100, 2 } } },
+	{ { { 203, 0, 113, 1 } } },
+	{ { { 203, 0, 113, 2 } } },
+};
+
+static NPF_IP_SRC_ADDR_ALLOWLIST(allowed, allowed_addrs, ARRAY_SIZE(allowed_addrs), AF_INET);
+static NPF_RULE(allowed_rule, NET_OK, allowed);
+
+#define BLOCKED_RULE_PTR(i, _) &blocked_rule_##i
+#define SIZE_RULE_PTR(i, _) &size_rule_##i
+#define SIZE_IFACE_PTR(i, _) &size_iface_##i
+
+static struct npf_rule *const rules[] = {
+	LISTIFY(BLOCKED_COUNT, BLOCKED_RULE_PTR, (,)),
+	LISTIFY(SIZE_RULE_COUNT, SIZE_RULE_PTR, (,)),
+	&allowed_rule,
+	&npf_default_drop,
+};
+
+static struct npf_test_iface *const size_ifaces[] = {
+	LISTIFY(SIZE_RULE_COUNT, SIZE_IFACE_PTR, (,)),
+};
+
+static const struct {
+	const char *name;
+	struct in_addr src;
+	bool accepted;
+} cases[] = {
+	{ "first rule", { { { 192, 0, 2, 0 } } }, false },
+	{ "block list end", { { { 192, 0, 2, BLOCKED_COUNT - 1 } } }, false },
+	{ "allowed", { { { 203, 0, 113, 2 } } }, true },
+	{ "no rule", { { { 233, 252, 0, 1 } } }, false },
+};
+
+static struct net_pkt *pkts[ARRAY_SIZE(cases)];
+
+static void *setup(void)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct in_addr dst = { { { 192, 0, 2, 254 } } };
+
+	zassert_not_null(iface, "No interface");
+
+	ARRAY_FOR_EACH(size_ifaces, i) {
+		size_ifaces[i]->iface = iface;
+	}
+
+	ARRAY_FOR_EACH(rules, i) {
+		npf_append_ipv4_recv_rule(rules[i]);
+	}
+
+	ARRAY_FOR_EACH(cases, i) {
+		pkts[i] = net_pkt_rx_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+						       AF_INET, 0, K_NO_WAIT);
+		zassert_not_null(pkts[i], "Cannot allocate packet");
+		zassert_ok(net_ipv4_create(pkts[i], &cases[i].src, &dst),
+			   "Cannot create packet");
+	}
+
+	return NULL;
+}
+
+ZTEST(npf_bench, test_verdicts)
+{
+	ARRAY_FOR_EACH(cases, i) {
+		zassert_equal(net_pkt_filter_ip_recv_ok(pkts[i]), cases[i].accepted,
+			      "Bad verdict for %s", cases[i].name);
+	}
+}
+
+ZTEST(npf_bench, test_filter)
+{
+	TC_PRINT("%zu rules, compiled %s, %d rounds\n", ARRAY_SIZE(rules),
+		 IS_ENABLED(CONFIG_NET_PKT_FILTER_COMPILED) ? "yes" : "no", ROUNDS);
+
+	ARRAY_FOR_EACH(cases, i) {
+		uint32_t start, cyc;
+
+		start = k_cycle_get_32();
+
+		for (int j = 0; j < ROUNDS; j++) {
+			(void)net_pkt_filter_ip_recv_ok(pkts[i]);
+		}
+
+		cyc = k_cycle_get_32() - start;
+
+		TC_PRINT("%s: %llu ns/packet\n", cases[i].name,
+			 k_cyc_to_ns_floor64(cyc) / ROUNDS);
+	}
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	npf_remove_all_ipv4_recv_rules();
+
+	ARRAY_FOR_EACH(pkts, i) {
+		net_pkt_unref(pkts[i]);
+	}
+}
+
+ZTEST_SUITE(npf_bench, NULL, setup, NULL, NULL, teardown);
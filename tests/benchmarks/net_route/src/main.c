@@ -0,0 +1,220 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief IPv6 route lookup benchmark
+ *
+ * Fills the routing table with prefixes of mixed lengths and measures
+ * net_route_lookup() for a set of destinations, some falling under the
+ * routes and some not. Every lookup result is checked against a brute
+ * force longest prefix match over the added routes.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_route_bench, LOG_LEVEL_INF);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+#define NUM_ROUTES CONFIG_NET_MAX_ROUTES
+#define NUM_DESTS 512
+#define ROUNDS 20
+
+/* Neighbor reference counts are 8 bits, so spread routes over some hops */
+#define NUM_NEXTHOPS 4
+
+static const uint8_t prefix_lens[] = { 48, 56, 64, 64, 64, 80, 96, 128 };
+
+/* 2001:db8::/32 documentation prefix */
+static const struct in6_addr base_addr = { { { 0x20, 0x01, 0x0d, 0xb8 } } };
+
+static struct in6_addr nexthop_addrs[NUM_NEXTHOPS];
+
+static struct net_route_entry *routes[NUM_ROUTES];
+static int num_routes;
+
+static struct in6_addr dests[NUM_DESTS];
+static struct net_route_entry *expected[NUM_DESTS];
+
+static struct net_if *iface;
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+static void random_addr(struct in6_addr *addr, const struct in6_addr *prefix,
+			uint8_t prefix_len)
+{
+	uint8_t bytes = prefix_len / 8U;
+
+	for (int i = 0; i < ARRAY_SIZE(addr->s6_addr32); i++) {
+		addr->s6_addr32[i] = sys_rand32_get();
+	}
+
+	/* Keep the routes in a narrow space so that prefixes overlap */
+	addr->s6_addr[4] &= 0x03;
+
+	memcpy(addr->s6_addr, prefix->s6_addr, bytes);
+	if (prefix_len % 8U) {
+		uint8_t mask = 0xff << (8U - (prefix_len % 8U));
+
+		addr->s6_addr[bytes] = (prefix->s6_addr[bytes] & mask) |
+				       (addr->s6_addr[bytes] & ~mask);
+	}
+}
+
+static struct net_route_entry *lookup_ref(struct in6_addr *dst)
+{
+	struct net_route_entry *found = NULL;
+
+	for (int i = 0; i < num_routes; i++) {
+		if ((found == NULL || routes[i]->prefix_len > found->prefix_len) &&
+		    net_ipv6_is_prefix(dst->s6_addr, routes[i]->addr.s6_addr,
+				       routes[i]->prefix_len)) {
+			found = routes[i];
+		}
+	}
+
+	return found;
+}
+
+static void *setup(void)
+{
+	struct net_linkaddr lladdr = {
+		.addr = mac_addr,
+		.len = sizeof(mac_addr),
+		.type = NET_LINK_ETHERNET,
+	};
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No interface");
+
+	for (int i = 0; i < NUM_NEXTHOPS; i++) {
+		struct in6_addr *addr = &nexthop_addrs[i];
+
+		net_ipv6_addr_create(addr, 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+
+		zassert_not_null(net_ipv6_nbr_add(iface, addr, &lladdr, false,
+						  NET_IPV6_NBR_STATE_REACHABLE),
+				 "Cannot add next hop neighbor");
+	}
+
+	for (int i = 0; i < NUM_ROUTES; i++) {
+		struct net_route_entry *route;
+		struct in6_addr addr;
+		uint8_t len = prefix_lens[sys_rand32_get() % ARRAY_SIZE(prefix_lens)];
+
+		random_addr(&addr, &base_addr, 32);
+
+		route = net_route_add(iface, &addr, len,
+				      &nexthop_addrs[i % NUM_NEXTHOPS],
+				      NET_IPV6_ND_INFINITE_LIFETIME,
+				      NET_ROUTE_PREFERENCE_MEDIUM);
+		zassert_not_null(route, "Route add failed");
+
+		routes[num_routes++] = route;
+	}
+
+	/* Half of the destinations fall under a route, the rest are random */
+	for (int i = 0; i < NUM_DESTS; i++) {
+		if (i % 2) {
+			struct net_route_entry *route = routes[i % num_routes];
+
+			random_addr(&dests[i], &route->addr, route->prefix_len);
+		} else {
+			random_addr(&dests[i], &base_addr, 32);
+		}
+
+		expected[i] = lookup_ref(&dests[i]);
+	}
+
+	return NULL;
+}
+
+ZTEST(net_route_bench, test_lookup)
+{
+	uint32_t start, cycles;
+	int hits = 0;
+
+	for (int i = 0; i < NUM_DESTS; i++) {
+		zassert_equal_ptr(net_route_lookup(iface, &dests[i]), expected[i],
+				  "Wrong route for destination %d", i);
+		hits += expected[i] != NULL;
+	}
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < NUM_DESTS; i++) {
+			(void)net_route_lookup(iface, &dests[i]);
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%d routes, %d destinations (%d routed), %d lookups\n",
+		 num_routes, NUM_DESTS, hits, ROUNDS * NUM_DESTS);
+	TC_PRINT("lpm trie %s, route cache %d entries: %llu ns per lookup\n",
+		 IS_ENABLED(CONFIG_NET_ROUTE_LPM_TRIE) ? "on" : "off",
+		 CONFIG_NET_ROUTE_CACHE_SIZE,
+		 k_cyc_to_ns_floor64(cycles) / (ROUNDS * NUM_DESTS));
+}
+
+ZTEST(net_route_bench, test_update)
+{
+	struct in6_addr addr;
+	struct net_route_entry *route;
+
+	/* Replacing routes keeps the index consistent with the table */
+	for (int i = 0; i < num_routes; i += 7) {
+		uint8_t len = routes[i]->prefix_len;
+
+		net_ipaddr_copy(&addr, &routes[i]->addr);
+		zassert_ok(net_route_del(routes[i]), "Route del failed");
+
+		route = net_route_add(iface, &addr, len,
+				      &nexthop_addrs[i % NUM_NEXTHOPS],
+				      NET_IPV6_ND_INFINITE_LIFETIME,
+				      NET_ROUTE_PREFERENCE_MEDIUM);
+		zassert_not_null(route, "Route add failed");
+
+		routes[i] = route;
+	}
+
+	for (int i = 0; i < NUM_DESTS; i++) {
+		zassert_equal_ptr(net_route_lookup(iface, &dests[i]),
+				  lookup_ref(&dests[i]),
+				  "Wrong route for destination %d", i);
+	}
+}
+
+ZTEST_SUITE(net_route_bench, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,201 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief TCP small writes benchmark
+ *
+ * Sends a stream of small writes over a loopback TCP connection and
+ * measures the throughput and the number of TCP segments sent with Nagle's
+ * algorithm, with TCP_NODELAY, with TCP_CORK and with MSG_MORE. Run with
+ * or without CONFIG_NET_TCP_AUTOCORK to see its effect on TCP_NODELAY.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+
+#define SERVER_PORT 4242
+#define WRITE_SIZE 64
+#define WRITES 1024
+#define WRITE_INTERVAL_US 10
+#define TOTAL_LEN (WRITE_SIZE * WRITES)
+#define ROUNDS 4
+#define RECV_TIMEOUT K_SECONDS(10)
+#define RECEIVER_STACK_SIZE 2048
+
+static int client_fd = -1;
+static int server_fd = -1;
+static int listen_fd = -1;
+
+static K_SEM_DEFINE(rx_done, 0, K_SEM_MAX_LIMIT);
+static size_t rx_total;
+
+static K_THREAD_STACK_DEFINE(receiver_stack, RECEIVER_STACK_SIZE);
+static struct k_thread receiver_thread;
+
+/* Signal each time a full round of data has been received */
+static void receiver(void *p1, void *p2, void *p3)
+{
+	static uint8_t buf[1024];
+	ssize_t ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		ret = zsock_recv(server_fd, buf, sizeof(buf), 0);
+		if (ret <= 0) {
+			return;
+		}
+
+		rx_total += ret;
+		while (rx_total >= TOTAL_LEN) {
+			rx_total -= TOTAL_LEN;
+			k_sem_give(&rx_done);
+		}
+	}
+}
+
+static uint32_t tcp_segments_sent(void)
+{
+	struct net_stats_tcp stats;
+
+	if (net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &stats, sizeof(stats)) < 0) {
+		return 0;
+	}
+
+	return stats.sent;
+}
+
+static void set_tcp_option(int optname, int value)
+{
+	zassert_ok(zsock_setsockopt(client_fd, IPPROTO_TCP, optname, &value, sizeof(value)),
+		   "Cannot set TCP option %d (%d)", optname, errno);
+}
+
+/* A blocking send may queue less than requested when the TX window fills */
+static int send_all(const uint8_t *data, size_t len, int flags)
+{
+	ssize_t ret;
+
+	while (len > 0) {
+		ret = zsock_send(client_fd, data, len, flags);
+		if (ret < 0) {
+			return ret;
+		}
+
+		data += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/* Send ROUNDS times TOTAL_LEN bytes in WRITE_SIZE writes */
+static void run(const char *mode, int nodelay, int cork, bool msg_more)
+{
+	static const uint8_t data[WRITE_SIZE];
+	uint32_t start, cyc, segs;
+	uint64_t us;
+
+	set_tcp_option(TCP_NODELAY, nodelay);
+
+	segs = tcp_segments_sent();
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		if (cork) {
+			set_tcp_option(TCP_CORK, 1);
+		}
+
+		for (int i = 0; i < WRITES; i++) {
+			int flags = (msg_more && i < WRITES - 1) ? ZSOCK_MSG_MORE : 0;
+
+			zassert_ok(send_all(data, sizeof(data), flags), "Cannot send (%d)", errno);
+
+			/* Time taken by the application to produce the next write */
+			k_busy_wait(WRITE_INTERVAL_US);
+		}
+
+		if (cork) {
+			set_tcp_option(TCP_CORK, 0);
+		}
+
+		zassert_ok(k_sem_take(&rx_done, RECV_TIMEOUT), "Data not received");
+	}
+
+	cyc = k_cycle_get_32() - start;
+	segs = tcp_segments_sent() - segs;
+	us = MAX(k_cyc_to_us_floor64(cyc), 1);
+
+	TC_PRINT("%s%s: %u writes of %d bytes in %llu us, %llu kB/s, %u segments, "
+		 "%llu segments/s\n", mode,
+		 IS_ENABLED(CONFIG_NET_TCP_AUTOCORK) ? " (autocork)" : "",
+		 ROUNDS * WRITES, WRITE_SIZE, us, (uint64_t)ROUNDS * TOTAL_LEN * 1000U / us,
+		 segs, (uint64_t)segs * USEC_PER_SEC / us);
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	listen_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listen_fd >= 0, "Cannot create socket (%d)", errno);
+	zassert_ok(zsock_bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)));
+	zassert_ok(zsock_listen(listen_fd, 1));
+
+	client_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(client_fd >= 0, "Cannot create socket (%d)", errno);
+	zassert_ok(zsock_connect(client_fd, (struct sockaddr *)&addr, sizeof(addr)));
+
+	server_fd = zsock_accept(listen_fd, NULL, NULL);
+	zassert_true(server_fd >= 0, "Cannot accept (%d)", errno);
+
+	k_thread_create(&receiver_thread, receiver_stack, K_THREAD_STACK_SIZEOF(receiver_stack),
+			receiver, NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	return NULL;
+}
+
+ZTEST(tcp_small_writes, test_nagle)
+{
+	run("Nagle", 0, 0, false);
+}
+
+ZTEST(tcp_small_writes, test_nodelay)
+{
+	run("TCP_NODELAY", 1, 0, false);
+}
+
+ZTEST(tcp_small_writes, test_cork)
+{
+	run("TCP_CORK", 1, 1, false);
+}
+
+ZTEST(tcp_small_writes, test_msg_more)
+{
+	run("MSG_MORE", 1, 0, true);
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zsock_close(client_fd);
+	zsock_close(server_fd);
+	zsock_close(listen_fd);
+	k_thread_join(&receiver_thread, K_SECONDS(1));
+}
+
+ZTEST_SUITE(tcp_small_writes, NULL, setup, NULL, NULL, teardown);
@@ -648,4 +648,132 @@ ZTEST(arp_fn_tests, test_arp)
 	}
 }
 
+#define ARP_TEST_ENTRIES CONFIG_NET_ARP_TABLE_SIZE
+
+struct arp_index_check {
+	struct in_addr addr;
+	struct net_eth_addr *hwaddr;
+	int found;
+};
+
+static void arp_index_cb(struct arp_entry *entry, void *user_data)
+{
+	struct arp_index_check *check = user_data;
+
+	if (net_ipv4_addr_cmp(&entry->ip, &check->addr)) {
+		check->found++;
+		check->hwaddr = &entry->eth;
+	}
+}
+
+/* Return the number of table entries for the address, and its hwaddr */
+static int arp_table_count(struct in_addr *addr, struct net_eth_addr **hwaddr)
+{
+	struct arp_index_check check = { .addr = *addr };
+
+	(void)net_arp_foreach(arp_index_cb, &check);
+
+	if (hwaddr) {
+		*hwaddr = check.hwaddr;
+	}
+
+	return check.found;
+}
+
+static void arp_test_addr(struct in_addr *addr, struct net_eth_addr *hwaddr,
+			  int idx, uint8_t hw_tag)
+{
+	*addr = (struct in_addr) { { { 10, 0, idx / 256, idx % 256 } } };
+	*hwaddr = (struct net_eth_addr) { { 0x02, 0x00, 0x5e, hw_tag, 0x00, idx } };
+}
+
+ZTEST(arp_fn_tests, test_arp_table_index)
+{
+	struct in_addr src = { { { 10, 0, 255, 1 } } };
+	struct in_addr addr, evicted, added;
+	struct net_eth_addr hwaddr, *found;
+	struct net_pkt *pkt;
+	struct net_if *iface;
+	int i;
+
+	net_arp_init();
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+	net_arp_clear_cache(iface);
+
+	/* Fill the table */
+	for (i = 0; i < ARP_TEST_ENTRIES; i++) {
+		arp_test_addr(&addr, &hwaddr, i, 0x00);
+		net_arp_update(iface, &addr, &hwaddr, false, true);
+	}
+
+	zassert_equal(net_arp_foreach(arp_index_cb, &(struct arp_index_check){ 0 }),
+		      ARP_TEST_ENTRIES, "Table not filled");
+
+	/* Known addresses are found through the index and updated in place,
+	 * nothing is evicted.
+	 */
+	for (i = 0; i < ARP_TEST_ENTRIES; i++) {
+		arp_test_addr(&addr, &hwaddr, i, 0x01);
+		net_arp_update(iface, &addr, &hwaddr, false, true);
+	}
+
+	for (i = 0; i < ARP_TEST_ENTRIES; i++) {
+		arp_test_addr(&addr, &hwaddr, i, 0x01);
+		zassert_equal(arp_table_count(&addr, &found), 1, "Entry %d not unique", i);
+		zassert_mem_equal(found, &hwaddr, sizeof(hwaddr), "Entry %d not updated", i);
+	}
+
+	/* A lookup marks the oldest entry as recently used */
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+	net_buf_add(pkt->buffer, sizeof(struct net_ipv4_hdr));
+
+	arp_test_addr(&addr, &hwaddr, 0, 0x01);
+	zassert_equal_ptr(net_arp_prepare(pkt, &addr, &src), pkt, "Entry not found");
+	zassert_mem_equal(net_pkt_lladdr_dst(pkt)->addr, &hwaddr, sizeof(hwaddr),
+			  "Wrong hwaddr");
+
+	net_pkt_unref(pkt);
+
+	/* So the next oldest entry is taken out for a new address, and it
+	 * leaves the index with it.
+	 */
+	arp_test_addr(&added, &hwaddr, ARP_TEST_ENTRIES, 0x00);
+	net_arp_update(iface, &added, &hwaddr, false, true);
+
+	arp_test_addr(&evicted, &hwaddr, ARP_TEST_ENTRIES > 1 ? 1 : 0, 0x00);
+	zassert_equal(arp_table_count(&evicted, NULL), 0, "LRU entry not evicted");
+	zassert_equal(arp_table_count(&added, NULL), 1, "New entry not added");
+
+	if (ARP_TEST_ENTRIES > 1) {
+		zassert_equal(arp_table_count(&addr, NULL), 1, "Used entry evicted");
+	}
+
+	/* An evicted address is added back as a new entry */
+	arp_test_addr(&evicted, &hwaddr, ARP_TEST_ENTRIES > 1 ? 1 : 0, 0x02);
+	net_arp_update(iface, &evicted, &hwaddr, false, true);
+
+	zassert_equal(arp_table_count(&evicted, &found), 1, "Entry not added back");
+	zassert_mem_equal(found, &hwaddr, sizeof(hwaddr), "Wrong hwaddr");
+	zassert_equal(net_arp_foreach(arp_index_cb, &(struct arp_index_check){ 0 }),
+		      ARP_TEST_ENTRIES, "Table size changed");
+
+	/* Clearing the table clears the index as well */
+	net_arp_clear_cache(iface);
+
+	for (i = 0; i <= ARP_TEST_ENTRIES; i++) {
+		arp_test_addr(&addr, &hwaddr, i, 0x03);
+		zassert_equal(arp_table_count(&addr, NULL), 0, "Entry %d not cleared", i);
+	}
+
+	arp_test_addr(&addr, &hwaddr, 0, 0x03);
+	net_arp_update(iface, &addr, &hwaddr, false, true);
+	zassert_equal(arp_table_count(&addr, &found), 1, "Entry not added");
+	zassert_mem_equal(found, &hwaddr, sizeof(hwaddr), "Wrong hwaddr");
+
+	net_arp_clear_cache(iface);
+}
+
 ZTEST_SUITE(arp_fn_tests, NULL, NULL, NULL, NULL, NULL);
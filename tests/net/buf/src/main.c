@@ -20,6 +20,7 @@
 #define USER_DATA_HEAP	4
 #define USER_DATA_FIXED	0
 #define USER_DATA_VAR	63
+#define USER_DATA_MULTI	8
 #define FIXED_BUFFER_SIZE 128
 
 struct bt_data {
@@ -67,10 +68,13 @@ static int destroy_called;
 static void buf_destroy(struct net_buf *buf);
 static void fixed_destroy(struct net_buf *buf);
 static void var_destroy(struct net_buf *buf);
+static void multi_destroy(struct net_buf *buf);
 
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, FIXED_BUFFER_SIZE, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_POOL_MULTI_DEFINE(multi_pool, 10, USER_DATA_MULTI, multi_destroy,
+			  (32, 2), (128, 2), (512, 1));
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -99,6 +103,15 @@ static void var_destroy(struct net_buf *buf)
 	net_buf_destroy(buf);
 }
 
+static void multi_destroy(struct net_buf *buf)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+	destroy_called++;
+	zassert_equal(pool, &multi_pool, "Invalid free pointer in buffer");
+	net_buf_destroy(buf);
+}
+
 static const char example_data[] = "0123456789"
 				   "abcdefghijklmnopqrstuvxyz"
 				   "!#¤%&/()=?";
@@ -207,6 +220,85 @@ ZTEST(net_buf_tests, test_net_buf_3)
 		     "Timeout while waiting for semaphore");
 }
 
+static void alloc_wait_thread(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg3);
+
+	struct net_buf **buf = (struct net_buf **)arg1;
+	struct k_sem *sema = (struct k_sem *)arg2;
+
+	*buf = net_buf_alloc_len(&fixed_pool, 20, TEST_TIMEOUT);
+
+	k_sem_give(sema);
+}
+
+static K_THREAD_STACK_DEFINE(alloc_wait_thread_stack, 1024);
+
+ZTEST(net_buf_tests, test_net_buf_alloc_wait)
+{
+	static struct k_thread alloc_wait_thread_data;
+	struct net_buf *bufs[fixed_pool.buf_count];
+	struct net_buf *buf = NULL;
+	static struct k_sem sema;
+	int i;
+
+	for (i = 0; i < fixed_pool.buf_count; i++) {
+		bufs[i] = net_buf_alloc_len(&fixed_pool, 20, K_NO_WAIT);
+		zassert_not_null(bufs[i], "Failed to get buffer");
+	}
+
+	zassert_is_null(net_buf_alloc_len(&fixed_pool, 20, K_NO_WAIT),
+			"Got buffer from exhausted pool");
+
+	k_sem_init(&sema, 0, UINT_MAX);
+
+	/* The thread blocks on the exhausted pool until a buffer is freed */
+	k_thread_create(&alloc_wait_thread_data, alloc_wait_thread_stack,
+			K_THREAD_STACK_SIZEOF(alloc_wait_thread_stack),
+			alloc_wait_thread, &buf, &sema, NULL,
+			K_PRIO_COOP(7), 0, K_NO_WAIT);
+
+	zassert_equal(k_sem_take(&sema, K_MSEC(100)), -EAGAIN,
+		      "Allocation did not wait");
+
+	net_buf_unref(bufs[0]);
+
+	zassert_ok(k_sem_take(&sema, TEST_TIMEOUT),
+		   "Timeout while waiting for semaphore");
+	zassert_equal(buf, bufs[0], "Freed buffer not handed over");
+
+	net_buf_unref(buf);
+
+	for (i = 1; i < fixed_pool.buf_count; i++) {
+		net_buf_unref(bufs[i]);
+	}
+}
+
+ZTEST(net_buf_tests, test_net_buf_pool_has_free)
+{
+	struct net_buf *bufs[fixed_pool.buf_count];
+	int i;
+
+	zassert_true(net_buf_pool_has_free(&fixed_pool), "Pool has no free buffer");
+
+	/* Run out of buffers, the second pass with freed ones only */
+	for (int pass = 0; pass < 2; pass++) {
+		for (i = 0; i < fixed_pool.buf_count; i++) {
+			bufs[i] = net_buf_alloc_len(&fixed_pool, 20, K_NO_WAIT);
+			zassert_not_null(bufs[i], "Failed to get buffer");
+		}
+
+		zassert_false(net_buf_pool_has_free(&fixed_pool), "Exhausted pool has a buffer");
+
+		net_buf_unref(bufs[0]);
+		zassert_true(net_buf_pool_has_free(&fixed_pool), "Freed buffer not found");
+
+		for (i = 1; i < fixed_pool.buf_count; i++) {
+			net_buf_unref(bufs[i]);
+		}
+	}
+}
+
 ZTEST(net_buf_tests, test_net_buf_4)
 {
 	struct net_buf *frags[bufs_pool.buf_count - 1];
@@ -529,6 +621,101 @@ ZTEST(net_buf_tests, test_net_buf_var_pool)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+static void check_multi_class(size_t idx, size_t size, uint32_t used,
+			      uint32_t allocs, uint32_t fallbacks, uint32_t failures)
+{
+	struct net_buf_multi_class_stats stats;
+
+	zassert_ok(net_buf_multi_class_stats_get(&multi_pool, idx, &stats),
+		   "Failed to get class stats");
+	zassert_equal(stats.size, size, "Invalid class size");
+	zassert_equal(stats.used, used, "Invalid used block count");
+
+	if (IS_ENABLED(CONFIG_NET_BUF_POOL_USAGE)) {
+		zassert_equal(stats.allocs, allocs, "Invalid alloc count");
+		zassert_equal(stats.fallbacks, fallbacks, "Invalid fallback count");
+		zassert_equal(stats.failures, failures, "Invalid failure count");
+	}
+}
+
+ZTEST(net_buf_tests, test_net_buf_multi_pool)
+{
+	struct net_buf *bufs[5], *buf, *clone;
+	struct net_buf_multi_class_stats stats;
+
+	destroy_called = 0;
+
+	/* Each request is served from the smallest fitting class */
+	bufs[0] = net_buf_alloc_len(&multi_pool, 20, K_NO_WAIT);
+	zassert_not_null(bufs[0], "Failed to get buffer");
+	zassert_equal(bufs[0]->size, 32, "Invalid buffer size");
+
+	bufs[1] = net_buf_alloc_len(&multi_pool, 100, K_NO_WAIT);
+	zassert_not_null(bufs[1], "Failed to get buffer");
+	zassert_equal(bufs[1]->size, 128, "Invalid buffer size");
+
+	bufs[2] = net_buf_alloc_len(&multi_pool, 32, K_NO_WAIT);
+	zassert_not_null(bufs[2], "Failed to get buffer");
+	zassert_equal(bufs[2]->size, 32, "Invalid buffer size");
+
+	/* Exhausted classes fall back to the next larger ones */
+	bufs[3] = net_buf_alloc_len(&multi_pool, 10, K_NO_WAIT);
+	zassert_not_null(bufs[3], "Failed to get buffer");
+	zassert_equal(bufs[3]->size, 128, "Invalid buffer size");
+
+	bufs[4] = net_buf_alloc_len(&multi_pool, 10, K_NO_WAIT);
+	zassert_not_null(bufs[4], "Failed to get buffer");
+	zassert_equal(bufs[4]->size, 512, "Invalid buffer size");
+
+	buf = net_buf_alloc_len(&multi_pool, 10, K_NO_WAIT);
+	zassert_is_null(buf, "Got buffer from exhausted pool");
+
+	/* Larger than the largest class */
+	buf = net_buf_alloc_len(&multi_pool, 513, K_NO_WAIT);
+	zassert_is_null(buf, "Got too large buffer");
+
+	zassert_equal(destroy_called, 0, "Incorrect destroy callback count");
+
+	check_multi_class(0, 32, 2, 2, 0, 1);
+	check_multi_class(1, 128, 2, 2, 1, 0);
+	check_multi_class(2, 512, 1, 1, 1, 0);
+	zassert_equal(net_buf_multi_class_stats_get(&multi_pool, 3, &stats), -ENOENT,
+		      "Got stats for missing class");
+	zassert_equal(net_buf_multi_class_stats_get(&var_pool, 0, &stats), -EINVAL,
+		      "Got stats for variable size pool");
+
+	/* Data is shared by clones and freed with the last reference */
+	clone = net_buf_clone(bufs[1], K_NO_WAIT);
+	zassert_not_null(clone, "Failed to clone buffer");
+	zassert_equal(clone->data, bufs[1]->data, "Cloned data doesn't match");
+
+	net_buf_unref(bufs[1]);
+	check_multi_class(1, 128, 2, 2, 1, 0);
+
+	net_buf_unref(clone);
+	check_multi_class(1, 128, 1, 2, 1, 0);
+
+	buf = net_buf_alloc_fixed(&multi_pool, K_NO_WAIT);
+	zassert_is_null(buf, "Got buffer from exhausted class");
+
+	net_buf_unref(bufs[4]);
+
+	buf = net_buf_alloc_fixed(&multi_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+	zassert_equal(buf->size, 512, "Invalid buffer size");
+	net_buf_unref(buf);
+
+	net_buf_unref(bufs[0]);
+	net_buf_unref(bufs[2]);
+	net_buf_unref(bufs[3]);
+
+	check_multi_class(0, 32, 0, 2, 0, 1);
+	check_multi_class(1, 128, 0, 2, 1, 0);
+	check_multi_class(2, 512, 0, 2, 1, 1);
+
+	zassert_equal(destroy_called, 7, "Incorrect destroy callback count");
+}
+
 ZTEST(net_buf_tests, test_net_buf_byte_order)
 {
 	struct net_buf *buf;
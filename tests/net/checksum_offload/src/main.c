@@ -364,6 +364,11 @@ static int eth_tx_offloading_disabled(const struct device *dev,
 
 		zassert_not_equal(chksum, 0, "Checksum not calculated");
 
+		if (test_proto == IPPROTO_UDP) {
+			zassert_not_equal(net_pkt_data_chksum_len(pkt), 0,
+					  "Payload not summed");
+		}
+
 		k_sem_give(&wait_data_nonoff);
 	}
 
@@ -406,6 +411,7 @@ static int eth_tx_offloading_enabled(const struct device *dev,
 		DBG("Chksum 0x%x offloading enabled\n", chksum);
 
 		zassert_equal(chksum, 0, "Checksum calculated");
+		zassert_equal(net_pkt_data_chksum_len(pkt), 0, "Payload summed");
 
 		k_sem_give(&wait_data_off);
 	}
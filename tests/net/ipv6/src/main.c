@@ -2175,6 +2175,75 @@ ZTEST(net_ipv6, test_nd_reachability_hint)
 	zassert_equal(net_ipv6_nbr_data(nbr)->state, NET_IPV6_NBR_STATE_REACHABLE);
 }
 
+static void stale_nbr_addr(struct in6_addr *addr, uint8_t i)
+{
+	net_ipv6_addr_create(addr, 0x2001, 0x0db8, 0, 0, 0, 0, 0x5a1e, i);
+}
+
+ZTEST(net_ipv6, test_nbr_stale_eviction)
+{
+	uint8_t mac[] = { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x11 };
+	struct net_linkaddr lladdr = {
+		.addr = mac,
+		.len = sizeof(mac),
+		.type = NET_LINK_ETHERNET,
+	};
+	const int count = CONFIG_NET_IPV6_MAX_NEIGHBORS + 1;
+	struct in6_addr addr;
+	int oldest = -1;
+
+	/* Fill the table with stale neighbors, the oldest ones are evicted */
+	for (int i = 0; i < count; i++) {
+		stale_nbr_addr(&addr, i);
+		zassert_not_null(net_ipv6_nbr_add(TEST_NET_IF, &addr, &lladdr, false,
+						  NET_IPV6_NBR_STATE_STALE),
+				 "Cannot add neighbor %d", i);
+	}
+
+	for (int i = 0; i < count; i++) {
+		stale_nbr_addr(&addr, i);
+		if (net_ipv6_nbr_lookup(TEST_NET_IF, &addr) != NULL) {
+			oldest = i;
+			break;
+		}
+	}
+
+	zassert_true(oldest > 0, "Oldest stale neighbor not evicted");
+
+	/* All neighbors added after the oldest one left must be found */
+	for (int i = oldest; i < count; i++) {
+		stale_nbr_addr(&addr, i);
+		zassert_not_null(net_ipv6_nbr_lookup(TEST_NET_IF, &addr),
+				 "Neighbor %d not found", i);
+	}
+
+	/* A neighbor that is not stale anymore is not evicted, the next
+	 * oldest stale one is.
+	 */
+	if (oldest + 1 < count) {
+		stale_nbr_addr(&addr, oldest);
+		net_ipv6_nbr_reachability_hint(TEST_NET_IF, &addr);
+
+		stale_nbr_addr(&addr, count);
+		zassert_not_null(net_ipv6_nbr_add(TEST_NET_IF, &addr, &lladdr, false,
+						  NET_IPV6_NBR_STATE_STALE),
+				 "Cannot add neighbor %d", count);
+
+		stale_nbr_addr(&addr, oldest);
+		zassert_not_null(net_ipv6_nbr_lookup(TEST_NET_IF, &addr),
+				 "Reachable neighbor evicted");
+
+		stale_nbr_addr(&addr, oldest + 1);
+		zassert_is_null(net_ipv6_nbr_lookup(TEST_NET_IF, &addr),
+				"Oldest stale neighbor not evicted");
+	}
+
+	for (int i = 0; i <= count; i++) {
+		stale_nbr_addr(&addr, i);
+		(void)net_ipv6_nbr_rm(TEST_NET_IF, &addr);
+	}
+}
+
 static bool is_pe_address_found(struct net_if *iface, struct in6_addr *prefix)
 {
 	struct net_if_ipv6 *ipv6;
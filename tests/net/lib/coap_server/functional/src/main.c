@@ -0,0 +1,337 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_service.h>
+
+#define SERVER_PORT 5683
+#define OTHER_PORT 5684
+#define RECV_TIMEOUT_MS 1000
+#define OBSERVERS 4
+
+static const uint16_t test_service_port = SERVER_PORT;
+COAP_SERVICE_DEFINE(test_service, "127.0.0.1", &test_service_port, COAP_SERVICE_AUTOSTART);
+
+static const uint16_t other_service_port = OTHER_PORT;
+COAP_SERVICE_DEFINE(other_service, "127.0.0.1", &other_service_port, 0);
+
+static const char payload[] = "22.5 C";
+
+static K_SEM_DEFINE(slow_started, 0, 1);
+static K_SEM_DEFINE(slow_release, 0, 1);
+static k_tid_t fast_thread;
+static atomic_t fast_calls;
+static atomic_t other_calls;
+
+static int send_content(struct coap_resource *resource, struct coap_packet *request,
+			struct sockaddr *addr, socklen_t addr_len)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet response;
+	int ret;
+
+	ret = coap_ack_init(&response, request, buf, sizeof(buf), COAP_RESPONSE_CODE_CONTENT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
+
+static int fast_get(struct coap_resource *resource, struct coap_packet *request,
+		    struct sockaddr *addr, socklen_t addr_len)
+{
+	fast_thread = k_current_get();
+	atomic_inc(&fast_calls);
+
+	return send_content(resource, request, addr, addr_len);
+}
+
+/* Blocks its handler thread until the test releases it */
+static int slow_get(struct coap_resource *resource, struct coap_packet *request,
+		    struct sockaddr *addr, socklen_t addr_len)
+{
+	k_sem_give(&slow_started);
+	(void)k_sem_take(&slow_release, K_SECONDS(2));
+
+	return send_content(resource, request, addr, addr_len);
+}
+
+static int obs_get(struct coap_resource *resource, struct coap_packet *request,
+		   struct sockaddr *addr, socklen_t addr_len)
+{
+	int ret;
+
+	ret = coap_resource_parse_observe(resource, request, addr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return send_content(resource, request, addr, addr_len);
+}
+
+static int other_get(struct coap_resource *resource, struct coap_packet *request,
+		     struct sockaddr *addr, socklen_t addr_len)
+{
+	atomic_inc(&other_calls);
+
+	return send_content(resource, request, addr, addr_len);
+}
+
+static const char * const fast_path[] = { "fast", NULL };
+COAP_RESOURCE_DEFINE(fast_resource, test_service, {
+	.get = fast_get,
+	.path = fast_path,
+});
+
+static const char * const slow_path[] = { "slow", NULL };
+COAP_RESOURCE_DEFINE(slow_resource, test_service, {
+	.get = slow_get,
+	.path = slow_path,
+});
+
+static const char * const obs_path[] = { "obs", NULL };
+COAP_RESOURCE_DEFINE(obs_resource, test_service, {
+	.get = obs_get,
+	.path = obs_path,
+});
+
+/* Same path as the fast resource of the test service */
+COAP_RESOURCE_DEFINE(other_resource, other_service, {
+	.get = other_get,
+	.path = fast_path,
+});
+
+static int client_fd = -1;
+
+static void send_get(const char *path, const uint8_t *token, uint8_t tkl, bool observe)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet request;
+
+	zassert_ok(coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				    tkl, token, COAP_METHOD_GET, coap_next_id()));
+
+	if (observe) {
+		zassert_ok(coap_append_option_int(&request, COAP_OPTION_OBSERVE, 0));
+	}
+
+	zassert_ok(coap_packet_append_option(&request, COAP_OPTION_URI_PATH, path,
+					     strlen(path)));
+
+	zassert_equal(zsock_send(client_fd, request.data, request.offset, 0), request.offset,
+		      "Cannot send request (%d)", errno);
+}
+
+static void recv_packet(struct coap_packet *cpkt, uint8_t *buf, size_t len)
+{
+	int ret;
+
+	ret = zsock_recv(client_fd, buf, len, 0);
+	zassert_true(ret > 0, "No response (%d)", errno);
+
+	zassert_ok(coap_packet_parse(cpkt, buf, ret, NULL, 0));
+}
+
+/* Receive the response of a request sent with a one byte token */
+static uint8_t recv_response(void)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	struct coap_packet response;
+
+	recv_packet(&response, buf, sizeof(buf));
+
+	zassert_equal(coap_header_get_code(&response), COAP_RESPONSE_CODE_CONTENT,
+		      "Unexpected response code");
+	zassert_equal(coap_header_get_token(&response, token), 1U, "Unexpected token");
+
+	return token[0];
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct zsock_timeval tv = {
+		.tv_sec = RECV_TIMEOUT_MS / 1000,
+	};
+
+	/* Let the server thread start the service. */
+	k_msleep(100);
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	client_fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(client_fd >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)));
+	zassert_ok(zsock_connect(client_fd, (struct sockaddr *)&addr, sizeof(addr)));
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&slow_started);
+	k_sem_reset(&slow_release);
+}
+
+ZTEST(coap_server, test_dispatch)
+{
+	const char *name;
+
+	send_get(fast_path[0], (uint8_t []){ 0x01 }, 1U, false);
+	zassert_equal(recv_response(), 0x01, "Wrong response");
+
+	/* Requests are handled by the workers, if any, or by the server thread */
+	name = k_thread_name_get(fast_thread);
+	zassert_not_null(name);
+
+	if (CONFIG_COAP_SERVER_WORKERS > 0) {
+		zassert_str_equal(name, "coap_worker");
+	} else {
+		zassert_str_equal(name, "coap_server_id");
+	}
+}
+
+ZTEST(coap_server, test_dispatch_concurrent)
+{
+	if (CONFIG_COAP_SERVER_WORKERS < 2) {
+		ztest_test_skip();
+	}
+
+	send_get(slow_path[0], (uint8_t []){ 0x01 }, 1U, false);
+	zassert_ok(k_sem_take(&slow_started, K_MSEC(RECV_TIMEOUT_MS)), "Slow handler not run");
+
+	/* Another worker answers while the slow handler is blocked */
+	send_get(fast_path[0], (uint8_t []){ 0x02 }, 1U, false);
+	zassert_equal(recv_response(), 0x02, "Fast request not answered first");
+
+	k_sem_give(&slow_release);
+	zassert_equal(recv_response(), 0x01, "Slow request not answered");
+}
+
+ZTEST(coap_server, test_dispatch_stopped_service)
+{
+	atomic_val_t calls = atomic_get(&fast_calls);
+
+	if (CONFIG_COAP_SERVER_WORKERS != 1) {
+		ztest_test_skip();
+	}
+
+	/* Keep the only worker busy, so that the next request is queued */
+	send_get(slow_path[0], (uint8_t []){ 0x01 }, 1U, false);
+	zassert_ok(k_sem_take(&slow_started, K_MSEC(RECV_TIMEOUT_MS)), "Slow handler not run");
+
+	send_get(fast_path[0], (uint8_t []){ 0x02 }, 1U, false);
+	k_msleep(50);
+
+	/* The other service can get the socket descriptor of the stopped one */
+	zassert_ok(coap_service_stop(&test_service));
+	zassert_ok(coap_service_start(&other_service));
+
+	k_sem_give(&slow_release);
+	k_msleep(50);
+
+	zassert_equal(atomic_get(&fast_calls), calls, "Request of a stopped service handled");
+	zassert_equal(atomic_get(&other_calls), 0, "Request handled by another service");
+
+	zassert_ok(coap_service_stop(&other_service));
+	zassert_ok(coap_service_start(&test_service));
+
+	/* The service is back */
+	send_get(fast_path[0], (uint8_t []){ 0x03 }, 1U, false);
+	zassert_equal(recv_response(), 0x03, "Wrong response");
+}
+
+ZTEST(coap_server, test_notify_observers)
+{
+	static const uint8_t tkls[OBSERVERS] = { 1U, 8U, 3U, 5U };
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t tokens[OBSERVERS][COAP_TOKEN_MAX_LEN];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint16_t ids[OBSERVERS];
+	struct coap_packet cpkt;
+	bool seen[OBSERVERS] = { 0 };
+	const uint8_t *data;
+	uint16_t data_len;
+	int age = 2;
+	uint8_t tkl;
+	int i, j;
+
+	for (i = 0; i < OBSERVERS; i++) {
+		memset(tokens[i], 0xa0 + i, tkls[i]);
+		send_get(obs_path[0], tokens[i], tkls[i], true);
+
+		recv_packet(&cpkt, buf, sizeof(buf));
+		zassert_equal(coap_header_get_code(&cpkt), COAP_RESPONSE_CODE_CONTENT);
+	}
+
+	zassert_equal(sys_slist_len(&obs_resource.observers), OBSERVERS,
+		      "Not all observers registered");
+
+	/* The notification is built once, without token */
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_NON_CON,
+				    0U, NULL, COAP_RESPONSE_CODE_CONTENT, 0U));
+	zassert_ok(coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, age));
+	zassert_ok(coap_packet_append_payload_marker(&cpkt));
+	zassert_ok(coap_packet_append_payload(&cpkt, payload, sizeof(payload) - 1));
+
+	zassert_equal(coap_resource_notify_observers(&obs_resource, &cpkt, NULL), OBSERVERS,
+		      "Not all observers notified");
+
+	/* Each observer gets the notification with its own token and ID */
+	for (i = 0; i < OBSERVERS; i++) {
+		uint8_t rx_buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+		struct coap_packet notification;
+
+		recv_packet(&notification, rx_buf, sizeof(rx_buf));
+
+		tkl = coap_header_get_token(&notification, token);
+		for (j = 0; j < OBSERVERS; j++) {
+			if (tkl == tkls[j] && memcmp(token, tokens[j], tkl) == 0) {
+				break;
+			}
+		}
+
+		zassert_true(j < OBSERVERS, "Unknown token");
+		zassert_false(seen[j], "Observer notified twice");
+		seen[j] = true;
+
+		ids[i] = coap_header_get_id(&notification);
+		for (j = 0; j < i; j++) {
+			zassert_not_equal(ids[i], ids[j], "Message ID reused");
+		}
+
+		zassert_equal(coap_get_option_int(&notification, COAP_OPTION_OBSERVE), age);
+
+		data = coap_packet_get_payload(&notification, &data_len);
+		zassert_equal(data_len, sizeof(payload) - 1, "Wrong payload length");
+		zassert_mem_equal(data, payload, data_len, "Wrong payload");
+	}
+
+	/* Notifications with a token are rejected */
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_NON_CON,
+				    tkls[0], tokens[0], COAP_RESPONSE_CODE_CONTENT, 0U));
+	zassert_equal(coap_resource_notify_observers(&obs_resource, &cpkt, NULL), -EINVAL);
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zsock_close(client_fd);
+}
+
+ZTEST_SUITE(coap_server, NULL, setup, before, NULL, teardown);
@@ -133,3 +133,96 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_distinct_queries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[32];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%zu.example.com", i);
+		info_write.ai_addrlen = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%zu.example.com", i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+		zassert_equal(i, info_read.ai_addrlen);
+	}
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "host3.example.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "host3.example.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host4.example.com", &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_least_recently_used_removed)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[32];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%zu.example.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	/* The oldest entry is used again, so the next one is evicted */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host0.example.com", &info_read, 1));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host0.example.com", &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "host1.example.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example.com", &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_query_type)
+{
+	struct dns_addrinfo info_ipv4 = {.ai_family = AF_INET};
+	struct dns_addrinfo info_ipv6 = {.ai_family = AF_INET6};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_ipv4, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_ipv6, TEST_DNS_CACHE_DEFAULT_TTL));
+
+	zassert_equal(2, dns_cache_find(&test_dns_cache, query, info_read, 2));
+	zassert_equal(1, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					     info_read, 2, NULL));
+	zassert_equal(AF_INET, info_read[0].ai_family);
+	zassert_equal(1, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					     info_read, 2, NULL));
+	zassert_equal(AF_INET6, info_read[0].ai_family);
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+	int status = 0;
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					  DNS_EAI_NODATA, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(-ENODATA, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+						    &info_read, 1, &status));
+	zassert_equal(DNS_EAI_NODATA, status);
+	zassert_equal(0, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					     &info_read, 1, NULL));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					     &info_read, 1, NULL));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					     &info_read, 1, NULL));
+}
@@ -26,6 +26,8 @@ LOG_MODULE_REGISTER(net_test, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
+#include "ipv4.h"
+#include "udp_internal.h"
 
 #if defined(CONFIG_DNS_RESOLVER_LOG_LEVEL_DBG)
 #define DBG(fmt, ...) printk(fmt, ##__VA_ARGS__)
@@ -37,6 +39,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #define NAME6 "6.zephyr.test"
 #define NAME_IPV4 "192.0.2.1"
 #define NAME_IPV6 "2001:db8::1"
+#define NAME_COALESCE "c.zephyr.test"
 
 #define DNS_TIMEOUT 500 /* ms */
 #define THREAD_SLEEP 10
@@ -64,11 +67,21 @@ static struct net_if *iface1;
 static bool test_failed;
 static bool test_started;
 static bool timeout_query;
+static atomic_t sent_queries;
 static struct k_sem wait_data;
 static struct k_sem wait_data2;
 static uint16_t current_dns_id;
 static struct dns_addrinfo addrinfo;
 
+/* Last IPv4 query sent, used to build an answer to it */
+static bool capture_query;
+static struct in_addr query_src;
+static struct in_addr query_dst;
+static uint16_t query_sport;
+static uint16_t query_dport;
+static uint8_t query_msg[64];
+static size_t query_msg_len;
+
 /* this must be higher that the DNS_TIMEOUT */
 #define WAIT_TIME K_MSEC(DNS_TIMEOUT + 300)
 
@@ -120,6 +133,32 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -1;
 }
 
+static void capture_dns_query(struct net_pkt *pkt)
+{
+	uint8_t buf[NET_IPV4H_LEN + NET_UDPH_LEN + sizeof(query_msg)];
+	size_t len = MIN(net_pkt_get_len(pkt), sizeof(buf));
+	size_t hdr_len;
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_read(pkt, buf, len) < 0) {
+		return;
+	}
+
+	hdr_len = (buf[0] & 0x0f) * 4U + NET_UDPH_LEN;
+	if (len <= hdr_len) {
+		return;
+	}
+
+	memcpy(&query_src, &buf[12], sizeof(query_src));
+	memcpy(&query_dst, &buf[16], sizeof(query_dst));
+	query_sport = sys_get_be16(&buf[hdr_len - NET_UDPH_LEN]);
+	query_dport = sys_get_be16(&buf[hdr_len - NET_UDPH_LEN + 2]);
+
+	query_msg_len = len - hdr_len;
+	memcpy(query_msg, &buf[hdr_len], query_msg_len);
+}
+
 static int sender_iface(const struct device *dev, struct net_pkt *pkt)
 {
 	if (!pkt->frags) {
@@ -127,6 +166,12 @@ static int sender_iface(const struct device *dev, struct net_pkt *pkt)
 		return -ENODATA;
 	}
 
+	atomic_inc(&sent_queries);
+
+	if (capture_query && net_pkt_family(pkt) == AF_INET) {
+		capture_dns_query(pkt);
+	}
+
 	if (!timeout_query) {
 		struct net_if_test *data = dev->data;
 		struct dns_resolve_context *ctx;
@@ -429,6 +474,11 @@ ZTEST(dns_resolve, test_dns_query_too_many)
 	int expected_status = DNS_EAI_CANCELED;
 	int ret;
 
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES > 1) {
+		/* The second query would wait for the answer of the first */
+		ztest_test_skip();
+	}
+
 	timeout_query = true;
 
 	ret = dns_get_addr_info(NAME4,
@@ -569,6 +619,120 @@ ZTEST(dns_resolve, test_dns_query_ipv6_cancel)
 	verify_cancelled();
 }
 
+ZTEST(dns_resolve, test_dns_query_coalesce_timeout)
+{
+	int expected_status = DNS_EAI_CANCELED;
+	atomic_val_t sent;
+	int ret;
+
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES < 2) {
+		ztest_test_skip();
+	}
+
+	timeout_query = true;
+	sent = atomic_get(&sent_queries);
+
+	for (int i = 0; i < 2; i++) {
+		ret = dns_get_addr_info(NAME4,
+					DNS_QUERY_TYPE_A,
+					NULL,
+					dns_result_cb_timeout,
+					INT_TO_POINTER(expected_status),
+					DNS_TIMEOUT);
+		zassert_equal(ret, 0, "Cannot create IPv4 query");
+	}
+
+	k_msleep(THREAD_SLEEP);
+	zassert_equal(atomic_get(&sent_queries) - sent, 1,
+		      "Same query sent twice");
+
+	/* The timeout of the sent query ends both queries */
+	for (int i = 0; i < 2; i++) {
+		if (k_sem_take(&wait_data, WAIT_TIME)) {
+			zassert_true(false, "Timeout while waiting data");
+		}
+	}
+
+	timeout_query = false;
+}
+
+ZTEST(dns_resolve, test_dns_query_coalesce_cancel)
+{
+	int expected_status = DNS_EAI_CANCELED;
+	uint16_t dns_id[2];
+	int ret;
+
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES < 2) {
+		ztest_test_skip();
+	}
+
+	timeout_query = true;
+
+	for (int i = 0; i < 2; i++) {
+		ret = dns_get_addr_info(NAME4,
+					DNS_QUERY_TYPE_A,
+					&dns_id[i],
+					dns_result_cb_timeout,
+					INT_TO_POINTER(expected_status),
+					DNS_TIMEOUT);
+		zassert_equal(ret, 0, "Cannot create IPv4 query");
+	}
+
+	/* Cancelling the sent query leaves the other one waiting */
+	ret = dns_cancel_addr_info(dns_id[0]);
+	zassert_equal(ret, 0, "Cannot cancel IPv4 query");
+	zassert_ok(k_sem_take(&wait_data, K_NO_WAIT), "Query not cancelled");
+	zassert_not_ok(k_sem_take(&wait_data, K_NO_WAIT), "Both queries cancelled");
+
+	ret = dns_cancel_addr_info(dns_id[1]);
+	zassert_equal(ret, 0, "Cannot cancel waiting IPv4 query");
+	zassert_ok(k_sem_take(&wait_data, K_NO_WAIT), "Query not cancelled");
+
+	/* The sent query still runs until its timeout, without callback */
+	k_msleep(DNS_TIMEOUT + THREAD_SLEEP);
+	zassert_not_ok(k_sem_take(&wait_data, K_NO_WAIT), "Unexpected callback");
+
+	timeout_query = false;
+}
+
+ZTEST(dns_resolve, test_dns_query_coalesce_follower_timeout)
+{
+	int expected_status = DNS_EAI_CANCELED;
+	int ret;
+
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES < 2) {
+		ztest_test_skip();
+	}
+
+	timeout_query = true;
+
+	ret = dns_get_addr_info(NAME4,
+				DNS_QUERY_TYPE_A,
+				NULL,
+				dns_result_cb_timeout,
+				INT_TO_POINTER(expected_status),
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create IPv4 query");
+
+	ret = dns_get_addr_info(NAME4,
+				DNS_QUERY_TYPE_A,
+				NULL,
+				dns_result_cb_timeout,
+				INT_TO_POINTER(expected_status),
+				DNS_TIMEOUT / 5);
+	zassert_equal(ret, 0, "Cannot create waiting IPv4 query");
+
+	/* The waiting query gives up on its own, shorter, timeout */
+	zassert_ok(k_sem_take(&wait_data, K_MSEC(DNS_TIMEOUT / 2)),
+		   "Waiting query did not time out");
+	zassert_not_ok(k_sem_take(&wait_data, K_NO_WAIT),
+		       "Sent query timed out too early");
+
+	zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Sent query did not time out");
+
+	timeout_query = false;
+}
+
 struct expected_status {
 	int status1;
 	int status2;
@@ -593,6 +757,126 @@ void dns_result_cb(enum dns_resolve_status status,
 	k_sem_give(&wait_data2);
 }
 
+/* Answer the captured query, with the addresses and ports swapped */
+static struct net_pkt *prepare_dns_answer(void)
+{
+	static const uint8_t answer[] = {
+		0xc0, 0x0c,		/* Name, pointer to the question */
+		0x00, 0x01,		/* Type A */
+		0x00, 0x01,		/* Class IN */
+		0x00, 0x00, 0x00, 0x3c,	/* TTL */
+		0x00, 0x04,		/* Data length */
+		192, 0, 2, 10,		/* Address */
+	};
+	uint8_t msg[sizeof(query_msg) + sizeof(answer)];
+	struct net_pkt *pkt;
+	size_t len;
+
+	memcpy(msg, query_msg, query_msg_len);
+	memcpy(&msg[query_msg_len], answer, sizeof(answer));
+	len = query_msg_len + sizeof(answer);
+
+	/* Response without error, with one answer */
+	msg[2] |= 0x80;
+	msg[3] = 0x80;
+	sys_put_be16(1, &msg[6]);
+
+	pkt = net_pkt_alloc_with_buffer(iface1, len, AF_INET, IPPROTO_UDP,
+					K_FOREVER);
+	zassert_not_null(pkt, "Cannot allocate answer");
+
+	zassert_ok(net_ipv4_create(pkt, &query_dst, &query_src));
+	zassert_ok(net_udp_create(pkt, htons(query_dport), htons(query_sport)));
+	zassert_ok(net_pkt_write(pkt, msg, len));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_UDP));
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+ZTEST(dns_resolve, test_dns_query_coalesce_cancel_leader)
+{
+	struct expected_status status = {
+		.status1 = DNS_EAI_INPROGRESS,
+		.status2 = DNS_EAI_ALLDONE,
+		.caller = __func__,
+	};
+	char name[sizeof(NAME_COALESCE)];
+	atomic_val_t sent;
+	uint16_t dns_id;
+	int ret;
+
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES < 3) {
+		ztest_test_skip();
+	}
+
+	timeout_query = true;
+	capture_query = true;
+	query_msg_len = 0;
+	k_sem_reset(&wait_data);
+	k_sem_reset(&wait_data2);
+
+	strcpy(name, NAME_COALESCE);
+
+	ret = dns_get_addr_info(name,
+				DNS_QUERY_TYPE_A,
+				&dns_id,
+				dns_result_cb_timeout,
+				INT_TO_POINTER(DNS_EAI_CANCELED),
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create IPv4 query");
+
+	ret = dns_get_addr_info(NAME_COALESCE,
+				DNS_QUERY_TYPE_A,
+				NULL,
+				dns_result_cb,
+				&status,
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create waiting IPv4 query");
+
+	/* Cancel the sent query, its caller no longer owns the name */
+	ret = dns_cancel_addr_info(dns_id);
+	zassert_equal(ret, 0, "Cannot cancel IPv4 query");
+	zassert_ok(k_sem_take(&wait_data, K_NO_WAIT), "Query not cancelled");
+	memset(name, 0, sizeof(name));
+
+	/* The query still runs for the same name */
+	sent = atomic_get(&sent_queries);
+
+	ret = dns_get_addr_info(NAME_COALESCE,
+				DNS_QUERY_TYPE_A,
+				NULL,
+				dns_result_cb,
+				&status,
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create waiting IPv4 query");
+
+	k_msleep(THREAD_SLEEP);
+	zassert_equal(atomic_get(&sent_queries), sent, "Same query sent twice");
+	zassert_true(query_msg_len > 0, "Query not captured");
+
+	zassert_ok(net_recv_data(iface1, prepare_dns_answer()),
+		   "Cannot receive answer");
+
+	/* Both waiting queries get the address and the end of results */
+	for (int i = 0; i < 4; i++) {
+		zassert_ok(k_sem_take(&wait_data2, WAIT_TIME),
+			   "Timeout while waiting data");
+	}
+
+	zassert_not_ok(k_sem_take(&wait_data, K_NO_WAIT),
+		       "Cancelled query got a callback");
+
+	/* Let the resolver release the queries after the callbacks */
+	k_msleep(THREAD_SLEEP);
+	verify_cancelled();
+
+	capture_query = false;
+	timeout_query = false;
+}
+
 ZTEST(dns_resolve, test_dns_query_ipv4)
 {
 	struct expected_status status = {
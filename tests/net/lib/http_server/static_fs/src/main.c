@@ -0,0 +1,458 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "server_internal.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#define MY_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT  8080
+#define TIMEOUT      2000
+
+#define MOUNT_POINT "/ram"
+#define FILE_PATH MOUNT_POINT "/file.bin"
+/* Larger than the default HTTP/2 window of the peer */
+#define FILE_SIZE (80 * 1024)
+
+#define PEER_WINDOW_SIZE 65535
+#define HTTP2_REFUSED_STREAM 0x7
+
+/* Minimal read-only file system holding a single file in RAM */
+static uint8_t file_data[FILE_SIZE];
+
+static int ramfs_open(struct fs_file_t *filp, const char *fs_path, fs_mode_t flags)
+{
+	if (strcmp(fs_path, FILE_PATH) != 0) {
+		return -ENOENT;
+	}
+
+	filp->filep = (void *)(uintptr_t)0;
+
+	return 0;
+}
+
+static ssize_t ramfs_read(struct fs_file_t *filp, void *dest, size_t nbytes)
+{
+	size_t pos = (uintptr_t)filp->filep;
+	size_t len = MIN(nbytes, FILE_SIZE - pos);
+
+	memcpy(dest, &file_data[pos], len);
+	filp->filep = (void *)(uintptr_t)(pos + len);
+
+	return len;
+}
+
+static int ramfs_lseek(struct fs_file_t *filp, off_t off, int whence)
+{
+	off_t pos = (uintptr_t)filp->filep;
+
+	switch (whence) {
+	case FS_SEEK_SET:
+		pos = off;
+		break;
+	case FS_SEEK_CUR:
+		pos += off;
+		break;
+	case FS_SEEK_END:
+		pos = FILE_SIZE + off;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (pos < 0 || pos > FILE_SIZE) {
+		return -EINVAL;
+	}
+
+	filp->filep = (void *)(uintptr_t)pos;
+
+	return 0;
+}
+
+static off_t ramfs_tell(struct fs_file_t *filp)
+{
+	return (uintptr_t)filp->filep;
+}
+
+static int ramfs_close(struct fs_file_t *filp)
+{
+	return 0;
+}
+
+static int ramfs_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int ramfs_stat(struct fs_mount_t *mountp, const char *path,
+		      struct fs_dirent *entry)
+{
+	if (strcmp(path, FILE_PATH) != 0) {
+		return -ENOENT;
+	}
+
+	entry->type = FS_DIR_ENTRY_FILE;
+	entry->size = FILE_SIZE;
+	strcpy(entry->name, "file.bin");
+
+	return 0;
+}
+
+static const struct fs_file_system_t ramfs = {
+	.open = ramfs_open,
+	.read = ramfs_read,
+	.lseek = ramfs_lseek,
+	.tell = ramfs_tell,
+	.close = ramfs_close,
+	.mount = ramfs_mount,
+	.stat = ramfs_stat,
+};
+
+static struct fs_mount_t ramfs_mnt = {
+	.type = FS_TYPE_EXTERNAL_BASE,
+	.mnt_point = MOUNT_POINT,
+};
+
+static uint16_t test_http_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(test_http_service, MY_IPV4_ADDR,
+		    &test_http_service_port, 1, 10, NULL);
+
+static const char index_html[] = "Hello, World!";
+struct http_resource_detail_static index_html_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.static_data = index_html,
+	.static_data_len = sizeof(index_html),
+};
+
+HTTP_RESOURCE_DEFINE(index_html_resource, test_http_service, "/",
+		     &index_html_resource_detail);
+
+struct http_resource_detail_static_fs file_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.fs_path = FILE_PATH,
+};
+
+HTTP_RESOURCE_DEFINE(file_resource, test_http_service, "/file.bin",
+		     &file_resource_detail);
+
+/* Connection preface followed by an empty SETTINGS frame */
+static const uint8_t preface[] = {
+	0x50, 0x52, 0x49, 0x20, 0x2a, 0x20, 0x48, 0x54, 0x54, 0x50, 0x2f, 0x32,
+	0x2e, 0x30, 0x0d, 0x0a, 0x0d, 0x0a, 0x53, 0x4d, 0x0d, 0x0a, 0x0d, 0x0a,
+	0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+/* HPACK: GET, http, :path literal without indexing */
+static const uint8_t get_index_hpack[] = { 0x82, 0x86, 0x84 };
+static const uint8_t get_file_hpack[] = {
+	0x82, 0x86, 0x04, 0x09, '/', 'f', 'i', 'l', 'e', '.', 'b', 'i', 'n',
+};
+
+static uint8_t rx_data[FILE_SIZE + 512];
+static uint8_t frame_payload[16384];
+
+struct test_frame {
+	uint32_t length;
+	uint8_t type;
+	uint8_t flags;
+	uint32_t stream_id;
+};
+
+static int connect_to_server(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int fd;
+
+	zassert_equal(zsock_inet_pton(AF_INET, MY_IPV4_ADDR, &sa.sin_addr), 1);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "failed to create client socket (%d)", errno);
+	zassert_ok(zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa)),
+		   "failed to connect (%d)", errno);
+
+	return fd;
+}
+
+static void send_all(int fd, const void *buf, size_t len)
+{
+	while (len > 0) {
+		ssize_t ret = zsock_send(fd, buf, len, 0);
+
+		zassert_true(ret > 0, "send() failed (%d)", errno);
+
+		buf = (const uint8_t *)buf + ret;
+		len -= ret;
+	}
+}
+
+static bool wait_readable(int fd, int timeout)
+{
+	struct zsock_pollfd pfd = { .fd = fd, .events = ZSOCK_POLLIN };
+
+	return zsock_poll(&pfd, 1, timeout) > 0;
+}
+
+static size_t recv_some(int fd, uint8_t *buf, size_t len)
+{
+	ssize_t ret;
+
+	zassert_true(wait_readable(fd, TIMEOUT), "Timeout while receiving");
+
+	ret = zsock_recv(fd, buf, len, 0);
+	zassert_true(ret > 0, "recv() failed (%d, %d)", ret, errno);
+
+	return ret;
+}
+
+static void recv_all(int fd, uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		size_t ret = recv_some(fd, buf, len);
+
+		buf += ret;
+		len -= ret;
+	}
+}
+
+static void send_frame(int fd, uint8_t type, uint8_t flags, uint32_t stream_id,
+		       const uint8_t *payload, size_t len)
+{
+	uint8_t header[HTTP_SERVER_FRAME_HEADER_SIZE];
+
+	sys_put_be24(len, header);
+	header[3] = type;
+	header[4] = flags;
+	sys_put_be32(stream_id, &header[5]);
+
+	send_all(fd, header, sizeof(header));
+	send_all(fd, payload, len);
+}
+
+static void send_get(int fd, uint32_t stream_id, const uint8_t *hpack, size_t len)
+{
+	send_frame(fd, HTTP_SERVER_HEADERS_FRAME,
+		   HTTP_SERVER_FLAG_END_HEADERS | HTTP_SERVER_FLAG_END_STREAM,
+		   stream_id, hpack, len);
+}
+
+static void send_window_update(int fd, uint32_t stream_id, uint32_t increment)
+{
+	uint8_t payload[sizeof(uint32_t)];
+
+	sys_put_be32(increment, payload);
+	send_frame(fd, HTTP_SERVER_WINDOW_UPDATE_FRAME, 0, stream_id, payload,
+		   sizeof(payload));
+}
+
+/* Receive a frame, its payload ends up in frame_payload */
+static void recv_frame(int fd, struct test_frame *frame)
+{
+	uint8_t header[HTTP_SERVER_FRAME_HEADER_SIZE];
+
+	recv_all(fd, header, sizeof(header));
+
+	frame->length = sys_get_be24(header);
+	frame->type = header[3];
+	frame->flags = header[4];
+	frame->stream_id = sys_get_be32(&header[5]) & 0x7fffffff;
+
+	zassert_true(frame->length <= sizeof(frame_payload), "Frame too long (%u)",
+		     frame->length);
+
+	recv_all(fd, frame_payload, frame->length);
+}
+
+/* Receive frames until stream_id got data_len bytes of DATA or ended. Returns
+ * the number of bytes received, which are appended to rx_data at offset.
+ */
+static size_t recv_data(int fd, uint32_t stream_id, size_t offset, size_t data_len,
+			bool *end_stream)
+{
+	struct test_frame frame;
+	size_t received = 0;
+
+	*end_stream = false;
+
+	while (received < data_len && !*end_stream) {
+		recv_frame(fd, &frame);
+
+		if (frame.stream_id != stream_id) {
+			continue;
+		}
+
+		zassert_not_equal(frame.type, HTTP_SERVER_RST_STREAM_FRAME,
+				  "Stream %u reset", stream_id);
+
+		if (frame.type == HTTP_SERVER_DATA_FRAME) {
+			zassert_true(offset + received + frame.length <= FILE_SIZE,
+				     "Too much data");
+			memcpy(&rx_data[offset + received], frame_payload, frame.length);
+			received += frame.length;
+		}
+
+		*end_stream = frame.flags & HTTP_SERVER_FLAG_END_STREAM;
+	}
+
+	return received;
+}
+
+ZTEST(server_static_fs_tests, test_http1_static_fs)
+{
+	static const char request[] = "GET /file.bin HTTP/1.1\r\n"
+				      "Host: " MY_IPV4_ADDR "\r\n\r\n";
+	size_t offset = 0;
+	size_t body_len;
+	char *body;
+	char *hdr;
+	int fd;
+
+	fd = connect_to_server();
+
+	send_all(fd, request, sizeof(request) - 1);
+
+	do {
+		offset += recv_some(fd, &rx_data[offset], sizeof(rx_data) - 1 - offset);
+		rx_data[offset] = '\0';
+		body = strstr((char *)rx_data, "\r\n\r\n");
+	} while (body == NULL);
+
+	zassert_mem_equal(rx_data, "HTTP/1.1 200 OK", sizeof("HTTP/1.1 200 OK") - 1);
+
+	hdr = strstr((char *)rx_data, "Content-Length: ");
+	zassert_not_null(hdr, "No Content-Length header");
+	zassert_true(hdr < body, "No Content-Length header");
+	zassert_equal(strtoul(hdr + sizeof("Content-Length: ") - 1, NULL, 10), FILE_SIZE);
+
+	body += 4;
+	body_len = offset - ((uint8_t *)body - rx_data);
+	zassert_true(body_len <= FILE_SIZE, "Too much data");
+
+	/* The body is larger than the TCP window, so it arrives in pieces */
+	memmove(rx_data, body, body_len);
+	recv_all(fd, &rx_data[body_len], FILE_SIZE - body_len);
+
+	zassert_mem_equal(rx_data, file_data, FILE_SIZE, "Invalid data");
+
+	zassert_ok(zsock_close(fd));
+}
+
+ZTEST(server_static_fs_tests, test_http2_static_fs)
+{
+	size_t index_len = sizeof(index_html);
+	size_t window = PEER_WINDOW_SIZE - index_len;
+	bool end_stream;
+	size_t len;
+	int fd;
+
+	fd = connect_to_server();
+
+	send_all(fd, preface, sizeof(preface));
+	send_get(fd, 1, get_index_hpack, sizeof(get_index_hpack));
+
+	len = recv_data(fd, 1, 0, index_len + 1, &end_stream);
+	zassert_true(end_stream);
+	zassert_equal(len, index_len);
+	zassert_mem_equal(rx_data, index_html, index_len);
+
+	/* The file only gets what is left of the connection window */
+	send_get(fd, 3, get_file_hpack, sizeof(get_file_hpack));
+
+	len = recv_data(fd, 3, 0, window, &end_stream);
+	zassert_false(end_stream, "File sent past the window");
+	zassert_equal(len, window, "Window not filled");
+	zassert_false(wait_readable(fd, 200), "Data sent past the window");
+
+	/* Opening the windows resumes the transfer */
+	send_window_update(fd, 0, FILE_SIZE);
+	send_window_update(fd, 3, FILE_SIZE);
+
+	len += recv_data(fd, 3, len, FILE_SIZE - len, &end_stream);
+	zassert_true(end_stream, "Stream not ended");
+	zassert_equal(len, FILE_SIZE, "Invalid length");
+	zassert_mem_equal(rx_data, file_data, FILE_SIZE, "Invalid data");
+
+	zassert_ok(zsock_close(fd));
+}
+
+ZTEST(server_static_fs_tests, test_http2_static_fs_refused_stream)
+{
+	struct test_frame frame;
+	bool end_stream;
+	size_t len;
+	int fd;
+
+	fd = connect_to_server();
+
+	send_all(fd, preface, sizeof(preface));
+	send_get(fd, 1, get_file_hpack, sizeof(get_file_hpack));
+
+	len = recv_data(fd, 1, 0, PEER_WINDOW_SIZE, &end_stream);
+	zassert_false(end_stream, "File sent past the window");
+	zassert_equal(len, PEER_WINDOW_SIZE, "Window not filled");
+
+	/* A second transfer is refused while the first one is pending */
+	send_get(fd, 3, get_file_hpack, sizeof(get_file_hpack));
+
+	recv_frame(fd, &frame);
+	zassert_equal(frame.type, HTTP_SERVER_RST_STREAM_FRAME, "Expected RST_STREAM");
+	zassert_equal(frame.stream_id, 3, "Invalid stream ID");
+	zassert_equal(frame.length, sizeof(uint32_t));
+	zassert_equal(sys_get_be32(frame_payload), HTTP2_REFUSED_STREAM,
+		      "Invalid error code");
+
+	send_window_update(fd, 0, FILE_SIZE);
+	send_window_update(fd, 1, FILE_SIZE);
+
+	len += recv_data(fd, 1, len, FILE_SIZE - len, &end_stream);
+	zassert_true(end_stream, "Stream not ended");
+	zassert_equal(len, FILE_SIZE, "Invalid length");
+	zassert_mem_equal(rx_data, file_data, FILE_SIZE, "Invalid data");
+
+	zassert_ok(zsock_close(fd));
+}
+
+static void *setup(void)
+{
+	int ret;
+
+	for (int i = 0; i < FILE_SIZE; i++) {
+		file_data[i] = (uint8_t)(i * 31 + (i >> 8));
+	}
+
+	ret = fs_register(FS_TYPE_EXTERNAL_BASE, &ramfs);
+	zassert_ok(ret, "Cannot register file system (%d)", ret);
+
+	ret = fs_mount(&ramfs_mnt);
+	zassert_ok(ret, "Cannot mount file system (%d)", ret);
+
+	zassert_ok(http_server_start(), "Failed to start the server");
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	zassert_ok(http_server_stop(), "Failed to stop the server");
+}
+
+ZTEST_SUITE(server_static_fs_tests, NULL, setup, NULL, NULL, teardown);
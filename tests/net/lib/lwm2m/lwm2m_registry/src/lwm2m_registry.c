@@ -562,6 +562,103 @@ ZTEST(lwm2m_registry, test_next_engine_obj_inst)
 	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
 }
 
+ZTEST(lwm2m_registry, test_obj_inst_lookup_order)
+{
+	static const uint16_t create_order[] = { 3, 0, 2, 1 };
+	struct lwm2m_engine_obj_inst *oi;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(create_order); i++) {
+		zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, create_order[i])), 0);
+	}
+
+	/* Instances are visited in instance ID order */
+	oi = next_engine_obj_inst(3303, -1);
+	for (i = 0; i < ARRAY_SIZE(create_order); i++) {
+		zassert_not_null(oi);
+		zassert_equal(oi->obj_inst_id, i);
+		zassert_equal(oi, get_engine_obj_inst(3303, i));
+		oi = next_engine_obj_inst(3303, oi->obj_inst_id);
+	}
+	zassert_is_null(oi);
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_is_null(get_engine_obj_inst(3303, 1));
+	oi = next_engine_obj_inst(3303, 0);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 2);
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 2)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 3)), 0);
+	zassert_is_null(next_engine_obj_inst(3303, -1));
+}
+
+ZTEST(lwm2m_registry, test_obj_inst_lookup_overflow)
+{
+	struct lwm2m_engine_obj_inst *oi;
+	size_t count = sys_slist_len(lwm2m_engine_obj_inst_list());
+
+	/* With a small index, the instances created here do not all fit. Instance 2
+	 * is created and instance 0 is deleted while they do not, and the index is
+	 * rebuilt once instance 3 is deleted.
+	 */
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 3)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 2)), 0);
+	zassert_equal(sys_slist_len(lwm2m_engine_obj_inst_list()), count + 4);
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 3)), 0);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(lwm2m_engine_obj_inst_list(), oi, node) {
+		zassert_equal(oi, get_engine_obj_inst(oi->obj->obj_id, oi->obj_inst_id));
+	}
+
+	zassert_is_null(get_engine_obj_inst(3303, 0));
+	zassert_is_null(get_engine_obj_inst(3303, 3));
+	oi = next_engine_obj_inst(3303, -1);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 1);
+	oi = next_engine_obj_inst(3303, 1);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 2);
+	zassert_is_null(next_engine_obj_inst(3303, 2));
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 2)), 0);
+	zassert_equal(sys_slist_len(lwm2m_engine_obj_inst_list()), count);
+	zassert_is_null(next_engine_obj_inst(3303, -1));
+}
+
+ZTEST(lwm2m_registry, test_observe_recreated_obj_inst)
+{
+	struct lwm2m_ctx ctx = {0};
+
+	/* Instance 0 uses the first slot of the object */
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_equal(lwm2m_update_observer_min_period(&ctx, &LWM2M_OBJ(3303, 0, 5700), 10), 0);
+	zassert_equal(lwm2m_update_observer_max_period(&ctx, &LWM2M_OBJ(3303, 0, 5700), 5),
+		      -EEXIST);
+
+	/* Re-created in reverse order, instance 1 takes the first slot */
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_update_observer_min_period(&ctx, &LWM2M_OBJ(3303, 1, 5700), 10), 0);
+
+	/* Attributes are looked up on the new instance 0, which has none */
+	zassert_equal(lwm2m_update_observer_max_period(&ctx, &LWM2M_OBJ(3303, 0, 5700), 5), 0);
+	zassert_equal(lwm2m_update_observer_max_period(&ctx, &LWM2M_OBJ(3303, 1, 5700), 5),
+		      -EEXIST);
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+}
+
 ZTEST(lwm2m_registry, test_null_strings)
 {
 	int ret;
@@ -0,0 +1,378 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define CLIENTID	MQTT_UTF8_LITERAL("zephyr")
+#define TOPIC		MQTT_UTF8_LITERAL("sensors")
+#define WINDOW		CONFIG_MQTT_PUBLISH_WINDOW
+#define DUP_FLAG	0x08
+
+#define BUFFER_SIZE 128
+#define MAX_SENT 32
+
+static uint8_t rx_buffer[BUFFER_SIZE];
+static uint8_t tx_buffer[BUFFER_SIZE];
+static uint8_t payload[] = "payload";
+static struct mqtt_client client;
+
+/* Packet seen by the simulated broker. */
+struct sent_packet {
+	uint8_t type_and_flags;
+	uint16_t message_id;
+};
+
+/* Simulated broker: records packets written by the client and queues
+ * replies, read back by the client through mqtt_input().
+ */
+static struct {
+	struct sent_packet sent[MAX_SENT];
+	int sent_count;
+	uint8_t reply[256];
+	size_t reply_len;
+	size_t reply_pos;
+	bool auto_ack;
+} broker;
+
+static struct {
+	int connack;
+	int puback;
+	int pubrec;
+	int pubcomp;
+	uint16_t last_id;
+} events;
+
+static void broker_reply(uint8_t type, uint16_t message_id)
+{
+	uint8_t *pkt = &broker.reply[broker.reply_len];
+
+	zassert_true(broker.reply_len + 4 <= sizeof(broker.reply));
+
+	pkt[0] = type;
+	pkt[1] = 2U;
+	pkt[2] = message_id >> 8;
+	pkt[3] = message_id & 0xff;
+	broker.reply_len += 4;
+}
+
+static void broker_receive(const uint8_t *data, size_t len)
+{
+	uint8_t type = data[0];
+	uint16_t message_id = 0U;
+	uint8_t qos = (type >> 1) & 0x03;
+
+	if ((type & 0xF0) == 0x30 && qos > 0) {
+		/* Fixed header fits in two bytes in these tests. */
+		uint16_t topic_len = (data[2] << 8) | data[3];
+
+		message_id = (data[4 + topic_len] << 8) |
+			     data[5 + topic_len];
+	} else if ((type & 0xF0) == 0x60) {
+		message_id = (data[2] << 8) | data[3];
+	}
+
+	if (broker.sent_count < MAX_SENT) {
+		broker.sent[broker.sent_count].type_and_flags = type;
+		broker.sent[broker.sent_count].message_id = message_id;
+		broker.sent_count++;
+	}
+
+	if (!broker.auto_ack) {
+		return;
+	}
+
+	if ((type & 0xF0) == 0x30 && qos == 1) {
+		broker_reply(0x40, message_id);
+	} else if ((type & 0xF0) == 0x30 && qos == 2) {
+		broker_reply(0x50, message_id);
+	} else if ((type & 0xF0) == 0x60) {
+		broker_reply(0x70, message_id);
+	}
+}
+
+int mqtt_client_custom_transport_connect(struct mqtt_client *c)
+{
+	static const uint8_t connack[] = { 0x20, 0x02, 0x00, 0x00 };
+
+	memcpy(&broker.reply[broker.reply_len], connack, sizeof(connack));
+	broker.reply_len += sizeof(connack);
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_write(struct mqtt_client *c,
+				       const uint8_t *data, uint32_t datalen)
+{
+	broker_receive(data, datalen);
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_write_msg(struct mqtt_client *c,
+					   const struct msghdr *message)
+{
+	/* Header and payload are passed as separate vectors. */
+	zassert_equal(message->msg_iovlen, 2);
+	zassert_equal_ptr(message->msg_iov[1].iov_base, payload);
+
+	broker_receive(message->msg_iov[0].iov_base,
+		       message->msg_iov[0].iov_len);
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_read(struct mqtt_client *c, uint8_t *data,
+				      uint32_t buflen, bool shall_block)
+{
+	size_t len = MIN(buflen, broker.reply_len - broker.reply_pos);
+
+	if (len == 0) {
+		return -EAGAIN;
+	}
+
+	memcpy(data, &broker.reply[broker.reply_pos], len);
+	broker.reply_pos += len;
+
+	if (broker.reply_pos == broker.reply_len) {
+		broker.reply_pos = 0;
+		broker.reply_len = 0;
+	}
+
+	return len;
+}
+
+int mqtt_client_custom_transport_disconnect(struct mqtt_client *c)
+{
+	broker.reply_pos = 0;
+	broker.reply_len = 0;
+
+	return 0;
+}
+
+static void evt_handler(struct mqtt_client *const c,
+			const struct mqtt_evt *evt)
+{
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		events.connack++;
+		break;
+	case MQTT_EVT_PUBACK:
+		events.puback++;
+		events.last_id = evt->param.puback.message_id;
+		break;
+	case MQTT_EVT_PUBREC:
+		events.pubrec++;
+		events.last_id = evt->param.pubrec.message_id;
+		break;
+	case MQTT_EVT_PUBCOMP:
+		events.pubcomp++;
+		events.last_id = evt->param.pubcomp.message_id;
+		break;
+	default:
+		break;
+	}
+}
+
+static void broker_flush(void)
+{
+	while (broker.reply_len > 0) {
+		zassert_ok(mqtt_input(&client));
+	}
+}
+
+static void client_connect(void)
+{
+	zassert_ok(mqtt_connect(&client));
+	broker_flush();
+	zassert_equal(events.connack, 1, "Not connected");
+	events.connack = 0;
+	broker.sent_count = 0;
+}
+
+static int publish(enum mqtt_qos qos, uint16_t message_id)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = qos,
+		.message.topic.topic = TOPIC,
+		.message.payload.data = payload,
+		.message.payload.len = sizeof(payload),
+		.message_id = message_id,
+	};
+
+	return mqtt_publish_async(&client, &param);
+}
+
+static void *mqtt_publish_async_setup(void)
+{
+	mqtt_client_init(&client);
+
+	client.client_id = CLIENTID;
+	client.evt_cb = evt_handler;
+	client.transport.type = MQTT_TRANSPORT_CUSTOM;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+
+	return NULL;
+}
+
+static void mqtt_publish_async_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&broker, 0, sizeof(broker));
+	memset(&events, 0, sizeof(events));
+
+	client.clean_session = 1U;
+	client_connect();
+}
+
+static void mqtt_publish_async_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)mqtt_abort(&client);
+}
+
+ZTEST(mqtt_publish_async, test_qos1_window)
+{
+	int ret;
+
+	for (int i = 0; i < WINDOW; i++) {
+		ret = publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U);
+		zassert_true(ret > 0, "Publish failed (%d)", ret);
+		zassert_equal(broker.sent[i].message_id, ret);
+	}
+
+	zassert_equal(broker.sent_count, WINDOW);
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U), -EAGAIN,
+		      "Window should be full");
+
+	/* Acknowledge one message, which frees a slot. */
+	broker_reply(0x40, broker.sent[1].message_id);
+	broker_flush();
+	zassert_equal(events.puback, 1);
+	zassert_equal(events.last_id, broker.sent[1].message_id);
+
+	ret = publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U);
+	zassert_true(ret > 0, "Publish failed (%d)", ret);
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U), -EAGAIN,
+		      "Window should be full");
+
+	/* Unknown and duplicate acks are passed through to the application. */
+	broker_reply(0x40, broker.sent[1].message_id);
+	broker_flush();
+	zassert_equal(events.puback, 2);
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U), -EAGAIN,
+		      "Window should be full");
+}
+
+ZTEST(mqtt_publish_async, test_qos2_flow)
+{
+	int ret;
+
+	broker.auto_ack = true;
+
+	for (int i = 0; i < 2 * WINDOW; i++) {
+		ret = publish(MQTT_QOS_2_EXACTLY_ONCE, 0U);
+		zassert_true(ret > 0, "Publish failed (%d)", ret);
+		broker_flush();
+	}
+
+	zassert_equal(events.pubrec, 2 * WINDOW);
+	zassert_equal(events.pubcomp, 2 * WINDOW);
+
+	/* PUBLISH followed by PUBREL sent by the client itself. */
+	zassert_equal(broker.sent_count, 4 * WINDOW);
+	zassert_equal(broker.sent[0].type_and_flags & 0xF0, 0x30);
+	zassert_equal(broker.sent[1].type_and_flags, 0x62);
+	zassert_equal(broker.sent[1].message_id, broker.sent[0].message_id);
+}
+
+ZTEST(mqtt_publish_async, test_message_id)
+{
+	zassert_equal(publish(MQTT_QOS_0_AT_MOST_ONCE, 0U), 0);
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 1234U), 1234);
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 1234U), -EALREADY);
+	zassert_equal(broker.sent_count, 2);
+
+	/* QoS 0 message does not use a window slot. */
+	for (int i = 1; i < WINDOW; i++) {
+		zassert_true(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U) > 0);
+	}
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U), -EAGAIN);
+}
+
+ZTEST(mqtt_publish_async, test_retransmit)
+{
+	int ret;
+
+	ret = publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U);
+	zassert_true(ret > 0, "Publish failed (%d)", ret);
+	zassert_equal(broker.sent[0].type_and_flags & DUP_FLAG, 0);
+
+	/* Nothing to retransmit yet. */
+	zassert_equal(mqtt_live(&client), -EAGAIN);
+	zassert_equal(broker.sent_count, 1);
+
+	k_msleep(CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT + 10);
+
+	zassert_ok(mqtt_live(&client));
+	zassert_equal(broker.sent_count, 2);
+	zassert_equal(broker.sent[1].message_id, ret);
+	zassert_not_equal(broker.sent[1].type_and_flags & DUP_FLAG,
+			  0, "DUP flag not set");
+
+	broker_reply(0x40, ret);
+	broker_flush();
+	zassert_equal(events.puback, 1);
+
+	k_msleep(CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT + 10);
+
+	zassert_equal(mqtt_live(&client), -EAGAIN);
+	zassert_equal(broker.sent_count, 2);
+}
+
+ZTEST(mqtt_publish_async, test_reconnect)
+{
+	int ret;
+
+	/* Persistent session keeps in-flight messages across connections. */
+	zassert_ok(mqtt_abort(&client));
+	client.clean_session = 0U;
+	client_connect();
+
+	ret = publish(MQTT_QOS_1_AT_LEAST_ONCE, 0U);
+	zassert_true(ret > 0, "Publish failed (%d)", ret);
+
+	zassert_ok(mqtt_abort(&client));
+	broker.sent_count = 0;
+	zassert_ok(mqtt_connect(&client));
+	broker_flush();
+	zassert_equal(events.puback, 0);
+
+	/* CONNECT, then the pending PUBLISH as a duplicate. */
+	zassert_equal(broker.sent_count, 2);
+	zassert_equal(broker.sent[1].message_id, ret);
+	zassert_not_equal(broker.sent[1].type_and_flags & DUP_FLAG,
+			  0, "DUP flag not set");
+
+	/* Clean session drops them. */
+	client.clean_session = 1U;
+	zassert_ok(mqtt_abort(&client));
+	broker.sent_count = 0;
+	zassert_ok(mqtt_connect(&client));
+	broker_flush();
+	zassert_equal(broker.sent_count, 1);
+}
+
+ZTEST_SUITE(mqtt_publish_async, NULL, mqtt_publish_async_setup,
+	    mqtt_publish_async_before, mqtt_publish_async_after, NULL);
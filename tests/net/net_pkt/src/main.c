@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_PKT_LOG_LEVEL);
+
 #include <zephyr/kernel.h>
 #include <zephyr/ztest_assert.h>
 #include <zephyr/types.h>
@@ -18,6 +21,10 @@
 
 #include <zephyr/ztest.h>
 
+#include "ipv4.h"
+#include "udp_internal.h"
+#include "net_private.h"
+
 static uint8_t mac_addr[sizeof(struct net_eth_addr)];
 static struct net_if *eth_if;
 static uint8_t small_buffer[512];
@@ -1273,4 +1280,128 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+/* Odd chunk sizes, so that chunks start at odd offsets and span buffers */
+static const size_t chksum_chunks[] = { 7, 130, 164, 1, 211 };
+static const struct in_addr chksum_src = { { { 192, 0, 2, 1 } } };
+static const struct in_addr chksum_dst = { { { 192, 0, 2, 2 } } };
+
+static struct net_pkt *chksum_pkt_alloc(size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, NET_UDPH_LEN + len, AF_INET,
+					IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	zassert_ok(net_ipv4_create(pkt, &chksum_src, &chksum_dst));
+	zassert_ok(net_udp_create(pkt, htons(4242), htons(4243)));
+
+	return pkt;
+}
+
+/* The sum given with net_pkt_set_data_chksum() must give the same
+ * checksum as reading the whole packet, and it must be used.
+ */
+static void chksum_verify(struct net_pkt *pkt, uint16_t sum, size_t len)
+{
+	uint16_t full, partial;
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_UDP));
+
+	net_pkt_set_data_chksum(pkt, 0U, 0U);
+	full = net_calc_chksum(pkt, IPPROTO_UDP);
+
+	net_pkt_set_data_chksum(pkt, sum, len);
+	partial = net_calc_chksum(pkt, IPPROTO_UDP);
+	zassert_equal(partial, full, "Checksum mismatch (0x%04x vs 0x%04x)",
+		      partial, full);
+
+	net_pkt_set_data_chksum(pkt, sum + 1U, len);
+	zassert_not_equal(net_calc_chksum(pkt, IPPROTO_UDP), full,
+			  "Payload sum not used");
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_write_chksum)
+{
+	uint8_t data[7 + 130 + 164 + 1 + 211];
+	uint16_t sum = 0U, part;
+	struct net_pkt *pkt;
+	size_t offset = 0;
+
+	sys_rand_get(data, sizeof(data));
+
+	pkt = chksum_pkt_alloc(sizeof(data));
+
+	ARRAY_FOR_EACH(chksum_chunks, i) {
+		part = 0U;
+		zassert_ok(net_pkt_write_chksum(pkt, data + offset,
+						chksum_chunks[i], &part));
+		sum = calc_chksum_add(sum, part, offset);
+		offset += chksum_chunks[i];
+	}
+
+	zassert_true(pkt->buffer->frags != NULL, "Data in a single buffer");
+
+	chksum_verify(pkt, sum, sizeof(data));
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_copy_chksum)
+{
+	uint8_t data[7 + 130 + 164 + 1 + 211];
+	struct net_pkt *src, *pkt;
+	uint16_t sum = 0U;
+
+	sys_rand_get(data, sizeof(data));
+
+	/* Copy from an odd offset of the source */
+	src = net_pkt_alloc_with_buffer(eth_if, sizeof(data), AF_UNSPEC, 0,
+					K_NO_WAIT);
+	zassert_not_null(src, "Pkt not allocated");
+	zassert_ok(net_pkt_write(src, data, sizeof(data)));
+
+	net_pkt_cursor_init(src);
+	net_pkt_set_overwrite(src, true);
+	zassert_ok(net_pkt_skip(src, chksum_chunks[0]));
+
+	pkt = chksum_pkt_alloc(sizeof(data) - chksum_chunks[0]);
+	zassert_ok(net_pkt_copy_chksum(pkt, src, sizeof(data) - chksum_chunks[0],
+				       &sum));
+
+	chksum_verify(pkt, sum, sizeof(data) - chksum_chunks[0]);
+
+	net_pkt_unref(pkt);
+	net_pkt_unref(src);
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_data_chksum_clear)
+{
+	uint8_t data[64] = { 0 };
+	struct net_buf *buf;
+	struct net_pkt *pkt;
+
+	pkt = chksum_pkt_alloc(sizeof(data));
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)));
+
+	/* The sum covers the end of the packet, changing it drops the sum */
+	net_pkt_set_data_chksum(pkt, 0x1234U, sizeof(data));
+	zassert_ok(net_pkt_remove_tail(pkt, 1));
+	zassert_equal(net_pkt_data_chksum_len(pkt), 0, "Sum not cleared");
+
+	net_pkt_set_data_chksum(pkt, 0x1234U, sizeof(data) - 1);
+	zassert_ok(net_pkt_update_length(pkt, net_pkt_get_len(pkt) - 1));
+	zassert_equal(net_pkt_data_chksum_len(pkt), 0, "Sum not cleared");
+
+	buf = net_pkt_get_frag(pkt, sizeof(data), K_NO_WAIT);
+	zassert_not_null(buf, "Buffer not allocated");
+
+	net_pkt_set_data_chksum(pkt, 0x1234U, sizeof(data) - 2);
+	net_pkt_append_buffer(pkt, buf);
+	zassert_equal(net_pkt_data_chksum_len(pkt), 0, "Sum not cleared");
+
+	net_pkt_unref(pkt);
+}
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -280,6 +280,7 @@ static void test_npf_eth_mac_address(void)
 
 	/* insert known src address in the lot */
 	mac_address_list[1] = ETH_SRC_ADDR;
+	npf_update_recv_rules();
 	zassert_true(net_pkt_filter_recv_ok(pkt), "");
 	npf_insert_recv_rule(&accept_unmatched_src_addr);
 	zassert_true(net_pkt_filter_recv_ok(pkt), "");
@@ -296,6 +297,7 @@ static void test_npf_eth_mac_address(void)
 
 	/* insert known dst address in the lot */
 	mac_address_list[2] = ETH_DST_ADDR;
+	npf_update_recv_rules();
 	zassert_true(net_pkt_filter_recv_ok(pkt), "");
 	npf_insert_recv_rule(&accept_unmatched_dst_addr);
 	zassert_true(net_pkt_filter_recv_ok(pkt), "");
@@ -321,6 +323,7 @@ static void test_npf_eth_mac_addr_mask(void)
 
 	/* clobber one nibble of matching address from previous test */
 	mac_address_list[1].addr[5] = 0x00;
+	npf_update_recv_rules();
 	zassert_false(net_pkt_filter_recv_ok(pkt), "");
 
 	/* insert masked address match rule */
@@ -545,6 +545,69 @@ static void test_route_preference(void)
 }
 
 
+static void test_route_longest_prefix(void)
+{
+	static const uint8_t prefix_lens[] = { 32, 64, 96, 128 };
+	struct net_route_entry *routes[ARRAY_SIZE(prefix_lens)];
+	struct in6_addr addr;
+	struct net_route_entry *entry;
+
+	/* Overlapping prefixes of dest_addr, added shortest first */
+	for (int i = 0; i < ARRAY_SIZE(prefix_lens); i++) {
+		routes[i] = net_route_add(my_iface, &dest_addr, prefix_lens[i],
+					  &peer_addr,
+					  NET_IPV6_ND_INFINITE_LIFETIME,
+					  NET_ROUTE_PREFERENCE_LOW);
+		zassert_not_null(routes[i], "Route /%d add failed",
+				 prefix_lens[i]);
+		zassert_equal(routes[i]->prefix_len, prefix_lens[i],
+			      "Wrong prefix length");
+	}
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, routes[3], "/128 route not selected");
+
+	/* 2001:db8::d:e:5:8 only matches up to the /96 route */
+	net_ipaddr_copy(&addr, &dest_addr);
+	addr.s6_addr[15] = 0x8;
+	entry = net_route_lookup(my_iface, &addr);
+	zassert_equal_ptr(entry, routes[2], "/96 route not selected");
+
+	/* 2001:db8::100:0:0:1 matches the /64 route */
+	net_ipaddr_copy(&addr, &my_addr);
+	addr.s6_addr[8] = 0x1;
+	entry = net_route_lookup(my_iface, &addr);
+	zassert_equal_ptr(entry, routes[1], "/64 route not selected");
+
+	/* 2001:db8:1::1 matches the /32 route */
+	net_ipaddr_copy(&addr, &my_addr);
+	addr.s6_addr[5] = 0x1;
+	entry = net_route_lookup(my_iface, &addr);
+	zassert_equal_ptr(entry, routes[0], "/32 route not selected");
+
+	/* 2001:db9::1 matches none of them */
+	addr.s6_addr[3] = 0xb9;
+	entry = net_route_lookup(my_iface, &addr);
+	zassert_is_null(entry, "Unexpected route found");
+
+	/* Removing the most specific routes falls back to shorter ones */
+	zassert_ok(net_route_del(routes[3]), "Route /128 del failed");
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, routes[2], "Did not fall back to /96");
+
+	zassert_ok(net_route_del(routes[2]), "Route /96 del failed");
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, routes[1], "Did not fall back to /64");
+
+	zassert_ok(net_route_del(routes[0]), "Route /32 del failed");
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, routes[1], "/64 route lost");
+
+	zassert_ok(net_route_del(routes[1]), "Route /64 del failed");
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(entry, "Deleted route found");
+}
+
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
 {
@@ -566,6 +629,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
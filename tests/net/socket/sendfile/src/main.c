@@ -0,0 +1,311 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define MY_IPV4_ADDR "127.0.0.1"
+#define ANY_PORT 0
+#define SERVER_PORT 4242
+
+#define MOUNT_POINT "/ram"
+#define FILE_PATH MOUNT_POINT "/file.bin"
+#define FILE_SIZE (24 * 1024)
+
+#define RECEIVER_STACK_SIZE 2048
+#define RECV_TIMEOUT_MS 2000
+
+/* Minimal read-only file system holding a single file in RAM */
+static uint8_t file_data[FILE_SIZE];
+
+static int ramfs_open(struct fs_file_t *filp, const char *fs_path, fs_mode_t flags)
+{
+	if (strcmp(fs_path, FILE_PATH) != 0) {
+		return -ENOENT;
+	}
+
+	filp->filep = (void *)(uintptr_t)0;
+
+	return 0;
+}
+
+static ssize_t ramfs_read(struct fs_file_t *filp, void *dest, size_t nbytes)
+{
+	size_t pos = (uintptr_t)filp->filep;
+	size_t len = MIN(nbytes, FILE_SIZE - pos);
+
+	memcpy(dest, &file_data[pos], len);
+	filp->filep = (void *)(uintptr_t)(pos + len);
+
+	return len;
+}
+
+static int ramfs_lseek(struct fs_file_t *filp, off_t off, int whence)
+{
+	off_t pos = (uintptr_t)filp->filep;
+
+	switch (whence) {
+	case FS_SEEK_SET:
+		pos = off;
+		break;
+	case FS_SEEK_CUR:
+		pos += off;
+		break;
+	case FS_SEEK_END:
+		pos = FILE_SIZE + off;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (pos < 0 || pos > FILE_SIZE) {
+		return -EINVAL;
+	}
+
+	filp->filep = (void *)(uintptr_t)pos;
+
+	return 0;
+}
+
+static off_t ramfs_tell(struct fs_file_t *filp)
+{
+	return (uintptr_t)filp->filep;
+}
+
+static int ramfs_close(struct fs_file_t *filp)
+{
+	return 0;
+}
+
+static int ramfs_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int ramfs_stat(struct fs_mount_t *mountp, const char *path,
+		      struct fs_dirent *entry)
+{
+	if (strcmp(path, FILE_PATH) != 0) {
+		return -ENOENT;
+	}
+
+	entry->type = FS_DIR_ENTRY_FILE;
+	entry->size = FILE_SIZE;
+	strcpy(entry->name, "file.bin");
+
+	return 0;
+}
+
+static const struct fs_file_system_t ramfs = {
+	.open = ramfs_open,
+	.read = ramfs_read,
+	.lseek = ramfs_lseek,
+	.tell = ramfs_tell,
+	.close = ramfs_close,
+	.mount = ramfs_mount,
+	.stat = ramfs_stat,
+};
+
+static struct fs_mount_t ramfs_mnt = {
+	.type = FS_TYPE_EXTERNAL_BASE,
+	.mnt_point = MOUNT_POINT,
+};
+
+/* Receiver side, drains the server socket into rx_data */
+static uint8_t rx_data[FILE_SIZE];
+static size_t rx_len;
+static int rx_sock;
+
+K_THREAD_STACK_DEFINE(receiver_stack, RECEIVER_STACK_SIZE);
+static struct k_thread receiver_thread;
+static K_SEM_DEFINE(rx_done, 0, 1);
+static size_t rx_expected;
+
+static void receiver(void *p1, void *p2, void *p3)
+{
+	while (rx_len < rx_expected) {
+		ssize_t ret = zsock_recv(rx_sock, &rx_data[rx_len],
+					 rx_expected - rx_len, 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		rx_len += ret;
+	}
+
+	k_sem_give(&rx_done);
+}
+
+static void start_receiver(size_t expected)
+{
+	rx_len = 0;
+	rx_expected = expected;
+	memset(rx_data, 0, sizeof(rx_data));
+
+	k_thread_create(&receiver_thread, receiver_stack,
+			K_THREAD_STACK_SIZEOF(receiver_stack), receiver,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+}
+
+static void wait_receiver(void)
+{
+	zassert_ok(k_sem_take(&rx_done, K_MSEC(RECV_TIMEOUT_MS)),
+		   "Receiver timed out");
+	k_thread_join(&receiver_thread, K_FOREVER);
+}
+
+static int c_sock;
+static int s_sock;
+
+static void *setup(void)
+{
+	int ret;
+
+	for (int i = 0; i < FILE_SIZE; i++) {
+		file_data[i] = (uint8_t)(i * 31 + (i >> 8));
+	}
+
+	ret = fs_register(FS_TYPE_EXTERNAL_BASE, &ramfs);
+	zassert_ok(ret, "Cannot register file system (%d)", ret);
+
+	ret = fs_mount(&ramfs_mnt);
+	zassert_ok(ret, "Cannot mount file system (%d)", ret);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	struct sockaddr_in c_saddr, s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	zassert_ok(zsock_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr)));
+	zassert_ok(zsock_listen(s_sock, 1));
+	zassert_ok(zsock_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr)));
+
+	rx_sock = zsock_accept(s_sock, &addr, &addrlen);
+	zassert_true(rx_sock >= 0, "accept failed");
+}
+
+static void after(void *fixture)
+{
+	zsock_close(c_sock);
+	zsock_close(rx_sock);
+	zsock_close(s_sock);
+
+	/* Let the connections close before the next test binds again */
+	k_msleep(300);
+}
+
+ZTEST(net_socket_sendfile, test_sendfile_whole_file)
+{
+	struct fs_file_t file;
+	uint32_t start, sendfile_cyc, copy_cyc;
+	ssize_t ret;
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, FILE_PATH, FS_O_READ));
+
+	start_receiver(FILE_SIZE);
+
+	start = k_cycle_get_32();
+	ret = zsock_sendfile(c_sock, &file, NULL, FILE_SIZE);
+	zassert_equal(ret, FILE_SIZE, "sendfile failed (%d, %d)", ret, errno);
+
+	wait_receiver();
+	sendfile_cyc = k_cycle_get_32() - start;
+
+	zassert_equal(rx_len, FILE_SIZE, "Invalid length");
+	zassert_mem_equal(rx_data, file_data, FILE_SIZE, "Invalid data");
+
+	/* The file position advances when no offset is given */
+	zassert_equal(fs_tell(&file), FILE_SIZE, "Invalid file position");
+
+	/* At the end of the file nothing more is sent */
+	ret = zsock_sendfile(c_sock, &file, NULL, FILE_SIZE);
+	zassert_equal(ret, 0, "Data sent past the end of file");
+
+	/* Same transfer with a plain read/send loop for comparison */
+	zassert_ok(fs_seek(&file, 0, FS_SEEK_SET));
+	start_receiver(FILE_SIZE);
+
+	start = k_cycle_get_32();
+	for (size_t sent = 0; sent < FILE_SIZE; ) {
+		uint8_t buf[CONFIG_NET_SOCKETS_SENDFILE_BUF_SIZE];
+		ssize_t len = fs_read(&file, buf, sizeof(buf));
+
+		zassert_true(len > 0, "read failed");
+
+		for (ssize_t off = 0; off < len; off += ret) {
+			ret = zsock_send(c_sock, buf + off, len - off, 0);
+			zassert_true(ret > 0, "send failed (%d)", errno);
+		}
+
+		sent += len;
+	}
+
+	wait_receiver();
+	copy_cyc = k_cycle_get_32() - start;
+
+	zassert_mem_equal(rx_data, file_data, FILE_SIZE, "Invalid data");
+
+	TC_PRINT("%u bytes: sendfile %llu us, read/send %llu us\n", FILE_SIZE,
+		 k_cyc_to_us_floor64(sendfile_cyc), k_cyc_to_us_floor64(copy_cyc));
+
+	fs_close(&file);
+}
+
+ZTEST(net_socket_sendfile, test_sendfile_offset)
+{
+	struct fs_file_t file;
+	off_t offset = 1000;
+	size_t count = 5000;
+	ssize_t ret;
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, FILE_PATH, FS_O_READ));
+	zassert_ok(fs_seek(&file, 10, FS_SEEK_SET));
+
+	start_receiver(count);
+
+	ret = zsock_sendfile(c_sock, &file, &offset, count);
+	zassert_equal(ret, count, "sendfile failed (%d, %d)", ret, errno);
+
+	wait_receiver();
+
+	zassert_mem_equal(rx_data, &file_data[1000], count, "Invalid data");
+	zassert_equal(offset, 1000 + count, "Offset not updated");
+
+	/* The file position is not changed when an offset is given */
+	zassert_equal(fs_tell(&file), 10, "File position changed");
+
+	/* Count is clamped to the end of the file */
+	offset = FILE_SIZE - 100;
+	start_receiver(100);
+
+	ret = zsock_sendfile(c_sock, &file, &offset, 1000);
+	zassert_equal(ret, 100, "sendfile did not stop at EOF (%d)", ret);
+
+	wait_receiver();
+
+	zassert_mem_equal(rx_data, &file_data[FILE_SIZE - 100], 100, "Invalid data");
+
+	fs_close(&file);
+}
+
+ZTEST_SUITE(net_socket_sendfile, NULL, setup, before, after, NULL);
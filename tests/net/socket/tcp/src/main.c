@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/net/loopback.h>
 
 #include "../../socket_helpers.h"
+#include "tcp_private.h"
 
 #define TEST_STR_SMALL "test"
 
@@ -35,6 +36,16 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define TCP_TEARDOWN_TIMEOUT K_SECONDS(3)
 #define THREAD_SLEEP 50 /* ms */
 
+#define CORK_WRITES 5
+/* The stack holds corked data for at most 200 ms */
+#define CORK_TIMEOUT_MS 250
+
+#if defined(CONFIG_NET_TCP_AUTOCORK)
+#define AUTOCORK_TIMEOUT_MS CONFIG_NET_TCP_AUTOCORK_TIMEOUT
+#else
+#define AUTOCORK_TIMEOUT_MS 0
+#endif
+
 static void test_bind(int sock, struct sockaddr *addr, socklen_t addrlen)
 {
 	zassert_equal(zsock_bind(sock, addr, addrlen),
@@ -845,6 +856,85 @@ void _test_recv_enotconn(int c_sock, int s_sock)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+ZTEST(net_socket_tcp, test_v4_recv_zerocopy)
+{
+	/* Test that zsock_recv_zc() hands over the received buffers */
+	uint8_t rx_buf[sizeof(TEST_STR_LONG)];
+	struct net_buf *frags;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	size_t total = 0;
+	ssize_t recved;
+	struct tcp *conn;
+	uint16_t win;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_SOCKETS_RECV_ZEROCOPY);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_LONG, strlen(TEST_STR_LONG), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	/* Consume a few bytes with a plain recv first, zero-copy must continue
+	 * from where it stopped.
+	 */
+	recved = zsock_recv(new_sock, rx_buf, 4, 0);
+	zassert_equal(recved, 4, "recv failed");
+	total = recved;
+
+	conn = ((struct net_context *)zsock_get_context_object(new_sock))->tcp;
+
+	while (total < strlen(TEST_STR_LONG)) {
+		win = conn->recv_win;
+
+		recved = zsock_recv_zc(new_sock, &frags, 0);
+		zassert_true(recved > 0, "zsock_recv_zc failed (%d)", errno);
+		zassert_not_null(frags, "No buffers returned");
+		zassert_equal(net_buf_frags_len(frags), recved, "Invalid length");
+		zassert_true(total + recved <= strlen(TEST_STR_LONG), "Too much data");
+
+		/* The window must stay closed while the buffers are held */
+		zassert_true(conn->recv_win <= win, "Window opened before release");
+		win = conn->recv_win;
+
+		net_buf_linearize(rx_buf + total, sizeof(rx_buf) - total, frags, 0,
+				  recved);
+		zsock_recv_zc_release(frags);
+
+		zassert_true(conn->recv_win > win, "Window not opened on release");
+
+		total += recved;
+	}
+
+	zassert_mem_equal(rx_buf, TEST_STR_LONG, strlen(TEST_STR_LONG), "Invalid data");
+
+	recved = zsock_recv_zc(new_sock, &frags, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(recved, -1, "Unexpected data");
+	zassert_equal(errno, EAGAIN, "Unexpected errno %d", errno);
+
+	test_close(c_sock);
+
+	recved = zsock_recv_zc(new_sock, &frags, 0);
+	zassert_equal(recved, 0, "EOF not detected");
+	zassert_is_null(frags, "Buffers returned on EOF");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 ZTEST_USER(net_socket_tcp, test_v4_recv_enotconn)
 {
 	/* For a stream socket, recv() without connect() or accept()
@@ -2487,6 +2577,238 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+/* Number of TCP data segments sent so far. Pure ACKs are not counted. */
+static uint32_t tcp_data_segments(void)
+{
+	struct net_stats_tcp stats;
+
+	zassert_ok(net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &stats, sizeof(stats)),
+		   "Cannot get TCP statistics");
+
+	return stats.sent;
+}
+
+static void prepare_tcp_v4_pair(int *c_sock, int *s_sock, int *new_sock)
+{
+	struct sockaddr_in c_saddr, s_saddr;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, s_sock, &s_saddr);
+
+	test_bind(*s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(*s_sock);
+	test_connect(*c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(*s_sock, new_sock, NULL, NULL);
+}
+
+/* Check that the data of all the small writes arrives as one segment */
+static void test_recv_coalesced(int sock, int writes)
+{
+	char rx_buf[sizeof(TEST_STR_SMALL) * CORK_WRITES];
+	ssize_t recved;
+
+	recved = zsock_recv(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(recved, strlen(TEST_STR_SMALL) * writes,
+		      "Unexpected received length (%zd)", recved);
+
+	for (int i = 0; i < writes; i++) {
+		zassert_mem_equal(rx_buf + i * strlen(TEST_STR_SMALL), TEST_STR_SMALL,
+				  strlen(TEST_STR_SMALL), "Invalid data received");
+	}
+}
+
+static void test_tcp_option(int sock, int level, int option, int value)
+{
+	int optval = value;
+	socklen_t optlen = sizeof(optval);
+	int ret;
+
+	ret = zsock_setsockopt(sock, level, option, &optval, sizeof(optval));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	optval = -1;
+	ret = zsock_getsockopt(sock, level, option, &optval, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, value, "getsockopt got invalid value");
+	zassert_equal(optlen, sizeof(optval), "getsockopt got invalid size");
+}
+
+static void test_cork_close(int c_sock, int s_sock, int new_sock)
+{
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
+ZTEST(net_socket_tcp, test_tcp_cork_option)
+{
+	struct sockaddr_in bind_addr4;
+	int sock, ret;
+	int optval;
+	socklen_t optlen = sizeof(optval);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	/* Cork should be disabled by default. */
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CORK, &optval, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, 0, "getsockopt got invalid value");
+	zassert_equal(optlen, sizeof(optval), "getsockopt got invalid size");
+
+	test_tcp_option(sock, IPPROTO_TCP, TCP_CORK, 1);
+	test_tcp_option(sock, IPPROTO_TCP, TCP_CORK, 0);
+
+	/* Only boolean values are accepted. */
+	optval = 2;
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CORK, &optval, sizeof(optval));
+	zassert_equal(ret, -1, "setsockopt should've failed");
+	zassert_equal(errno, EINVAL, "wrong errno value, %d", errno);
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CORK, &optval, sizeof(uint8_t));
+	zassert_equal(ret, -1, "setsockopt should've failed");
+	zassert_equal(errno, EINVAL, "wrong errno value, %d", errno);
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
+ZTEST(net_socket_tcp, test_v4_tcp_cork)
+{
+	int c_sock, s_sock, new_sock;
+	uint32_t segments;
+	char rx_buf[1];
+	ssize_t recved;
+
+	prepare_tcp_v4_pair(&c_sock, &s_sock, &new_sock);
+
+	test_tcp_option(c_sock, IPPROTO_TCP, TCP_NODELAY, 1);
+	test_tcp_option(c_sock, IPPROTO_TCP, TCP_CORK, 1);
+
+	segments = tcp_data_segments();
+
+	for (int i = 0; i < CORK_WRITES; i++) {
+		test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	}
+
+	/* Nothing is sent while corked, even with TCP_NODELAY set. */
+	k_msleep(THREAD_SLEEP);
+	zassert_equal(tcp_data_segments(), segments, "Data sent while corked");
+
+	recved = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(recved, -1, "Data received while corked");
+	zassert_equal(errno, EAGAIN, "wrong errno value, %d", errno);
+
+	/* Uncorking sends all the writes in a single segment. */
+	test_tcp_option(c_sock, IPPROTO_TCP, TCP_CORK, 0);
+	k_msleep(THREAD_SLEEP);
+
+	zassert_equal(tcp_data_segments() - segments, 1, "Writes not coalesced");
+	test_recv_coalesced(new_sock, CORK_WRITES);
+
+	test_cork_close(c_sock, s_sock, new_sock);
+}
+
+ZTEST(net_socket_tcp, test_v4_tcp_cork_timeout)
+{
+	int c_sock, s_sock, new_sock;
+	uint32_t segments;
+
+	prepare_tcp_v4_pair(&c_sock, &s_sock, &new_sock);
+
+	test_tcp_option(c_sock, IPPROTO_TCP, TCP_CORK, 1);
+
+	segments = tcp_data_segments();
+
+	for (int i = 0; i < CORK_WRITES; i++) {
+		test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	}
+
+	k_msleep(THREAD_SLEEP);
+	zassert_equal(tcp_data_segments(), segments, "Data sent while corked");
+
+	/* The held data is sent once the cork timeout expires, even if the
+	 * socket is still corked.
+	 */
+	k_msleep(CORK_TIMEOUT_MS);
+
+	zassert_equal(tcp_data_segments() - segments, 1, "Corked data not flushed");
+	test_recv_coalesced(new_sock, CORK_WRITES);
+
+	test_cork_close(c_sock, s_sock, new_sock);
+}
+
+ZTEST(net_socket_tcp, test_v4_msg_more)
+{
+	int c_sock, s_sock, new_sock;
+	uint32_t segments;
+
+	prepare_tcp_v4_pair(&c_sock, &s_sock, &new_sock);
+
+	test_tcp_option(c_sock, IPPROTO_TCP, TCP_NODELAY, 1);
+
+	segments = tcp_data_segments();
+
+	for (int i = 0; i < CORK_WRITES - 1; i++) {
+		test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), ZSOCK_MSG_MORE);
+	}
+
+	k_msleep(THREAD_SLEEP);
+	zassert_equal(tcp_data_segments(), segments, "Data sent with MSG_MORE");
+
+	/* The first write without MSG_MORE sends everything in one segment. */
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	k_msleep(THREAD_SLEEP);
+
+	zassert_equal(tcp_data_segments() - segments, 1, "Writes not coalesced");
+	test_recv_coalesced(new_sock, CORK_WRITES);
+
+	test_cork_close(c_sock, s_sock, new_sock);
+}
+
+ZTEST(net_socket_tcp, test_v4_tcp_autocork)
+{
+	int c_sock, s_sock, new_sock;
+	uint32_t segments;
+	uint32_t start_time;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_AUTOCORK);
+
+	prepare_tcp_v4_pair(&c_sock, &s_sock, &new_sock);
+
+	test_tcp_option(c_sock, IPPROTO_TCP, TCP_NODELAY, 1);
+
+	segments = tcp_data_segments();
+	start_time = k_uptime_get_32();
+
+	/* The first write goes out at once. The test thread does not yield
+	 * before the next writes, so they are queued while the first one is
+	 * still unacknowledged.
+	 */
+	for (int i = 0; i < CORK_WRITES; i++) {
+		test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	}
+
+	zassert_equal(tcp_data_segments() - segments, 1, "Writes not held back");
+
+	/* The ACK of the first segment flushes the others. With a long enough
+	 * autocork timeout this happens before the timer could fire.
+	 */
+	k_msleep(THREAD_SLEEP);
+	zassert_equal(tcp_data_segments() - segments, 2, "Held writes not coalesced");
+
+	if (AUTOCORK_TIMEOUT_MS > THREAD_SLEEP) {
+		zassert_true(k_uptime_get_32() - start_time < AUTOCORK_TIMEOUT_MS,
+			     "Held writes not flushed by the ACK");
+	}
+
+	test_recv_coalesced(new_sock, CORK_WRITES);
+
+	test_cork_close(c_sock, s_sock, new_sock);
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
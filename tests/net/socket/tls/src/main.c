@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define SERVER_PORT 4242
 
 #define PSK_TAG 1
+#define WRONG_PSK_TAG 2
 
 #define MAX_CONNS 5
 
@@ -55,6 +56,10 @@ static const unsigned char psk[] = {
 	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
 };
 static const char psk_id[] = "test_identity";
+static const unsigned char wrong_psk[] = {
+	0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+	0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x01
+};
 
 static void test_config_psk(int s_sock, int c_sock)
 {
@@ -1814,6 +1819,200 @@ ZTEST(net_socket_tls, test_poll_dtls_pollerr)
 	k_msleep(10);
 }
 
+struct session_connect_data {
+	struct k_work_delayable work;
+	int sock;
+	struct sockaddr *addr;
+	socklen_t addrlen;
+	int ret;
+};
+
+static void session_connect_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct session_connect_data *data =
+		CONTAINER_OF(dwork, struct session_connect_data, work);
+
+	data->ret = zsock_connect(data->sock, data->addr, data->addrlen);
+}
+
+/* Give the server a PSK that does not match the client one, so that only
+ * a resumed session, which does not use the PSK, can be established.
+ */
+static void test_config_wrong_psk(int sock)
+{
+	sec_tag_t sec_tag_list[] = {
+		WRONG_PSK_TAG
+	};
+
+	(void)tls_credential_delete(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK);
+	(void)tls_credential_delete(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK_ID);
+
+	zassert_equal(tls_credential_add(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK,
+					 wrong_psk, sizeof(wrong_psk)),
+		      0, "Failed to register PSK");
+	zassert_equal(tls_credential_add(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK_ID,
+					 psk_id, strlen(psk_id)),
+		      0, "Failed to register PSK ID");
+
+	zassert_equal(zsock_setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST,
+				       sec_tag_list, sizeof(sec_tag_list)),
+		      0, "Failed to set PSK on server socket");
+}
+
+static void test_session_cache_enable(int sock)
+{
+	int optval = TLS_SESSION_CACHE_ENABLED;
+
+	zassert_equal(zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE,
+				       &optval, sizeof(optval)),
+		      0, "Failed to enable session cache");
+}
+
+static void test_session_cache_purge(void)
+{
+	struct sockaddr_in saddr;
+	int sock, optval = 0;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &saddr, IPPROTO_TLS_1_2);
+
+	zassert_equal(zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE_PURGE,
+				       &optval, sizeof(optval)),
+		      0, "Failed to purge session cache");
+
+	test_close(sock);
+}
+
+/* Connect a client with session caching enabled to a new server, and
+ * tell whether the TLS connection could be established.
+ */
+static bool test_session_connect(sa_family_t family, bool server_psk_valid,
+				 const char *hostname)
+{
+	struct session_connect_data test_data = { .ret = -1 };
+	struct sockaddr c_saddr;
+	struct sockaddr s_saddr;
+	socklen_t addrlen = family == AF_INET6 ?
+			    sizeof(struct sockaddr_in6) :
+			    sizeof(struct sockaddr_in);
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	bool connected;
+
+	if (family == AF_INET6) {
+		prepare_sock_tls_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock,
+				    (struct sockaddr_in6 *)&c_saddr,
+				    IPPROTO_TLS_1_2);
+		prepare_sock_tls_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock,
+				    (struct sockaddr_in6 *)&s_saddr,
+				    IPPROTO_TLS_1_2);
+	} else {
+		prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock,
+				    (struct sockaddr_in *)&c_saddr,
+				    IPPROTO_TLS_1_2);
+		prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock,
+				    (struct sockaddr_in *)&s_saddr,
+				    IPPROTO_TLS_1_2);
+	}
+
+	if (server_psk_valid) {
+		test_config_psk(s_sock, c_sock);
+	} else {
+		test_config_psk(-1, c_sock);
+		test_config_wrong_psk(s_sock);
+	}
+
+	test_session_cache_enable(s_sock);
+	test_session_cache_enable(c_sock);
+
+	if (hostname != NULL) {
+		zassert_equal(zsock_setsockopt(c_sock, SOL_TLS, TLS_HOSTNAME,
+					       hostname, strlen(hostname) + 1),
+			      0, "Failed to set hostname");
+	}
+
+	test_bind(s_sock, &s_saddr, addrlen);
+	test_listen(s_sock);
+
+	test_data.sock = c_sock;
+	test_data.addr = &s_saddr;
+	test_data.addrlen = addrlen;
+	k_work_init_delayable(&test_data.work, session_connect_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	new_sock = zsock_accept(s_sock, NULL, NULL);
+
+	test_work_wait(&test_data.work);
+
+	connected = new_sock >= 0 && test_data.ret == 0;
+	if (connected) {
+		test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+		zassert_equal(zsock_recv(new_sock, rx_buf, sizeof(rx_buf), 0),
+			      sizeof(rx_buf), "Failed to receive data");
+		zassert_mem_equal(rx_buf, TEST_STR_SMALL, sizeof(rx_buf), "Invalid data");
+	}
+
+	test_sockets_close();
+
+	/* Small delay for the final alert exchange */
+	k_msleep(10);
+
+	return connected;
+}
+
+ZTEST(net_socket_tls, test_session_resume_hostname)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (!IS_ENABLED(CONFIG_MBEDTLS_SSL_CACHE_C) &&
+	    !IS_ENABLED(CONFIG_MBEDTLS_SSL_TICKET_C)) {
+		ztest_test_skip();
+	}
+
+	test_session_cache_purge();
+
+	zassert_true(test_session_connect(AF_INET, true, "server.test"),
+		     "Full handshake failed");
+
+	/* Without a cached session the wrong server PSK fails the handshake */
+	zassert_false(test_session_connect(AF_INET6, false, "other.test"),
+		      "Handshake with a wrong PSK succeeded");
+
+	/* The session of the hostname is resumed with another server address */
+	zassert_true(test_session_connect(AF_INET6, false, "server.test"),
+		     "Session not resumed with another address");
+
+	test_session_cache_purge();
+#else
+	/* TLS_HOSTNAME needs X.509 support */
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(net_socket_tls, test_session_resume_ticket)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_MBEDTLS_SSL_TICKET_C);
+
+	test_session_cache_purge();
+
+	zassert_true(test_session_connect(AF_INET, true, NULL),
+		     "Full handshake failed");
+	zassert_true(test_session_connect(AF_INET, false, NULL),
+		     "Session not resumed from the ticket");
+
+	/* Purging rotates the ticket key of the servers. It is used by the
+	 * next servers for new tickets and their resumption.
+	 */
+	test_session_cache_purge();
+
+	zassert_false(test_session_connect(AF_INET, false, NULL),
+		      "Session resumed after purge");
+	zassert_true(test_session_connect(AF_INET, true, NULL),
+		     "Full handshake after purge failed");
+	zassert_true(test_session_connect(AF_INET, false, NULL),
+		     "Session not resumed from a ticket of the new key");
+
+	test_session_cache_purge();
+}
+
 static void *tls_tests_setup(void)
 {
 	k_work_queue_init(&tls_test_work_queue);
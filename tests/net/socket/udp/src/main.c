@@ -1018,6 +1018,64 @@ static void iface_cb(struct net_if *iface, void *user_data)
 	}
 }
 
+ZTEST(net_socket_udp, test_16_v4_recv_zerocopy)
+{
+	/* Test that zsock_recv_zc() returns one datagram per call */
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct net_buf *held;
+	struct net_buf *frags;
+	uint8_t rx_buf[sizeof(TEST_STR2)];
+	ssize_t sent;
+	ssize_t recved;
+	int rv;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_SOCKETS_RECV_ZEROCOPY);
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	sent = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+			    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(sent, STRLEN(TEST_STR2), "sendto failed");
+	sent = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	recved = zsock_recv_zc(server_sock, &frags, 0);
+	zassert_equal(recved, STRLEN(TEST_STR2), "unexpected received bytes");
+	zassert_not_null(frags, "No buffers returned");
+	zassert_equal(net_buf_frags_len(frags), recved, "Invalid length");
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, recved);
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+	held = frags;
+
+	/* The next datagram can be taken while the first one is held */
+	recved = zsock_recv_zc(server_sock, &frags, 0);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "unexpected received bytes");
+	zassert_not_null(frags, "No buffers returned");
+	zassert_equal(net_buf_frags_len(frags), recved, "Invalid length");
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, recved);
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR_SMALL), "wrong data");
+	zsock_recv_zc_release(frags);
+	zsock_recv_zc_release(held);
+
+	recved = zsock_recv_zc(server_sock, &frags, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(recved, -1, "Unexpected data");
+	zassert_equal(errno, EAGAIN, "Unexpected errno %d", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 ZTEST(net_socket_udp, test_17_setup_eth_for_ipv6)
 {
 	struct net_if_addr *ifaddr;
@@ -133,6 +133,10 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_GSO_SEGMENTATION = 19,
+	TEST_GRO_COALESCING = 20,
+	TEST_GSO_SEND = 21,
+	TEST_GSO_PARTIAL = 22,
 } test_case_no;
 
 static enum test_state t_state;
@@ -157,6 +161,8 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_gso_segment(struct net_pkt *pkt, struct tcphdr *th);
+static void handle_gso_partial_segment(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -509,6 +515,17 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_GSO_SEGMENTATION:
+	case TEST_GSO_SEND:
+		handle_gso_segment(pkt, &th);
+		break;
+	case TEST_GSO_PARTIAL:
+		handle_gso_partial_segment(pkt, &th);
+		break;
+	case TEST_GRO_COALESCING:
+		/* Only ACKs are expected, nothing to verify */
+		test_verify_flags(&th, ACK);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -2621,4 +2638,454 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+#define GSO_SEGMENT_SIZE 80
+#define GSO_INITIAL_SEQ 1000
+
+static size_t gso_received;
+static int gso_segments;
+static uint32_t gso_seq;
+static size_t gso_mss;
+
+static void handle_gso_segment(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		     sizeof(struct tcphdr);
+	bool last = gso_received + len == sizeof(lorem_ipsum) - 1;
+	static uint8_t buf[NET_IPV6_MTU];
+
+	/* Only the last segment is shorter than the MSS */
+	if (last) {
+		zassert_true(len <= gso_mss, "Too long segment %zu", len);
+	} else {
+		zassert_equal(len, gso_mss, "Invalid segment length %zu", len);
+	}
+
+	zassert_equal(ntohl(th->th_seq), gso_seq + gso_received,
+		      "Invalid segment seq");
+	zassert_equal(net_pkt_gso_size(pkt), 0U, "Segment is not segmented");
+	test_verify_flags(th, last ? (PSH | ACK) : ACK);
+
+	net_pkt_set_overwrite(pkt, true);
+	zassert_ok(net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + sizeof(struct tcphdr)));
+	zassert_ok(net_pkt_read(pkt, buf, len));
+	zassert_mem_equal(buf, lorem_ipsum + gso_received, len,
+			  "Invalid segment data");
+
+	gso_received += len;
+	gso_segments++;
+
+	if (last) {
+		test_sem_give();
+	}
+}
+
+/* Test case scenario IPv4
+ *   send a TCP packet carrying more data than the MSS,
+ *   expect the data split into MSS sized segments with consecutive
+ *   sequence numbers and PSH only set on the last one.
+ */
+ZTEST(net_tcp, test_gso_segmentation)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t len = sizeof(lorem_ipsum) - 1;
+	struct net_pkt *pkt;
+	struct tcphdr *th;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GSO);
+
+	test_case_no = TEST_GSO_SEGMENTATION;
+	gso_received = 0;
+	gso_segments = 0;
+	gso_seq = GSO_INITIAL_SEQ;
+	gso_mss = GSO_SEGMENT_SIZE;
+
+	/* The packet is larger than the MTU, so allocate the data part
+	 * separately.
+	 */
+	pkt = net_pkt_alloc_with_buffer(net_iface, sizeof(struct tcphdr),
+					AF_INET, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_alloc_buffer_raw(pkt, len, K_NO_WAIT));
+
+	zassert_ok(net_ipv4_create(pkt, &my_addr, &peer_addr));
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(th, "Cannot get TCP header");
+
+	memset(th, 0U, sizeof(struct tcphdr));
+	th->th_sport = htons(MY_PORT);
+	th->th_dport = htons(PEER_PORT);
+	th->th_off = 5U;
+	th->th_flags = PSH | ACK;
+	th->th_seq = htonl(GSO_INITIAL_SEQ);
+
+	zassert_ok(net_pkt_set_data(pkt, &tcp_access));
+	zassert_ok(net_pkt_write(pkt, lorem_ipsum, len));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_TCP));
+
+	net_pkt_set_gso_size(pkt, GSO_SEGMENT_SIZE);
+
+	zassert_ok(net_send_data(pkt), "Cannot send data");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(gso_segments, DIV_ROUND_UP(len, GSO_SEGMENT_SIZE),
+		      "Invalid number of segments");
+}
+
+#define GSO_PARTIAL_SEGMENTS 2
+
+static struct net_pkt *gso_held[GSO_PARTIAL_SEGMENTS];
+
+/* Keep the segments so that their packets are not freed */
+static void handle_gso_partial_segment(struct net_pkt *pkt, struct tcphdr *th)
+{
+	zassert_true(gso_segments < GSO_PARTIAL_SEGMENTS, "Too many segments");
+
+	gso_held[gso_segments] = net_pkt_ref(pkt);
+	handle_gso_segment(pkt, th);
+}
+
+/* Test case scenario IPv4
+ *   send a TCP packet carrying more data than the MSS while only a few
+ *   packets can be allocated for the segments, expect the segments that
+ *   could be allocated to be sent and the packet to be consumed, the rest
+ *   of the data being left to the TCP retransmission logic.
+ */
+ZTEST(net_tcp, test_gso_partial)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct net_pkt *spare[CONFIG_NET_PKT_TX_COUNT];
+	size_t len = sizeof(lorem_ipsum) - 1;
+	struct net_pkt *pkt;
+	struct tcphdr *th;
+	int count = 0;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GSO);
+
+	test_case_no = TEST_GSO_PARTIAL;
+	gso_received = 0;
+	gso_segments = 0;
+	gso_seq = GSO_INITIAL_SEQ;
+	gso_mss = GSO_SEGMENT_SIZE;
+
+	zassert_true(len > (GSO_PARTIAL_SEGMENTS + 1) * GSO_SEGMENT_SIZE,
+		     "Not enough data for the test");
+
+	pkt = net_pkt_alloc_with_buffer(net_iface, sizeof(struct tcphdr),
+					AF_INET, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_alloc_buffer_raw(pkt, len, K_NO_WAIT));
+
+	zassert_ok(net_ipv4_create(pkt, &my_addr, &peer_addr));
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(th, "Cannot get TCP header");
+
+	memset(th, 0U, sizeof(struct tcphdr));
+	th->th_sport = htons(MY_PORT);
+	th->th_dport = htons(PEER_PORT);
+	th->th_off = 5U;
+	th->th_flags = PSH | ACK;
+	th->th_seq = htonl(GSO_INITIAL_SEQ);
+
+	zassert_ok(net_pkt_set_data(pkt, &tcp_access));
+	zassert_ok(net_pkt_write(pkt, lorem_ipsum, len));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_TCP));
+
+	net_pkt_set_gso_size(pkt, GSO_SEGMENT_SIZE);
+
+	/* Leave room for the first segments only */
+	while (count < ARRAY_SIZE(spare)) {
+		spare[count] = net_pkt_alloc(K_NO_WAIT);
+		if (spare[count] == NULL) {
+			break;
+		}
+
+		count++;
+	}
+
+	zassert_true(count >= GSO_PARTIAL_SEGMENTS, "Not enough packets");
+
+	for (int i = 0; i < GSO_PARTIAL_SEGMENTS; i++) {
+		net_pkt_unref(spare[--count]);
+	}
+
+	zassert_ok(net_send_data(pkt), "Sent segments reported as dropped");
+
+	while (count > 0) {
+		net_pkt_unref(spare[--count]);
+	}
+
+	zassert_equal(gso_segments, GSO_PARTIAL_SEGMENTS,
+		      "Invalid number of segments");
+	zassert_equal(gso_received, GSO_PARTIAL_SEGMENTS * GSO_SEGMENT_SIZE,
+		      "Invalid amount of data sent");
+
+	for (int i = 0; i < GSO_PARTIAL_SEGMENTS; i++) {
+		net_pkt_unref(gso_held[i]);
+	}
+}
+
+/* Test case scenario IPv6
+ *   send more than one MSS of data on an established connection,
+ *   expect TCP to pass it down as one packet that is split into MSS
+ *   sized segments before the driver.
+ */
+ZTEST(net_tcp, test_gso_send)
+{
+	size_t len = sizeof(lorem_ipsum) - 1;
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	struct tcp *conn;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GSO);
+
+	ctx = create_server_socket(0, 0);
+	conn = accepted_ctx->tcp;
+
+	/* Let the whole data fit in the send and congestion windows */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->send_win = len;
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	conn->ca.cwnd = len;
+#endif
+	/* The peer did not send the MSS option */
+	gso_mss = MIN(NET_TCP_DEFAULT_MSS,
+		      net_if_get_mtu(net_iface) - NET_IPV6TCPH_LEN);
+	gso_seq = conn->seq;
+	k_mutex_unlock(&conn->lock);
+
+	zassert_true(len > 2 * gso_mss, "Not enough data for the test");
+
+	gso_received = 0;
+	gso_segments = 0;
+	test_case_no = TEST_GSO_SEND;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, len, NULL, K_NO_WAIT,
+			       NULL);
+	zassert_equal(ret, len, "Failed to send data (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(gso_received, len, "Not all data sent");
+	zassert_equal(gso_segments, DIV_ROUND_UP(len, gso_mss),
+		      "Invalid number of segments");
+
+	/* The data went out in a single packet */
+	zassert_equal(conn->unacked_len, len, "Data not sent at once");
+
+	/* Abort the connection, no need for a full closing handshake */
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(net_iface, rst);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define GRO_SEGMENTS 4
+#define GRO_SEGMENT_LEN 20
+
+static int gro_recv_calls;
+static size_t gro_recv_len;
+
+static void test_gro_recv_cb(struct net_context *context,
+			     struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr,
+			     union net_proto_header *proto_hdr,
+			     int status,
+			     void *user_data)
+{
+	if (pkt == NULL) {
+		return;
+	}
+
+	gro_recv_calls++;
+	gro_recv_len += net_pkt_remaining_data(pkt);
+	net_pkt_unref(pkt);
+
+	if (gro_recv_len == GRO_SEGMENTS * GRO_SEGMENT_LEN) {
+		test_sem_give();
+	}
+}
+
+/* Queue several in-order segments before the RX thread gets to run and
+ * verify that they are delivered to the application as a single packet.
+ */
+ZTEST(net_tcp, test_gro_coalescing)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt, *rst;
+	int ret, i;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	k_sem_reset(&test_sem);
+	gro_recv_calls = 0;
+	gro_recv_len = 0;
+
+	ctx = create_server_socket(0, 0);
+
+	zassert_ok(net_context_recv(accepted_ctx, test_gro_recv_cb, K_NO_WAIT,
+				    NULL));
+
+	test_case_no = TEST_GRO_COALESCING;
+
+	k_sched_lock();
+
+	for (i = 0; i < GRO_SEGMENTS; i++) {
+		pkt = tester_prepare_tcp_pkt(AF_INET6, htons(MY_PORT),
+					     htons(PEER_PORT),
+					     i == GRO_SEGMENTS - 1 ? PSH | ACK : ACK,
+					     &lorem_ipsum[i * GRO_SEGMENT_LEN],
+					     GRO_SEGMENT_LEN);
+		zassert_not_null(pkt, "Cannot create pkt");
+
+		ret = net_recv_data(net_iface, pkt);
+		zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+		seq += GRO_SEGMENT_LEN;
+	}
+
+	k_sched_unlock();
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(gro_recv_calls, 1, "Segments not coalesced (%d)",
+		      gro_recv_calls);
+
+	/* Abort the connection, no need for a full closing handshake */
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(net_iface, rst);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define GRO_ORDER_BATCHES 4
+#define GRO_ORDER_LEN (GRO_ORDER_BATCHES * GRO_SEGMENTS * GRO_SEGMENT_LEN)
+
+static size_t gro_order_len;
+static k_tid_t gro_order_thread;
+static bool gro_order_ok;
+
+static void test_gro_order_recv_cb(struct net_context *context,
+				   struct net_pkt *pkt,
+				   union net_ip_header *ip_hdr,
+				   union net_proto_header *proto_hdr,
+				   int status,
+				   void *user_data)
+{
+	static uint8_t buf[GRO_ORDER_LEN];
+	size_t len;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	/* All the segments of the flow are processed by the same RX queue */
+	if (gro_order_thread == NULL) {
+		gro_order_thread = k_current_get();
+	} else if (gro_order_thread != k_current_get()) {
+		gro_order_ok = false;
+	}
+
+	len = net_pkt_remaining_data(pkt);
+	if (gro_order_len + len > GRO_ORDER_LEN ||
+	    net_pkt_read(pkt, buf, len) < 0 ||
+	    memcmp(buf, &lorem_ipsum[gro_order_len], len) != 0) {
+		gro_order_ok = false;
+	}
+
+	gro_order_len += len;
+	net_pkt_unref(pkt);
+
+	if (gro_order_len >= GRO_ORDER_LEN) {
+		test_sem_give();
+	}
+}
+
+/* Feed the segments of a connection in batches, so that the RX queue
+ * alternates between merging and flushing, and verify that the data of
+ * the flow is handled by a single RX thread and received in order.
+ */
+ZTEST(net_tcp, test_gro_flow_order)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt, *rst;
+	size_t offset = 0;
+	int ret, i, j;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	k_sem_reset(&test_sem);
+	gro_order_len = 0;
+	gro_order_thread = NULL;
+	gro_order_ok = true;
+
+	ctx = create_server_socket(0, 0);
+
+	zassert_ok(net_context_recv(accepted_ctx, test_gro_order_recv_cb,
+				    K_NO_WAIT, NULL));
+
+	test_case_no = TEST_GRO_COALESCING;
+
+	for (i = 0; i < GRO_ORDER_BATCHES; i++) {
+		k_sched_lock();
+
+		for (j = 0; j < GRO_SEGMENTS; j++) {
+			pkt = tester_prepare_tcp_pkt(AF_INET6, htons(MY_PORT),
+						     htons(PEER_PORT),
+						     j == GRO_SEGMENTS - 1 ? PSH | ACK : ACK,
+						     &lorem_ipsum[offset],
+						     GRO_SEGMENT_LEN);
+			zassert_not_null(pkt, "Cannot create pkt");
+
+			ret = net_recv_data(net_iface, pkt);
+			zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+			seq += GRO_SEGMENT_LEN;
+			offset += GRO_SEGMENT_LEN;
+		}
+
+		k_sched_unlock();
+
+		/* Let the RX queue drain only every other batch */
+		if (i % 2) {
+			k_msleep(10);
+		}
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(gro_order_len, GRO_ORDER_LEN, "Data missing (%zu)",
+		      gro_order_len);
+	zassert_true(gro_order_ok, "Data reordered or processed by several "
+		     "RX threads");
+
+	/* Abort the connection, no need for a full closing handshake */
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(net_iface, rst);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -923,4 +923,39 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+ZTEST(test_utils_fn, test_ip_checksum_wide)
+{
+	static uint8_t copy[CHECKSUM_TEST_LENGTH];
+	uint16_t sum_got;
+	uint16_t sum_exp;
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i * 7 + 0xa5);
+	}
+
+	/* Lengths and offsets around the vector sizes of the bulk kernels */
+	for (int offset = 0; offset < 16; offset++) {
+		for (int length = 64; length < 200; length++) {
+			sum_got = calc_chksum_ref(offset ^ 0x7ab3, testdata + offset, length);
+			sum_exp = calc_chksum(offset ^ 0x7ab3, testdata + offset, length);
+
+			zassert_equal(sum_got, sum_exp,
+				      "Mismatch between reference and calculated checksum\n");
+		}
+	}
+
+	/* Checksum while copying must match a plain checksum of the result */
+	for (int offset = 0; offset < 4; offset++) {
+		int length = CHECKSUM_TEST_LENGTH - 4 - offset;
+
+		memset(copy, 0, sizeof(copy));
+
+		sum_got = calc_chksum_copy(0x1234, copy + offset, testdata + 3, length);
+		sum_exp = calc_chksum_ref(0x1234, testdata + 3, length);
+
+		zassert_equal(sum_got, sum_exp, "Mismatch in checksum while copying\n");
+		zassert_mem_equal(copy + offset, testdata + 3, length, "Copy failed");
+	}
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
@@ -151,4 +151,102 @@ ZTEST(test_log_cache, test_log_cache_basic)
 	log_cache_put(&cache, buf);
 }
 
+static uint32_t hash(uintptr_t id)
+{
+	union test_ids t = { .raw = id };
+
+	return t.id.x;
+}
+
+ZTEST(test_log_cache, test_log_cache_hashed)
+{
+	/* Space for 8 entries, spread over 4 buckets */
+	static uint8_t data[8 * ENTRY_SIZE(TEST_ENTRY_LEN)];
+	static sys_slist_t buckets[4];
+	static const struct log_cache_config config = {
+		.buf = data,
+		.buf_len = sizeof(data),
+		.item_size = TEST_ENTRY_LEN,
+		.cmp = cmp,
+		.hash = hash,
+		.buckets = buckets,
+		.bucket_cnt = ARRAY_SIZE(buckets)
+	};
+	static const struct log_cache_config bad_config = {
+		.buf = data,
+		.buf_len = sizeof(data),
+		.item_size = TEST_ENTRY_LEN,
+		.cmp = cmp,
+		.hash = hash,
+		.buckets = buckets,
+		.bucket_cnt = 3
+	};
+	union test_ids id = {
+		.id = { .y = 1245 }
+	};
+	struct log_cache cache;
+	uint8_t *buf;
+	int err;
+
+	err = log_cache_init(&cache, &bad_config);
+	zassert_equal(err, -EINVAL, "Bucket count must be a power of 2");
+
+	err = log_cache_init(&cache, &config);
+	zassert_equal(err, 0, NULL);
+
+	/* Fill the cache */
+	for (uint8_t x = 0; x < 8; x++) {
+		id.id.x = x;
+		cache_get(&cache, id.raw, &buf, false, __LINE__);
+		buf_fill(buf, x);
+		log_cache_put(&cache, buf);
+	}
+
+	/* All entries are found, use the even ones last. */
+	for (uint8_t x = 1; x < 8; x += 2) {
+		id.id.x = x;
+		cache_get(&cache, id.raw, &buf, true, __LINE__);
+		zassert_true(buf_check(buf, x), "Buffer check failed");
+	}
+
+	for (uint8_t x = 0; x < 8; x += 2) {
+		id.id.x = x;
+		cache_get(&cache, id.raw, &buf, true, __LINE__);
+		zassert_true(buf_check(buf, x), "Buffer check failed");
+	}
+
+	/* New entries evict the odd ones, least recently used first. */
+	for (uint8_t x = 8; x < 12; x++) {
+		id.id.x = x;
+		cache_get(&cache, id.raw, &buf, false, __LINE__);
+		zassert_true(buf_check(buf, 1 + 2 * (x - 8)), "Buffer check failed");
+		buf_fill(buf, x);
+		log_cache_put(&cache, buf);
+	}
+
+	for (uint8_t x = 0; x < 12; x++) {
+		if ((x % 2 == 1) && (x < 8)) {
+			continue;
+		}
+
+		id.id.x = x;
+		cache_get(&cache, id.raw, &buf, true, __LINE__);
+		zassert_true(buf_check(buf, x), "Buffer check failed");
+	}
+
+	/* The first miss evicts id 0, released entries are reused by later misses. */
+	id.id.x = 1;
+	cache_get(&cache, id.raw, &buf, false, __LINE__);
+	log_cache_release(&cache, buf);
+
+	id.id.x = 3;
+	cache_get(&cache, id.raw, &buf, false, __LINE__);
+	log_cache_release(&cache, buf);
+
+	for (uint8_t x = 8; x < 12; x++) {
+		id.id.x = x;
+		cache_get(&cache, id.raw, &buf, true, __LINE__);
+	}
+}
+
 ZTEST_SUITE(test_log_cache, NULL, NULL, NULL, NULL, NULL);
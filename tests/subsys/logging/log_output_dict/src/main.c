@@ -0,0 +1,159 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test dictionary based log output and its framing
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/sys/crc.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define TEST_STR "test %d"
+#define TEST_TIMESTAMP 0x1234
+
+static uint8_t mock_buffer[512];
+static uint32_t mock_len;
+static uint32_t mock_calls;
+
+/* Smaller than a message, to check that messages are split correctly */
+static uint8_t log_output_buf[16];
+
+static uint8_t __aligned(Z_LOG_MSG_ALIGNMENT) msg_buf[256];
+static const uint8_t hexdump[] = { 1, 2, 3, 4, 5 };
+
+static int mock_output_func(uint8_t *buf, size_t size, void *ctx)
+{
+	zassert_true(mock_len + size <= sizeof(mock_buffer));
+
+	memcpy(&mock_buffer[mock_len], buf, size);
+	mock_len += size;
+	mock_calls++;
+
+	return size;
+}
+
+LOG_OUTPUT_DEFINE(log_output, mock_output_func, log_output_buf, sizeof(log_output_buf));
+
+static struct log_msg *create_msg(void)
+{
+	struct log_msg *msg = (struct log_msg *)msg_buf;
+	int len;
+
+	memset(msg_buf, 0, sizeof(msg_buf));
+
+	len = cbprintf_package(msg->data, sizeof(msg_buf) - sizeof(*msg) - sizeof(hexdump), 0,
+			       TEST_STR, 100);
+	zassert_true(len > 0);
+
+	msg->hdr.desc.level = LOG_LEVEL_INF;
+	msg->hdr.desc.package_len = len;
+	msg->hdr.desc.data_len = sizeof(hexdump);
+	msg->hdr.timestamp = TEST_TIMESTAMP;
+	memcpy(&msg->data[len], hexdump, sizeof(hexdump));
+
+	return msg;
+}
+
+/* Check a frame or unframed message at offset and return the next offset */
+static size_t check_msg(size_t offset, uint16_t exp_seq, const void *exp, size_t exp_len)
+{
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		struct log_dict_output_frame_hdr_t hdr;
+		uint16_t crc;
+
+		zassert_true(offset + sizeof(hdr) + exp_len + sizeof(crc) <= mock_len);
+
+		memcpy(&hdr, &mock_buffer[offset], sizeof(hdr));
+		zassert_equal(hdr.sync[0], LOG_DICT_FRAME_SYNC0);
+		zassert_equal(hdr.sync[1], LOG_DICT_FRAME_SYNC1);
+		zassert_equal(hdr.seq, exp_seq);
+		zassert_equal(hdr.len, exp_len);
+
+		memcpy(&crc, &mock_buffer[offset + sizeof(hdr) + exp_len], sizeof(crc));
+		zassert_equal(crc, crc16_ccitt(0xFFFF, &mock_buffer[offset + sizeof(hdr.sync)],
+					       sizeof(hdr) - sizeof(hdr.sync) + exp_len));
+
+		offset += sizeof(hdr);
+	}
+
+	zassert_true(offset + exp_len <= mock_len);
+	zassert_mem_equal(&mock_buffer[offset], exp, exp_len);
+
+	offset += exp_len;
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		offset += sizeof(uint16_t);
+	}
+
+	return offset;
+}
+
+ZTEST(test_log_output_dict, test_msg)
+{
+	struct log_msg *msg = create_msg();
+	struct log_dict_output_normal_msg_hdr_t hdr = {
+		.type = MSG_NORMAL,
+		.level = LOG_LEVEL_INF,
+		.package_len = msg->hdr.desc.package_len,
+		.data_len = sizeof(hexdump),
+		.timestamp = TEST_TIMESTAMP,
+	};
+	uint8_t exp[sizeof(hdr) + sizeof(msg_buf)];
+	size_t exp_len = 0;
+
+	memcpy(&exp[exp_len], &hdr, sizeof(hdr));
+	exp_len += sizeof(hdr);
+	memcpy(&exp[exp_len], msg->data, hdr.package_len + hdr.data_len);
+	exp_len += hdr.package_len + hdr.data_len;
+
+	log_dict_output_msg_process(&log_output, msg, 0);
+	zassert_equal(check_msg(0, 0, exp, exp_len), mock_len);
+
+	/* Output is buffered, not written field by field */
+	if (!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		zassert_equal(mock_calls, DIV_ROUND_UP(mock_len, sizeof(log_output_buf)));
+	}
+}
+
+ZTEST(test_log_output_dict, test_seq)
+{
+	struct log_dict_output_dropped_msg_t dropped = {
+		.type = MSG_DROPPED_MSG,
+		.num_dropped_messages = 3,
+	};
+	size_t offset = 0;
+
+	for (int i = 0; i < 3; i++) {
+		log_dict_output_dropped_process(&log_output, dropped.num_dropped_messages);
+	}
+
+	for (int i = 0; i < 3; i++) {
+		offset = check_msg(offset, i, &dropped, sizeof(dropped));
+	}
+
+	zassert_equal(offset, mock_len);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	mock_len = 0U;
+	mock_calls = 0U;
+	memset(mock_buffer, 0, sizeof(mock_buffer));
+
+#ifdef CONFIG_LOG_DICTIONARY_FRAMING
+	log_output.control_block->frame_seq = 0;
+#endif
+}
+
+ZTEST_SUITE(test_log_output_dict, NULL, NULL, before, NULL, NULL);